@@ -0,0 +1,262 @@
+#include "Host.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <malloc.h>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial(stdout);
+HardwareSerial Serial1(nullptr);
+
+static uint64_t simMicros = 0;
+
+// ============================================================================
+// CLOCK
+// ============================================================================
+void Host::advance(uint32_t ms)
+{
+    simMicros += (uint64_t)ms * 1000;
+}
+
+uint32_t Host::now()
+{
+    return simMicros / 1000;
+}
+
+extern "C" unsigned long millis()
+{
+    return simMicros / 1000;
+}
+
+extern "C" unsigned long micros()
+{
+    return simMicros;
+}
+
+extern "C" void delay(uint32_t /*ms*/)
+{
+    // Firmware delays happen on the sensor task, not the display timeline
+}
+
+int64_t esp_timer_get_time(void)
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// TASKS
+// ============================================================================
+namespace
+{
+    struct HostTask
+    {
+        std::mutex lock;
+        std::condition_variable woken;
+        uint32_t notified = 0;
+    };
+
+    constexpr uint32_t STALL_ONE_IN = 4;  // Scheduling points that stall
+    constexpr uint32_t MAX_STALL_US = 400; // Several slices of a shared blend
+
+    thread_local HostTask *currentTask = nullptr;
+
+    // Main thread: never. Created tasks: now and then, for a random while
+    void stall()
+    {
+        thread_local std::minstd_rand random(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        if (currentTask != nullptr && random() % STALL_ONE_IN == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(random() % MAX_STALL_US));
+        }
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *, uint32_t, void *parameter, UBaseType_t,
+                                   TaskHandle_t *handle, BaseType_t)
+{
+    HostTask *hostTask = new HostTask();
+    std::thread([=]() {
+        currentTask = hostTask;
+        task(parameter);
+    }).detach();
+    if (handle != nullptr)
+    {
+        *handle = hostTask;
+    }
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t)
+{
+    if (currentTask == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t value;
+    {
+        std::unique_lock<std::mutex> hold(currentTask->lock);
+        currentTask->woken.wait(hold, [] { return currentTask->notified > 0; });
+        value = currentTask->notified;
+        currentTask->notified = clear ? 0 : value - 1;
+    }
+    // A late wakeup
+    stall();
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    HostTask *hostTask = (HostTask *)task;
+    if (hostTask != nullptr)
+    {
+        std::lock_guard<std::mutex> hold(hostTask->lock);
+        hostTask->notified++;
+        hostTask->woken.notify_one();
+    }
+    return pdTRUE;
+}
+
+void taskYIELD()
+{
+    stall();
+    std::this_thread::yield();
+}
+
+void vTaskSuspendAll()
+{
+    // Preempted just before, the worst moment for whoever waits on the task
+    stall();
+}
+
+BaseType_t xTaskResumeAll()
+{
+    return pdFALSE;
+}
+
+// ============================================================================
+// SERIAL
+// ============================================================================
+void HardwareSerial::flush()
+{
+    if (out != nullptr)
+    {
+        fflush(out);
+    }
+}
+
+void HardwareSerial::feed(const char *data)
+{
+    // Drop what has already been read before queueing more
+    rx.erase(0, rxPos);
+    rxPos = 0;
+    rx += data;
+}
+
+int HardwareSerial::available()
+{
+    return rx.size() - rxPos;
+}
+
+int HardwareSerial::read()
+{
+    return rxPos < rx.size() ? (uint8_t)rx[rxPos++] : -1;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (out != nullptr)
+    {
+        fputc(c, out);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::print(const char *str)
+{
+    if (out != nullptr)
+    {
+        fputs(str, out);
+    }
+    return strlen(str);
+}
+
+size_t HardwareSerial::print(char c)
+{
+    return write(c);
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return printf("%d", value);
+}
+
+size_t HardwareSerial::println(const char *str)
+{
+    size_t n = print(str);
+    return n + write('\n');
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...)
+{
+    if (out == nullptr)
+    {
+        return 0;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vfprintf(out, fmt, args);
+    va_end(args);
+    return n > 0 ? n : 0;
+}
+
+// ============================================================================
+// HEAP
+// ============================================================================
+static constexpr size_t INTERNAL_SRAM_BYTES = 320 * 1024;
+
+void *heap_caps_malloc(size_t size, uint32_t /*caps*/)
+{
+    return malloc(size);
+}
+
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t /*caps*/)
+{
+    return realloc(ptr, size);
+}
+
+void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
+
+size_t heap_caps_get_allocated_size(void *ptr)
+{
+    return malloc_usable_size(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t /*caps*/)
+{
+    return INTERNAL_SRAM_BYTES;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t /*caps*/)
+{
+    return INTERNAL_SRAM_BYTES;
+}
+
+bool esp_ptr_external_ram(const void * /*ptr*/)
+{
+    return false;
+}
+
+bool esp_ptr_internal(const void * /*ptr*/)
+{
+    return true;
+}
@@ -0,0 +1,136 @@
+#include "FramebufferDisplay.h"
+#include "PngWriter.h"
+#include "panel_lut.h"
+
+static uint32_t fnv1a(uint32_t hash, const void *data, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++)
+    {
+        hash = (hash ^ ((const uint8_t *)data)[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void FramebufferDisplay::begin()
+{
+    lv_init();
+
+    // Full screen draw buffer, as beginLvglHelper() allocates on the board
+    buffer.resize(WIDTH * HEIGHT);
+    framebuffer.assign(WIDTH * HEIGHT, lv_color_black());
+    lv_disp_draw_buf_init(&drawBuf, buffer.data(), nullptr, WIDTH * HEIGHT);
+
+    lv_disp_drv_init(&drv);
+    drv.hor_res = WIDTH;
+    drv.ver_res = HEIGHT;
+    drv.flush_cb = flushCallback;
+    drv.rounder_cb = rounderCallback;
+    drv.draw_buf = &drawBuf;
+    drv.user_data = this;
+    lv_disp_drv_register(&drv);
+}
+
+void FramebufferDisplay::flushCallback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    FramebufferDisplay *display = static_cast<FramebufferDisplay *>(drv->user_data);
+    uint32_t w = area->x2 - area->x1 + 1;
+    uint32_t h = area->y2 - area->y1 + 1;
+
+    for (uint32_t y = 0; y < h; y++)
+    {
+        memcpy(&display->framebuffer[(area->y1 + y) * WIDTH + area->x1], color_p + y * w, w * sizeof(lv_color_t));
+    }
+
+    display->stats.checksum = fnv1a(display->stats.checksum, area, sizeof(*area));
+    display->stats.checksum = fnv1a(display->stats.checksum, color_p, w * h * sizeof(lv_color_t));
+
+    display->stats.px += w * h;
+    display->stats.areas++;
+    lv_disp_flush_ready(drv);
+}
+
+void FramebufferDisplay::rounderCallback(lv_disp_drv_t * /*drv*/, lv_area_t *area)
+{
+    // The RM67162 needs even start and odd end coordinates (see LV_Helper)
+    if (area->x1 & 1)
+    {
+        area->x1--;
+    }
+    if (!(area->x2 & 1))
+    {
+        area->x2++;
+    }
+    if (area->y1 & 1)
+    {
+        area->y1--;
+    }
+    if (!(area->y2 & 1))
+    {
+        area->y2++;
+    }
+}
+
+// ============================================================================
+// OBJECT DRAW COUNTING
+// ============================================================================
+void FramebufferDisplay::objectEventCallback(lv_event_t *e)
+{
+    FramebufferDisplay *display = static_cast<FramebufferDisplay *>(lv_event_get_user_data(e));
+    lv_obj_t *obj = lv_event_get_target(e);
+
+    if (lv_event_get_code(e) == LV_EVENT_DELETE)
+    {
+        display->instrumented.erase(obj);
+        display->drawnThisFrame.erase(obj);
+        return;
+    }
+
+    display->stats.draws++;
+    if (display->drawnThisFrame.insert(obj).second)
+    {
+        display->stats.objects++;
+    }
+}
+
+void FramebufferDisplay::instrument(lv_obj_t *obj)
+{
+    if (instrumented.insert(obj).second)
+    {
+        lv_obj_add_event_cb(obj, objectEventCallback, LV_EVENT_DRAW_MAIN_BEGIN, this);
+        lv_obj_add_event_cb(obj, objectEventCallback, LV_EVENT_DELETE, this);
+    }
+
+    uint32_t count = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        instrument(lv_obj_get_child(obj, i));
+    }
+}
+
+void FramebufferDisplay::beginFrame()
+{
+    stats = FrameStats();
+    drawnThisFrame.clear();
+    instrument(lv_scr_act());
+}
+
+bool FramebufferDisplay::writePng(const char *path) const
+{
+    std::vector<uint8_t> rgb(WIDTH * HEIGHT * 3);
+    for (size_t i = 0; i < framebuffer.size(); i++)
+    {
+#if LV_COLOR_DEPTH == 8
+        // What the panel shows: the flush's RGB565 expansion, widened like lv_color_to32()
+        uint16_t c = panel_lut_rgb565(framebuffer[i].full);
+        rgb[i * 3] = ((c >> 11) * 263 + 7) >> 5;
+        rgb[i * 3 + 1] = (((c >> 5) & 0x3F) * 259 + 3) >> 6;
+        rgb[i * 3 + 2] = ((c & 0x1F) * 263 + 7) >> 5;
+#else
+        uint32_t c = lv_color_to32(framebuffer[i]);
+        rgb[i * 3] = c >> 16;
+        rgb[i * 3 + 1] = c >> 8;
+        rgb[i * 3 + 2] = c;
+#endif
+    }
+    return PngWriter::write(path, rgb.data(), WIDTH, HEIGHT);
+}
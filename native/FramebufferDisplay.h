@@ -0,0 +1,66 @@
+#pragma once
+#include <lvgl.h>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * LVGL display driver that renders into memory instead of the panel.
+ *
+ * Same resolution, draw buffer and even-coordinate rounding as the
+ * RM67162 setup in LV_Helper, so invalidated areas match the board. Each
+ * frame it counts the pixels flushed, the areas they came in and the
+ * objects LVGL drew to produce them, and checksums what was flushed.
+ */
+class FramebufferDisplay
+{
+public:
+    // RM67162 in landscape (rotation 0)
+    static constexpr lv_coord_t WIDTH = 536;
+    static constexpr lv_coord_t HEIGHT = 240;
+
+    /**
+     * What the last frame cost.
+     */
+    struct FrameStats
+    {
+        uint32_t px = 0;      // Pixels flushed
+        uint32_t areas = 0;   // Invalidated areas (one flush each)
+        uint32_t objects = 0; // Distinct objects drawn
+        uint32_t draws = 0;   // Object draw calls, counting every area an object was drawn in
+        uint32_t checksum = 2166136261u; // FNV-1a of the flushed areas and their pixels, in order
+    };
+
+private:
+    lv_disp_draw_buf_t drawBuf;
+    lv_disp_drv_t drv;
+    std::vector<lv_color_t> buffer;
+    std::vector<lv_color_t> framebuffer;
+
+    FrameStats stats;
+    std::unordered_set<lv_obj_t *> instrumented;
+    std::unordered_set<lv_obj_t *> drawnThisFrame;
+
+    static void flushCallback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    static void rounderCallback(lv_disp_drv_t *drv, lv_area_t *area);
+    static void objectEventCallback(lv_event_t *e);
+    void instrument(lv_obj_t *obj);
+
+public:
+    /**
+     * Initialise LVGL and register the display.
+     */
+    void begin();
+
+    /**
+     * Start counting a new frame.
+     * Also hooks any objects created since the last frame.
+     */
+    void beginFrame();
+
+    const FrameStats &getFrameStats() const { return stats; }
+
+    /**
+     * Save what is currently on the "panel" as a PNG.
+     */
+    bool writePng(const char *path) const;
+};
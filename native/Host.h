@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Simulated time for the native build.
+ * millis()/micros() and LVGL's tick read this clock, and only the
+ * renderer moves it, so a scripted run renders the same frames every time.
+ */
+namespace Host
+{
+    // Move the clock forward
+    void advance(uint32_t ms);
+
+    // Current simulated time in milliseconds
+    uint32_t now();
+}
@@ -0,0 +1,101 @@
+#include "PngWriter.h"
+#include <stdio.h>
+#include <vector>
+
+namespace PngWriter
+{
+    static uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0)
+    {
+        static uint32_t table[256];
+        if (table[1] == 0)
+        {
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[n] = c;
+            }
+        }
+
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    static void put32(std::vector<uint8_t> &out, uint32_t v)
+    {
+        out.push_back(v >> 24);
+        out.push_back(v >> 16);
+        out.push_back(v >> 8);
+        out.push_back(v);
+    }
+
+    static void chunk(FILE *f, const char *type, const std::vector<uint8_t> &data)
+    {
+        std::vector<uint8_t> out;
+        put32(out, data.size());
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        put32(out, crc32(out.data() + 4, out.size() - 4));
+        fwrite(out.data(), 1, out.size(), f);
+    }
+
+    bool write(const char *path, const uint8_t *rgb, uint32_t width, uint32_t height)
+    {
+        FILE *f = fopen(path, "wb");
+        if (f == nullptr)
+        {
+            return false;
+        }
+
+        static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        fwrite(SIGNATURE, 1, sizeof(SIGNATURE), f);
+
+        std::vector<uint8_t> header;
+        put32(header, width);
+        put32(header, height);
+        header.insert(header.end(), {8, 2, 0, 0, 0}); // 8-bit RGB, no interlace
+        chunk(f, "IHDR", header);
+
+        // Scanlines, each prefixed with filter type 0
+        std::vector<uint8_t> raw;
+        raw.reserve((width * 3 + 1) * height);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            raw.push_back(0);
+            raw.insert(raw.end(), rgb + y * width * 3, rgb + (y + 1) * width * 3);
+        }
+
+        // zlib stream of stored blocks
+        std::vector<uint8_t> z = {0x78, 0x01};
+        for (size_t pos = 0; pos < raw.size();)
+        {
+            size_t len = raw.size() - pos < 65535 ? raw.size() - pos : 65535;
+            z.push_back(pos + len == raw.size() ? 1 : 0);
+            z.push_back(len & 0xFF);
+            z.push_back(len >> 8);
+            z.push_back(~len & 0xFF);
+            z.push_back((~len >> 8) & 0xFF);
+            z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+            pos += len;
+        }
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : raw)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        put32(z, (b << 16) | a);
+        chunk(f, "IDAT", z);
+
+        chunk(f, "IEND", {});
+        return fclose(f) == 0;
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Minimal PNG encoder for snapshots.
+ * Writes 8-bit RGB with stored (uncompressed) deflate blocks, so it needs
+ * no zlib.
+ */
+namespace PngWriter
+{
+    bool write(const char *path, const uint8_t *rgb, uint32_t width, uint32_t height);
+}
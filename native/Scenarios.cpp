@@ -0,0 +1,78 @@
+#include "Scenarios.h"
+
+// Page indices, in PageManager::init() order
+static constexpr int SPEED = 0;
+static constexpr int GAUGE = 1;
+static constexpr int STATS = 2;
+static constexpr int HISTORY = 3;
+static constexpr int GFORCE = 4;
+static constexpr int INFO = 5;
+static constexpr int STAY = -1;
+
+#define STEPS(steps) steps, sizeof(steps) / sizeof(steps[0])
+
+// ============================================================================
+// STEP TABLES
+// State columns: gps, fix, mph, sats, hdop, battery mV, usb, charge mA, turn deg/s
+// ============================================================================
+static const ScenarioStep BOOT[] = {
+    {"no-module", 4000, {false, false, 0.0f, 0, 99.9f, 3950, false, 0, 0.0f}, STAY},
+    {"searching", 4000, {true, false, 0.0f, 3, 99.9f, 3950, false, 0, 0.0f}, STAY},
+    {"first-fix", 4000, {true, true, 0.0f, 5, 4.2f, 3950, false, 0, 0.0f}, STAY},
+    {"good-fix", 4000, {true, true, 0.0f, 11, 0.9f, 3950, false, 0, 0.0f}, STAY},
+};
+
+static const ScenarioStep RIDE[] = {
+    {"parked", 3000, {true, true, 0.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"pull-away", 6000, {true, true, 30.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"accelerate", 6000, {true, true, 62.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"cruise", 10000, {true, true, 63.5f, 9, 1.1f, 3940, false, 0, 0.0f}, STAY},
+    {"brake", 6000, {true, true, 0.0f, 9, 1.1f, 3940, false, 0, 0.0f}, STAY},
+    {"stopped", 4000, {true, true, 0.0f, 9, 1.1f, 3940, false, 0, 0.0f}, STAY},
+};
+
+// Bends either way at a steady speed, for the lean trace
+static const ScenarioStep TWISTIES[] = {
+    {"parked", 3000, {true, true, 0.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"pull-away", 5000, {true, true, 35.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"straight", 5000, {true, true, 50.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"right-hander", 4000, {true, true, 50.0f, 10, 0.9f, 3950, false, 0, 20.0f}, STAY},
+    {"left-hander", 4000, {true, true, 48.0f, 10, 0.9f, 3950, false, 0, -25.0f}, STAY},
+    {"hairpin", 4000, {true, true, 25.0f, 10, 0.9f, 3950, false, 0, 45.0f}, STAY},
+    {"exit", 5000, {true, true, 55.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+};
+
+static const ScenarioStep SIGNAL_LOSS[] = {
+    {"cruise", 4000, {true, true, 45.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"tunnel", 5000, {true, false, 45.0f, 2, 99.9f, 3950, false, 0, 0.0f}, STAY},
+    {"reacquire", 4000, {true, true, 42.0f, 6, 2.5f, 3950, false, 0, 0.0f}, STAY},
+    {"unplugged", 5000, {false, false, 42.0f, 0, 99.9f, 3950, false, 0, 0.0f}, STAY},
+};
+
+static const ScenarioStep SWIPE[] = {
+    {"cruise", 2000, {true, true, 40.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STAY},
+    {"to-stats", 2000, {true, true, 40.0f, 10, 0.9f, 3950, false, 0, 0.0f}, STATS},
+    {"to-info", 2000, {true, true, 40.0f, 10, 0.9f, 3950, false, 0, 0.0f}, INFO},
+    {"to-speed", 2000, {true, true, 40.0f, 10, 0.9f, 3950, false, 0, 0.0f}, SPEED},
+};
+
+static const ScenarioStep CHARGING[] = {
+    {"battery", 3000, {true, true, 0.0f, 10, 0.9f, 3700, false, 0, 0.0f}, STAY},
+    {"plugged-in", 5000, {true, true, 0.0f, 10, 0.9f, 3820, true, 850, 0.0f}, STAY},
+    {"topping-off", 5000, {true, true, 0.0f, 10, 0.9f, 4150, true, 120, 0.0f}, STAY},
+    {"unplugged", 3000, {true, true, 0.0f, 10, 0.9f, 4140, false, 0, 0.0f}, STAY},
+};
+
+const Scenario SCENARIOS[] = {
+    {"boot", INFO, STEPS(BOOT)},
+    {"ride-speed", SPEED, STEPS(RIDE)},
+    {"ride-gauge", GAUGE, STEPS(RIDE)},
+    {"ride-stats", STATS, STEPS(RIDE)},
+    {"history", HISTORY, STEPS(TWISTIES)},
+    {"gforce", GFORCE, STEPS(TWISTIES)},
+    {"signal-loss", SPEED, STEPS(SIGNAL_LOSS)},
+    {"swipe", SPEED, STEPS(SWIPE)},
+    {"charging", INFO, STEPS(CHARGING)},
+};
+
+const size_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
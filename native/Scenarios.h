@@ -0,0 +1,30 @@
+#pragma once
+#include "SimSensors.h"
+#include <stddef.h>
+
+/**
+ * One leg of a scripted run.
+ * Speed and turn rate ramp linearly from the previous step's to the ones in
+ * `state` over the step; everything else switches at the start of it.
+ */
+struct ScenarioStep
+{
+    const char *label;
+    uint32_t durationMs;
+    SimState state;
+    int page; // Page to swipe to when the step starts, -1 to stay
+};
+
+/**
+ * A named data sequence, started on a given page.
+ */
+struct Scenario
+{
+    const char *name;
+    int startPage;
+    const ScenarioStep *steps;
+    size_t stepCount;
+};
+
+extern const Scenario SCENARIOS[];
+extern const size_t SCENARIO_COUNT;
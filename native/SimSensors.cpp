@@ -0,0 +1,95 @@
+#include "SimSensors.h"
+#include "Host.h"
+#include "sensors/Power.h"
+#include <Arduino.h>
+#include <math.h>
+
+namespace SimSensors
+{
+    static SimState current = {false, false, 0.0f, 0, 99.9f, 3950, false, 0, 0.0f};
+
+    // Fixed position and a time of day that follows the simulated clock
+    static constexpr uint32_t START_OF_DAY_S = 8 * 3600 + 15 * 60;
+    static constexpr float KNOTS_PER_MPH = 0.868976f;
+
+    // Course integrated from the turn rate between fixes
+    static float courseDeg = 0.0f;
+    static uint32_t lastFixMs = 0;
+
+    void set(const SimState &state)
+    {
+        current = state;
+    }
+
+    const SimState &get()
+    {
+        return current;
+    }
+
+    static void sendSentence(const char *body)
+    {
+        uint8_t checksum = 0;
+        for (const char *p = body; *p; p++)
+        {
+            checksum ^= *p;
+        }
+
+        char sentence[128];
+        snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", body, checksum);
+        Serial1.feed(sentence);
+    }
+
+    void sendFix()
+    {
+        if (!current.gpsConnected)
+        {
+            return;
+        }
+
+        uint32_t ms = Host::now();
+        courseDeg = fmodf(courseDeg + current.turnDegPerS * (ms - lastFixMs) / 1000.0f + 360.0f, 360.0f);
+        lastFixMs = ms;
+        uint32_t s = START_OF_DAY_S + ms / 1000;
+        char utc[16];
+        snprintf(utc, sizeof(utc), "%02lu%02lu%02lu.%02lu", (unsigned long)(s / 3600 % 24),
+                 (unsigned long)(s / 60 % 60), (unsigned long)(s % 60), (unsigned long)(ms % 1000 / 10));
+
+        char body[112];
+        if (current.fix)
+        {
+            snprintf(body, sizeof(body), "GPRMC,%s,A,5130.0000,N,00007.0000,W,%.2f,%.1f,190626,,,A",
+                     utc, current.speedMph * KNOTS_PER_MPH, courseDeg);
+            sendSentence(body);
+            snprintf(body, sizeof(body), "GPGGA,%s,5130.0000,N,00007.0000,W,1,%02u,%.1f,35.0,M,47.0,M,,",
+                     utc, current.satellites, current.hdop);
+        }
+        else
+        {
+            snprintf(body, sizeof(body), "GPRMC,%s,V,,,,,,,190626,,,N", utc);
+            sendSentence(body);
+            snprintf(body, sizeof(body), "GPGGA,%s,,,,,0,%02u,%.1f,,,,,,", utc, current.satellites, current.hdop);
+        }
+        sendSentence(body);
+    }
+}
+
+// ============================================================================
+// PMU - replaces src/sensors/Power.cpp
+// ============================================================================
+namespace Power
+{
+    uint16_t getBattVoltage()
+    {
+        return SimSensors::get().battMillivolts;
+    }
+
+    bool isVbusIn()
+    {
+        return SimSensors::get().usbConnected;
+    }
+
+    int32_t getChargeCurrent()
+    {
+        return SimSensors::get().chargeMa;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * Everything the pages read from the sensors, as a scenario sets it.
+ */
+struct SimState
+{
+    bool gpsConnected;  // Module sending NMEA
+    bool fix;           // Valid position and speed
+    float speedMph;
+    uint8_t satellites;
+    float hdop;
+    uint16_t battMillivolts; // 0 = no battery
+    bool usbConnected;
+    int32_t chargeMa;
+    float turnDegPerS;  // Course change, right positive
+};
+
+/**
+ * Scripted sensor data for the native build.
+ *
+ * GPS data goes through the real GPS class: fixes are written to Serial1
+ * as NMEA ($GPRMC + $GPGGA) and parsed by TinyGPS++. The PMU is replaced
+ * by the Power functions reading the state directly.
+ */
+namespace SimSensors
+{
+    void set(const SimState &state);
+    const SimState &get();
+
+    /**
+     * Queue one fix for the current state on the GPS port.
+     * Does nothing while the module is "disconnected".
+     */
+    void sendFix();
+}
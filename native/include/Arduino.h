@@ -0,0 +1,98 @@
+/**
+ * @file      Arduino.h
+ * @brief     Host stand-in for the parts of the ESP32 Arduino core the UI uses
+ *
+ * Only used by the native environment. millis()/micros() run on the
+ * simulated clock in Host.h so scripted runs are repeatable; delay() does
+ * not advance it.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+// LVGL's tick source includes this header from C; the rest is C++ only
+#ifdef __cplusplus
+#include <algorithm>
+
+// ============================================================================
+// FreeRTOS - the UI notifies and delays its own task, which is the host's
+// main thread, and those calls do nothing. Tasks it creates (the draw
+// unit's worker) run as host threads that stall for a random while at
+// their scheduling points, as if preempted on a busy core, so they race
+// the main thread in every order
+// ============================================================================
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdMS_TO_TICKS(ms) (ms)
+#define portMAX_DELAY 0xffffffffUL
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+
+typedef enum
+{
+    eNoAction,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite
+} eNotifyAction;
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline BaseType_t xTaskNotify(TaskHandle_t, uint32_t, eNotifyAction) { return pdTRUE; }
+inline BaseType_t xTaskNotifyWait(uint32_t, uint32_t, uint32_t *value, TickType_t)
+{
+    if (value != nullptr)
+    {
+        *value = 0;
+    }
+    return pdFALSE;
+}
+inline void vTaskDelay(TickType_t) {}
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *name, uint32_t stackBytes, void *parameter,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t timeout);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void taskYIELD();
+void vTaskSuspendAll();
+BaseType_t xTaskResumeAll();
+
+#include "HardwareSerial.h"
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file      HardwareSerial.h
+ * @brief     Host stand-in for the ESP32 UART class
+ *
+ * Serial writes to a host stream (stdout unless redirected), Serial1 is the
+ * GPS port: the simulator pushes NMEA into it with feed() and anything the
+ * firmware sends to the module is discarded.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string>
+
+#define SERIAL_8N1 0x800001c
+
+class HardwareSerial
+{
+private:
+    FILE *out;
+    std::string rx;
+    size_t rxPos = 0;
+
+public:
+    explicit HardwareSerial(FILE *output) : out(output) {}
+
+    void begin(unsigned long /*baud*/, uint32_t /*config*/ = SERIAL_8N1, int8_t /*rxPin*/ = -1, int8_t /*txPin*/ = -1) {}
+    void end() {}
+    void flush();
+    operator bool() const { return true; }
+
+    // Route output somewhere else (nullptr to drop it)
+    void setOutput(FILE *output) { out = output; }
+
+    // Queue bytes for read()
+    void feed(const char *data);
+
+    int available();
+    int read();
+
+    size_t write(uint8_t c);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int value);
+    size_t println(const char *str = "");
+    size_t printf(const char *fmt, ...);
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
@@ -0,0 +1,37 @@
+/**
+ * @file      esp_heap_caps.h
+ * @brief     Host stand-in for the ESP-IDF capability allocator
+ *
+ * There is a single host heap, so every capability maps to malloc() and
+ * every pointer counts as internal RAM. The free size is reported as the
+ * ESP32-S3's internal SRAM so the tiered allocator makes the same choices
+ * it would on the board.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *heap_caps_malloc(size_t size, uint32_t caps);
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void heap_caps_free(void *ptr);
+size_t heap_caps_get_allocated_size(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+bool esp_ptr_external_ram(const void *ptr);
+bool esp_ptr_internal(const void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
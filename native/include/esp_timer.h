@@ -0,0 +1,17 @@
+/**
+ * @file      esp_timer.h
+ * @brief     Host stand-in for esp_timer - wall clock, for profiling
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
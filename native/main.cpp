@@ -0,0 +1,502 @@
+/**
+ * Headless renderer for the HUD pages.
+ *
+ * Builds the real PageManager and pages against a memory framebuffer,
+ * plays the scripted sensor sequences in Scenarios.cpp through them and
+ * records what every rendered frame cost. Writes report.json and a PNG per
+ * scenario step to the output directory; compare two reports with
+ * tools/render/compare_reports.py.
+ *
+ * --draw-unit shares the big blends with the draw unit's worker on a second
+ * thread that stalls at random (see Arduino.h), so core 0 finishing early,
+ * late or having its slice taken back all come up. Every frame it flushes
+ * must match a run without it: tools/render/compare_reports.py --pixels.
+ *
+ * Usage: program [--out DIR] [--scenario NAME] [--no-png] [--live-swipes] [--draw-unit] [--verbose]
+ */
+#include "FramebufferDisplay.h"
+#include "Host.h"
+#include "Scenarios.h"
+#include "SimSensors.h"
+#include "sensors/GPS.h"
+#include "ui/DrawUnit.h"
+#include "ui/FrameScheduler.h"
+#include "ui/PageManager.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <errno.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+// The pages read the GPS through this global, as on the board
+GPS gps;
+
+namespace
+{
+    constexpr uint32_t FRAME_MS = 33;       // Display loop period (riding refresh cap)
+    constexpr uint32_t GPS_PERIOD_MS = 200; // 5 Hz, the rate configureConstellations() asks for
+    constexpr uint32_t SETTLE_MS = 1000;    // Unrecorded frames after jumping to the start page
+    constexpr float LEAD_IN_MPH_PER_S = 8.0f; // Speed change into a scenario's first step, about 0.35 g
+    constexpr int STYLE_PASSES = 2000;      // Lookups per object in one style benchmark run
+    constexpr int STYLE_RUNS = 7;           // Benchmark runs per page; the fastest is reported
+
+    struct FrameRecord
+    {
+        uint32_t t; // ms since the scenario started
+        size_t step;
+        int page;
+        uint32_t updateUs;
+        uint32_t renderUs;
+        FramebufferDisplay::FrameStats stats;
+    };
+
+    struct ScenarioResult
+    {
+        const Scenario *scenario;
+        std::vector<FrameRecord> frames;
+        uint32_t iterations = 0;
+    };
+
+    // Per-page cost of resolving label styles, as a redraw does it
+    struct StyleRecord
+    {
+        uint32_t objects = 0;
+        uint32_t nsPerObject = 0;
+    };
+
+    struct Options
+    {
+        std::string outDir = ".pio/render";
+        const char *only = nullptr;
+        bool png = true;
+        bool liveSwipes = false; // Swipe on live widgets instead of page snapshots
+        bool drawUnit = false;   // Share blends with the draw unit's worker thread
+        bool verbose = false;
+    };
+
+    FramebufferDisplay framebuffer;
+    uint32_t nextFix = 0;
+    uint32_t bootUs = 0; // Wall time from LVGL init to the first rendered frame
+
+    bool makeDirs(const std::string &path)
+    {
+        for (size_t i = 1; i <= path.size(); i++)
+        {
+            if (i == path.size() || path[i] == '/')
+            {
+                if (mkdir(path.substr(0, i).c_str(), 0755) != 0 && errno != EEXIST)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * One pass of the firmware's sensor and display task loops.
+     * Returns true if LVGL rendered a frame.
+     */
+    bool runIteration(FrameRecord &record)
+    {
+        Host::advance(FRAME_MS);
+
+        // Sensor task: new NMEA arrives at the module's rate
+        if (Host::now() >= nextFix)
+        {
+            SimSensors::sendFix();
+            nextFix += GPS_PERIOD_MS;
+        }
+        if (gps.loop())
+        {
+            FrameScheduler::getInstance().publish(gps.getSpeedMph());
+        }
+
+        // Display task: update, layout, LVGL timers (refresh and animations)
+        framebuffer.beginFrame();
+        int64_t start = esp_timer_get_time();
+        PageManager::getInstance().update();
+        int64_t updated = esp_timer_get_time();
+        lv_obj_update_layout(lv_scr_act());
+        lv_timer_handler();
+        int64_t rendered = esp_timer_get_time();
+        PageManager::getInstance().idleWork();
+
+        record.page = PageManager::getInstance().getCurrentPageIndex();
+        record.updateUs = updated - start;
+        record.renderUs = rendered - updated;
+        record.stats = framebuffer.getFrameStats();
+        return record.stats.px > 0;
+    }
+
+    /**
+     * `to`, with speed and turn rate `done` (0-1) of the way there from `from`.
+     */
+    SimState ramp(const SimState &from, const SimState &to, float done)
+    {
+        SimState state = to;
+        state.speedMph = from.speedMph + (to.speedMph - from.speedMph) * done;
+        state.turnDegPerS = from.turnDegPerS + (to.turnDegPerS - from.turnDegPerS) * done;
+        return state;
+    }
+
+    ScenarioResult runScenario(const Scenario &scenario, const Options &options)
+    {
+        ScenarioResult result;
+        result.scenario = &scenario;
+
+        // Unrecorded lead-in from wherever the last scenario stopped, at a
+        // rate a bike can brake or accelerate
+        const SimState &first = scenario.steps[0].state;
+        SimState from = SimSensors::get();
+        float changeMph = fabsf(first.speedMph - from.speedMph);
+        uint32_t leadInMs = std::max(SETTLE_MS, (uint32_t)(changeMph / LEAD_IN_MPH_PER_S * 1000.0f));
+        PageManager::getInstance().goToPage(scenario.startPage, false);
+        FrameRecord unused;
+        for (uint32_t t = 0; t < leadInMs; t += FRAME_MS)
+        {
+            SimSensors::set(ramp(from, first, std::min(1.0f, (float)(t + FRAME_MS) / leadInMs)));
+            runIteration(unused);
+        }
+        SimSensors::set(first);
+
+        uint32_t startMs = Host::now();
+        for (size_t i = 0; i < scenario.stepCount; i++)
+        {
+            const ScenarioStep &step = scenario.steps[i];
+            SimState from = SimSensors::get();
+            if (step.page >= 0)
+            {
+                PageManager::getInstance().goToPage(step.page);
+            }
+
+            for (uint32_t t = 0; t < step.durationMs; t += FRAME_MS)
+            {
+                SimSensors::set(ramp(from, step.state, std::min(1.0f, (float)(t + FRAME_MS) / step.durationMs)));
+
+                FrameRecord record;
+                record.step = i;
+                if (runIteration(record))
+                {
+                    record.t = Host::now() - startMs;
+                    result.frames.push_back(record);
+                }
+                result.iterations++;
+            }
+
+            if (options.png)
+            {
+                char path[256];
+                snprintf(path, sizeof(path), "%s/%s-%02u-%s.png", options.outDir.c_str(), scenario.name,
+                         (unsigned)i, step.label);
+                if (!framebuffer.writePng(path))
+                {
+                    fprintf(stderr, "render: cannot write %s\n", path);
+                }
+            }
+        }
+        return result;
+    }
+
+    void collectObjects(lv_obj_t *obj, std::vector<lv_obj_t *> &out)
+    {
+        for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++)
+        {
+            lv_obj_t *child = lv_obj_get_child(obj, i);
+            out.push_back(child);
+            collectObjects(child, out);
+        }
+    }
+
+    /**
+     * Time lv_obj_init_draw_label_dsc() over every object on each page -
+     * the style lookups a label redraw makes - with all pages built.
+     */
+    std::vector<StyleRecord> measureStyles()
+    {
+        PageManager &pages = PageManager::getInstance();
+        std::vector<StyleRecord> records(pages.getPageCount());
+        for (int i = 0; i < pages.getPageCount(); i++)
+        {
+            pages.goToPage(i, false);
+            std::vector<lv_obj_t *> objects;
+            collectObjects(pages.getPage(i)->getTile(), objects);
+
+            // Fastest run, so scheduling noise on the host doesn't count
+            int64_t best = INT64_MAX;
+            lv_draw_label_dsc_t dsc;
+            for (int run = 0; run < STYLE_RUNS; run++)
+            {
+                int64_t start = esp_timer_get_time();
+                for (int pass = 0; pass < STYLE_PASSES; pass++)
+                {
+                    for (lv_obj_t *obj : objects)
+                    {
+                        lv_draw_label_dsc_init(&dsc);
+                        lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+                    }
+                }
+                best = std::min(best, esp_timer_get_time() - start);
+            }
+
+            records[i].objects = objects.size();
+            records[i].nsPerObject = objects.empty() ? 0 : best * 1000 / ((int64_t)STYLE_PASSES * objects.size());
+        }
+        return records;
+    }
+
+    // ========================================================================
+    // REPORT
+    // ========================================================================
+    struct Summary
+    {
+        uint32_t frames = 0;
+        uint32_t idle = 0;
+        uint64_t px = 0;
+        uint32_t pxMax = 0;
+        uint64_t areas = 0;
+        uint64_t objects = 0;
+        uint32_t objectsMax = 0;
+        uint64_t draws = 0;
+        uint32_t renderAvgUs = 0;
+        uint32_t renderP95Us = 0;
+        uint32_t renderMaxUs = 0;
+        uint32_t updateAvgUs = 0;
+    };
+
+    Summary summarise(const ScenarioResult &result)
+    {
+        Summary s;
+        s.frames = result.frames.size();
+        s.idle = result.iterations - s.frames;
+
+        std::vector<uint32_t> render;
+        uint64_t renderTotal = 0;
+        uint64_t updateTotal = 0;
+        for (const FrameRecord &f : result.frames)
+        {
+            s.px += f.stats.px;
+            s.pxMax = std::max(s.pxMax, f.stats.px);
+            s.areas += f.stats.areas;
+            s.objects += f.stats.objects;
+            s.objectsMax = std::max(s.objectsMax, f.stats.objects);
+            s.draws += f.stats.draws;
+            render.push_back(f.renderUs);
+            renderTotal += f.renderUs;
+            updateTotal += f.updateUs;
+        }
+
+        if (!render.empty())
+        {
+            std::sort(render.begin(), render.end());
+            s.renderAvgUs = renderTotal / render.size();
+            s.renderP95Us = render[(render.size() * 95) / 100 < render.size() ? (render.size() * 95) / 100 : render.size() - 1];
+            s.renderMaxUs = render.back();
+            s.updateAvgUs = updateTotal / render.size();
+        }
+        return s;
+    }
+
+    void writeSummary(FILE *f, const Summary &s)
+    {
+        fprintf(f,
+                "{\"frames\": %u, \"idle_iterations\": %u, \"px_total\": %llu, \"px_max\": %u, "
+                "\"areas_total\": %llu, \"objects_total\": %llu, \"objects_max\": %u, \"draws_total\": %llu, "
+                "\"render_us_avg\": %u, \"render_us_p95\": %u, \"render_us_max\": %u, \"update_us_avg\": %u}",
+                s.frames, s.idle, (unsigned long long)s.px, s.pxMax, (unsigned long long)s.areas,
+                (unsigned long long)s.objects, s.objectsMax, (unsigned long long)s.draws,
+                s.renderAvgUs, s.renderP95Us, s.renderMaxUs, s.updateAvgUs);
+    }
+
+    bool writeReport(const std::string &path, const std::vector<ScenarioResult> &results,
+                     const std::vector<StyleRecord> &styles)
+    {
+        FILE *f = fopen(path.c_str(), "w");
+        if (f == nullptr)
+        {
+            return false;
+        }
+
+        PageManager &pages = PageManager::getInstance();
+        fprintf(f, "{\n  \"display\": {\"width\": %d, \"height\": %d, \"frame_ms\": %u},\n",
+                FramebufferDisplay::WIDTH, FramebufferDisplay::HEIGHT, FRAME_MS);
+
+        const SnapshotTransition::Stats &swipes = pages.getTransition().getStats();
+        fprintf(f,
+                "  \"swipes\": {\"mode\": \"%s\", \"snapshot_swipes\": %u, \"tiles\": %u, \"snapshot_us_avg\": %u, "
+                "\"snapshot_us_max\": %u},\n",
+                pages.getTransition().isEnabled() ? "snapshot" : "live", swipes.transitions, swipes.tiles,
+                swipes.transitions ? (uint32_t)(swipes.snapshotUs / swipes.transitions) : 0, swipes.snapshotMaxUs);
+        fprintf(f, "  \"boot\": {\"first_frame_us\": %u, \"pages_built\": %d, \"pages\": %d},\n", bootUs,
+                pages.getBuiltAtBoot(), pages.getPageCount());
+
+        fprintf(f, "  \"pages\": [");
+        for (int i = 0; i < pages.getPageCount(); i++)
+        {
+            const PageManager::PageStats &ps = pages.getPageStats(i);
+            fprintf(f,
+                    "%s\n    {\"name\": \"%s\", \"objects\": %u, \"bytes\": %u, \"build_us\": %u, "
+                    "\"builds\": %u, \"releases\": %u, \"style_ns_per_object\": %u}",
+                    i ? "," : "", pages.getPage(i)->getName(), ps.objects, ps.bytes, ps.buildUs, ps.builds,
+                    ps.releases, styles[i].nsPerObject);
+        }
+        fprintf(f, "\n  ],\n  \"scenarios\": [\n");
+
+        for (size_t r = 0; r < results.size(); r++)
+        {
+            const ScenarioResult &result = results[r];
+            const Scenario &scenario = *result.scenario;
+
+            fprintf(f, "    {\"name\": \"%s\", \"start_page\": \"%s\",\n      \"summary\": ", scenario.name,
+                    pages.getPage(scenario.startPage)->getName());
+            writeSummary(f, summarise(result));
+            fprintf(f, ",\n      \"frames\": [");
+
+            for (size_t i = 0; i < result.frames.size(); i++)
+            {
+                const FrameRecord &fr = result.frames[i];
+                fprintf(f,
+                        "%s\n        {\"t\": %u, \"step\": \"%s\", \"page\": \"%s\", \"update_us\": %u, "
+                        "\"render_us\": %u, \"px\": %u, \"areas\": %u, \"objects\": %u, \"draws\": %u, "
+                        "\"checksum\": \"%08x\"}",
+                        i ? "," : "", fr.t, scenario.steps[fr.step].label, pages.getPage(fr.page)->getName(),
+                        fr.updateUs, fr.renderUs, fr.stats.px, fr.stats.areas, fr.stats.objects, fr.stats.draws,
+                        fr.stats.checksum);
+            }
+            fprintf(f, "\n      ]}%s\n", r + 1 < results.size() ? "," : "");
+        }
+
+        fprintf(f, "  ]\n}\n");
+        return fclose(f) == 0;
+    }
+
+    void printTable(const std::vector<ScenarioResult> &results)
+    {
+        printf("%-12s %7s %6s %11s %9s %8s %8s %10s %10s\n", "scenario", "frames", "idle", "px", "px/frame",
+               "objects", "obj/frm", "render avg", "render p95");
+        for (const ScenarioResult &result : results)
+        {
+            Summary s = summarise(result);
+            printf("%-12s %7u %6u %11llu %9llu %8llu %8.1f %8u us %8u us\n", result.scenario->name, s.frames, s.idle,
+                   (unsigned long long)s.px, (unsigned long long)(s.frames ? s.px / s.frames : 0),
+                   (unsigned long long)s.objects, s.frames ? (double)s.objects / s.frames : 0.0,
+                   s.renderAvgUs, s.renderP95Us);
+        }
+    }
+
+    bool parseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--out" && i + 1 < argc)
+            {
+                options.outDir = argv[++i];
+            }
+            else if (arg == "--scenario" && i + 1 < argc)
+            {
+                options.only = argv[++i];
+            }
+            else if (arg == "--no-png")
+            {
+                options.png = false;
+            }
+            else if (arg == "--live-swipes")
+            {
+                options.liveSwipes = true;
+            }
+            else if (arg == "--draw-unit")
+            {
+                options.drawUnit = true;
+            }
+            else if (arg == "--verbose")
+            {
+                options.verbose = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseArgs(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [--out DIR] [--scenario NAME] [--no-png] [--live-swipes] [--draw-unit] [--verbose]\n",
+                argv[0]);
+        return 2;
+    }
+    if (!makeDirs(options.outDir))
+    {
+        fprintf(stderr, "render: cannot create %s\n", options.outDir.c_str());
+        return 1;
+    }
+
+    // Firmware logging goes to stdout only when asked for
+    if (!options.verbose)
+    {
+        Serial.setOutput(nullptr);
+    }
+
+    int64_t bootStart = esp_timer_get_time();
+    framebuffer.begin();
+    if (options.drawUnit)
+    {
+        DrawUnit::getInstance().begin();
+        DrawUnit::getInstance().setEnabled(true);
+    }
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_black(), 0);
+    gps.begin();
+    PageManager::getInstance().init();
+    PageManager::getInstance().setSnapshotTransitions(!options.liveSwipes);
+    framebuffer.beginFrame();
+    lv_timer_handler();
+    bootUs = esp_timer_get_time() - bootStart;
+
+    std::vector<ScenarioResult> results;
+    for (size_t i = 0; i < SCENARIO_COUNT; i++)
+    {
+        if (options.only == nullptr || strcmp(options.only, SCENARIOS[i].name) == 0)
+        {
+            results.push_back(runScenario(SCENARIOS[i], options));
+        }
+    }
+    if (results.empty())
+    {
+        fprintf(stderr, "render: no scenario named %s\n", options.only);
+        return 2;
+    }
+
+    std::vector<StyleRecord> styles = measureStyles();
+
+    std::string reportPath = options.outDir + "/report.json";
+    if (!writeReport(reportPath, results, styles))
+    {
+        fprintf(stderr, "render: cannot write %s\n", reportPath.c_str());
+        return 1;
+    }
+
+    printTable(results);
+    printf("Boot: first frame after %u us with %d of %d pages built\n", bootUs,
+           PageManager::getInstance().getBuiltAtBoot(), PageManager::getInstance().getPageCount());
+    for (int i = 0; i < PageManager::getInstance().getPageCount(); i++)
+    {
+        const PageManager::PageStats &ps = PageManager::getInstance().getPageStats(i);
+        printf("Page %-6s %3u objects %6u bytes, style resolution %u ns/object\n",
+               PageManager::getInstance().getPage(i)->getName(), ps.objects, ps.bytes, styles[i].nsPerObject);
+    }
+    if (options.drawUnit)
+    {
+        const DrawUnit::Stats &draw = DrawUnit::getInstance().getStats();
+        printf("Draw unit: %u of %u blends shared, worker drew %u of %u slices, %u taken back from it\n",
+               draw.splits, draw.blends, DrawUnit::getInstance().getWorkerSlices(), draw.slices, draw.retaken);
+    }
+    printf("Report: %s\n", reportPath.c_str());
+    return 0;
+}
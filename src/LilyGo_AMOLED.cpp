@@ -9,6 +9,7 @@
 
 #include "LilyGo_AMOLED.h"
 #include <driver/gpio.h>
+#include <esp_heap_caps.h>
 
 #if ESP_ARDUINO_VERSION < ESP_ARDUINO_VERSION_VAL(3, 0, 0)
 #include <esp_adc_cal.h>
@@ -39,11 +40,40 @@
 #define LCD_CMD_SLPIN (0x10) // Go into sleep mode (DC/DC, oscillator, scanning stopped, but memory keeps content)
 #endif
 
+#ifndef LCD_CMD_PTLON
+#define LCD_CMD_PTLON (0x12) // Partial display mode on (only the partial area is scanned)
+#endif
+
+#ifndef LCD_CMD_NORON
+#define LCD_CMD_NORON (0x13) // Normal display mode on
+#endif
+
+#ifndef LCD_CMD_PTLAR
+#define LCD_CMD_PTLAR (0x30) // Partial area, first and last scan line
+#endif
+
+#ifndef LCD_CMD_IDMOFF
+#define LCD_CMD_IDMOFF (0x38) // Idle mode off
+#endif
+
+#ifndef LCD_CMD_IDMON
+#define LCD_CMD_IDMON (0x39) // Idle mode on (8 colors, top bit of each channel)
+#endif
+
+#ifndef LCD_CMD_TEOFF
+#define LCD_CMD_TEOFF (0x34) // Tearing effect line off
+#endif
+
+#ifndef LCD_CMD_TEON
+#define LCD_CMD_TEON (0x35) // Tearing effect line on
+#endif
+
 #ifndef LCD_CMD_BRIGHTNESS
 #define LCD_CMD_BRIGHTNESS (0x51)
 #endif
 
 #define SEND_BUF_SIZE (16384)
+#define EXPAND_CHUNK_SIZE (4096) // Pixels per indexed-push chunk, RGB565 in internal RAM
 #define TFT_SPI_MODE SPI_MODE0
 #define DEFAULT_SPI_HANDLER (SPI3_HOST)
 
@@ -51,6 +81,7 @@ LilyGo_AMOLED::LilyGo_AMOLED() : boards(NULL), _hasRTC(false), _disableTouch(fal
 {
     spiDev = NULL;
     pBuffer = NULL;
+    expandBuffer[0] = expandBuffer[1] = NULL;
     spi = NULL;
     _brightness = AMOLED_DEFAULT_BRIGHTNESS;
     // Prevent previously set hold
@@ -76,6 +107,12 @@ LilyGo_AMOLED::~LilyGo_AMOLED()
         pBuffer = NULL;
     }
 
+    for (uint16_t *&buffer : expandBuffer)
+    {
+        heap_caps_free(buffer);
+        buffer = NULL;
+    }
+
     if (spiDev)
     {
         spiDev->end();
@@ -1016,6 +1053,29 @@ uint8_t LilyGo_AMOLED::getBrightness()
     return _brightness;
 }
 
+void LilyGo_AMOLED::setTearingEffect(bool enable)
+{
+    // TEON parameter 0: pulse on V-blank only
+    uint8_t data = 0x00;
+    writeCommand(enable ? LCD_CMD_TEON : LCD_CMD_TEOFF, &data, enable ? 1 : 0);
+}
+
+void LilyGo_AMOLED::setPartialArea(uint16_t first, uint16_t last)
+{
+    uint8_t data[4] = {(uint8_t)(first >> 8), (uint8_t)(first & 0xFF), (uint8_t)(last >> 8), (uint8_t)(last & 0xFF)};
+    writeCommand(LCD_CMD_PTLAR, data, 4);
+}
+
+void LilyGo_AMOLED::setPartialMode(bool enable)
+{
+    writeCommand(enable ? LCD_CMD_PTLON : LCD_CMD_NORON, NULL, 0);
+}
+
+void LilyGo_AMOLED::setIdleMode(bool enable)
+{
+    writeCommand(enable ? LCD_CMD_IDMON : LCD_CMD_IDMOFF, NULL, 0);
+}
+
 void LilyGo_AMOLED::setAddrWindow(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye)
 {
     xs += _offset_x;
@@ -1115,6 +1175,144 @@ void LilyGo_AMOLED::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t
     }
 }
 
+// Look up count 8-bit pixels in lut. One word load per four pixels once
+// the source is aligned; the table stays hot in cache
+static void expandIndexed(uint16_t *dst, const uint8_t *src, uint32_t count, const uint16_t *lut)
+{
+    while (count > 0 && ((uintptr_t)src & 3))
+    {
+        *dst++ = lut[*src++];
+        count--;
+    }
+    const uint32_t *words = (const uint32_t *)src;
+    for (; count >= 4; count -= 4)
+    {
+        uint32_t w = *words++;
+        dst[0] = lut[w & 0xFF];
+        dst[1] = lut[(w >> 8) & 0xFF];
+        dst[2] = lut[(w >> 16) & 0xFF];
+        dst[3] = lut[w >> 24];
+        dst += 4;
+    }
+    src = (const uint8_t *)words;
+    while (count-- > 0)
+    {
+        *dst++ = lut[*src++];
+    }
+}
+
+void LilyGo_AMOLED::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, const uint8_t *data, const uint16_t *lut)
+{
+    if (boards->display.frameBufferSize)
+    {
+        // Expand while rotating into the frame buffer, one pass over the pixels
+        assert(pBuffer);
+        uint16_t _x = this->height() - (y + hight);
+        uint16_t _y = x;
+        uint32_t cum = 0;
+        for (uint16_t j = 0; j < width; j++)
+        {
+            for (uint16_t i = 0; i < hight; i++)
+            {
+                pBuffer[cum++] = lut[data[width * (hight - i - 1) + j]];
+            }
+        }
+        setAddrWindow(_x, _y, _x + hight - 1, _y + width - 1);
+        pushColors(pBuffer, width * hight);
+        return;
+    }
+
+    if (!expandBuffer[0])
+    {
+        for (uint16_t *&buffer : expandBuffer)
+        {
+            buffer = (uint16_t *)heap_caps_malloc(EXPAND_CHUNK_SIZE * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+            assert(buffer);
+        }
+    }
+
+    uint32_t len = width * hight;
+    setAddrWindow(x, y, x + width - 1, y + hight - 1);
+
+    if (spiDev)
+    {
+        setCS();
+        spiDev->beginTransaction(SPISettings(boards->display.freq, MSBFIRST, TFT_SPI_MODE));
+        digitalWrite(boards->display.d1, HIGH);
+        while (len > 0)
+        {
+            uint32_t chunk_size = len > EXPAND_CHUNK_SIZE ? EXPAND_CHUNK_SIZE : len;
+            expandIndexed(expandBuffer[0], data, chunk_size, lut);
+            spiDev->writeBytes((uint8_t *)expandBuffer[0], chunk_size * sizeof(uint16_t));
+            data += chunk_size;
+            len -= chunk_size;
+        }
+        spiDev->endTransaction();
+        clrCS();
+        return;
+    }
+
+    // Expand the next chunk while the previous one is on the bus
+    spi_transaction_ext_t t[2];
+    bool first_send = true;
+    bool in_flight = false;
+    int next = 0;
+    setCS();
+    while (len > 0)
+    {
+        uint32_t chunk_size = len > EXPAND_CHUNK_SIZE ? EXPAND_CHUNK_SIZE : len;
+        expandIndexed(expandBuffer[next], data, chunk_size, lut);
+
+        memset(&t[next], 0, sizeof(t[next]));
+        if (first_send)
+        {
+            t[next].base.flags = SPI_TRANS_MODE_QIO;
+            t[next].base.cmd = 0x32;
+            t[next].base.addr = 0x002C00;
+            first_send = false;
+        }
+        else
+        {
+            t[next].base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+        }
+        t[next].base.tx_buffer = expandBuffer[next];
+        t[next].base.length = chunk_size * 16;
+
+        spi_transaction_t *done;
+        if (in_flight)
+        {
+            spi_device_get_trans_result(spi, &done, portMAX_DELAY);
+        }
+        spi_device_queue_trans(spi, &t[next].base, portMAX_DELAY);
+        in_flight = true;
+
+        data += chunk_size;
+        len -= chunk_size;
+        next ^= 1;
+    }
+    if (in_flight)
+    {
+        spi_transaction_t *done;
+        spi_device_get_trans_result(spi, &done, portMAX_DELAY);
+    }
+    clrCS();
+}
+
+void LilyGo_AMOLED::startWrite()
+{
+    // The SPIClass path locks per transaction inside beginTransaction()
+    if (!spi || spiDev)
+        return;
+    spi_device_acquire_bus(spi, portMAX_DELAY);
+}
+
+void LilyGo_AMOLED::endWrite()
+{
+    if (!spi || spiDev)
+        return;
+    spi_device_release_bus(spi);
+}
+
 void LilyGo_AMOLED::pushColorsDMA(uint16_t *data, uint32_t len)
 {
     if (!spi)
@@ -346,6 +346,17 @@ public:
     void setBrightness(uint8_t level);
     uint8_t getBrightness();
 
+    // Turn the panel's tearing effect output on (V-blank pulses) or off
+    void setTearingEffect(bool enable);
+
+    // Scan lines [first, last] of the panel's native orientation stay lit in
+    // partial mode, everything else is shown black. Frame memory is kept
+    void setPartialArea(uint16_t first, uint16_t last);
+    void setPartialMode(bool enable);
+
+    // Idle mode shows 8 colors: only the top bit of each channel is used
+    void setIdleMode(bool enable);
+
     // void setRotation(uint8_t r) __attribute__((error("setRotation Method Not implemented")));
     void setRotation(uint8_t rotation);
     uint8_t getRotation();
@@ -355,6 +366,15 @@ public:
     void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, uint16_t *data);
     void pushColorsDMA(uint16_t *data, uint32_t len);
 
+    // Push 8-bit indexed pixels, expanded to RGB565 through lut (256 entries,
+    // in panel byte order) as they are rotated or sent
+    void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, const uint8_t *data, const uint16_t *lut);
+
+    // Acquire the QSPI bus until endWrite(), so the address window and pixel
+    // transactions of several pushes don't each lock and unlock it
+    void startWrite();
+    void endWrite();
+
     /**
      * @brief   Hang on SD card
      * @note   If the specified Pin is not passed in, the default Pin will be used as the SPI
@@ -426,6 +446,7 @@ private:
     void inline clrCS();
     void writeCommand(uint32_t cmd, uint8_t *pdat, uint32_t length);
     uint16_t *pBuffer;
+    uint16_t *expandBuffer[2];  // Internal DMA chunks for indexed pushes, allocated on first use
     spi_device_handle_t spi;
     uint8_t _brightness;
     const BoardsConfigure_t *boards;
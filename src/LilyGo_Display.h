@@ -25,6 +25,13 @@ public:
     virtual void pushColors(uint16_t *data, uint32_t len) = 0;
     virtual void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data) = 0;
     virtual void pushColorsDMA(uint16_t *data, uint32_t len) = 0;
+    // 8-bit pixels expanded to RGB565 through a 256-entry table on the way out
+    virtual void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data, const uint16_t *lut) = 0;
+    // Keep the bus across several pushes (one frame's areas); nothing to hold by default
+    virtual void startWrite() {}
+    virtual void endWrite() {}
+    virtual void setBrightness(uint8_t level) = 0;
+    virtual uint8_t getBrightness() = 0;
     virtual uint16_t  width() = 0;
     virtual uint16_t  height() = 0;
 
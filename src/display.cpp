@@ -1,4 +1,13 @@
 #include "display.h"
+#include "ui/Assets.h"
+#include "ui/DrawUnit.h"
+#include "ui/FlushCoalescer.h"
+#include "ui/FontReport.h"
+#include "ui/PowerEstimator.h"
+#include "ui/SdfFont.h"
+#include "ui/TearSync.h"
+
+volatile uint8_t Display::requestedPanelMode = Display::NO_REQUEST;
 
 Display::Display()
 {
@@ -22,12 +31,38 @@ bool Display::begin()
     // Initialize LVGL helper (non-DMA - this AMOLED uses SPIClass, not ESP-IDF SPI)
     beginLvglHelper(amoled);
 
+    // Merge each frame's dirty areas into fewer panel transfers, next to the panel flush
+    FlushCoalescer::getInstance().begin(&amoled);
+
+    // Pace flushes against the panel scan; rotated, the scan lines run along x
+    const BoardsConfigure_t *board = amoled.getBoardsConfigure();
+    if (board->display.te != BOARD_NONE_PIN)
+    {
+        amoled.setTearingEffect(true);
+        TearSync::getInstance().begin(board->display.te, board->display.height,
+                                      amoled.width() == board->display.height);
+    }
+
+    // Panel power from the lit pixels; owns the brightness so a budget can cap it
+    PowerEstimator::getInstance().begin(&amoled);
+
+    // Big blends shared with a worker on core 0
+    DrawUnit::getInstance().begin();
+
     // Set max brightness
     setBrightness(255);
 
     // Set black background
     lv_obj_set_style_bg_color(lv_scr_act(), lv_color_black(), 0);
 
+    // Asset and SDF fonts are set up before anything measures or styles them
+    Assets::begin();
+    SdfFont::begin();
+
+#ifdef FONT_REPORT
+    FontReport::print();
+#endif
+
     // Initialize the page manager (creates all pages)
     Serial.println("Initializing page manager...");
     PageManager::getInstance().init();
@@ -43,5 +78,236 @@ void Display::update()
 
 void Display::setBrightness(uint8_t brightness)
 {
-    amoled.setBrightness(brightness);
+    PowerEstimator::getInstance().setBrightness(brightness);
+}
+
+// ============================================================================
+// PANEL MODES
+// ============================================================================
+const char *Display::panelModeName(PanelMode mode)
+{
+    switch (mode)
+    {
+    case PanelMode::Full:
+        return "full";
+    case PanelMode::Idle:
+        return "idle";
+    case PanelMode::Partial:
+        return "partial";
+    default:
+        return "?";
+    }
+}
+
+bool Display::getPartialBand(lv_area_t &band, uint16_t &firstLine, uint16_t &lastLine)
+{
+    PageManager &pages = PageManager::getInstance();
+    Page *page = pages.getPage(pages.getCurrentPageIndex());
+    lv_area_t area;
+    if (page == nullptr || !page->getParkedArea(area))
+    {
+        return false;
+    }
+
+    // PTLAR selects whole scan lines; rotated, they run along x
+    const BoardsConfigure_t *board = amoled.getBoardsConfigure();
+    bool rotated = amoled.width() == board->display.height;
+    lv_coord_t w = amoled.width();
+    lv_coord_t h = amoled.height();
+    if (rotated)
+    {
+        lv_area_set(&band, area.x1, 0, area.x2, h - 1);
+    }
+    else
+    {
+        lv_area_set(&band, 0, area.y1, w - 1, area.y2);
+    }
+
+    // Even start and end, as every RM67162 window
+    band.x1 = LV_MAX(band.x1, 0) & ~1;
+    band.y1 = LV_MAX(band.y1, 0) & ~1;
+    band.x2 = LV_MIN(band.x2 | 1, w - 1);
+    band.y2 = LV_MIN(band.y2 | 1, h - 1);
+
+    uint16_t lines = board->display.height;
+    firstLine = rotated ? band.x1 : band.y1;
+    lastLine = rotated ? band.x2 : band.y2;
+    if (TearSync::getInstance().isScanReversed())
+    {
+        uint16_t first = lines - 1 - lastLine;
+        lastLine = lines - 1 - firstLine;
+        firstLine = first;
+    }
+    return true;
+}
+
+void Display::accountPanelMode(uint32_t now)
+{
+    if (lastAccount != 0)
+    {
+        uint32_t elapsed = now - lastAccount;
+        PanelModeStats &s = panelStats[(int)panelMode];
+        s.timeMs += elapsed;
+        s.energyMj += PowerEstimator::getInstance().estimateMw() * elapsed / 1000.0;
+    }
+    lastAccount = now;
+}
+
+bool Display::setPanelMode(PanelMode mode)
+{
+    if (mode == panelMode)
+    {
+        return true;
+    }
+
+    lv_area_t band;
+    uint16_t firstLine = 0;
+    uint16_t lastLine = 0;
+    if (mode == PanelMode::Partial && !getPartialBand(band, firstLine, lastLine))
+    {
+        return false;
+    }
+
+    accountPanelMode(millis());
+
+    lv_disp_t *disp = lv_disp_get_default();
+    if (defaultRefreshMs == 0 && disp && disp->refr_timer)
+    {
+        defaultRefreshMs = disp->refr_timer->period;
+    }
+
+    // Leave the current mode
+    if (panelMode == PanelMode::Partial)
+    {
+        amoled.setPartialMode(false);
+        FlushCoalescer::getInstance().setClip(nullptr);
+        // Nothing outside the band was drawn while it was dark
+        lv_obj_invalidate(lv_scr_act());
+    }
+    else if (panelMode == PanelMode::Idle)
+    {
+        amoled.setIdleMode(false);
+    }
+
+    // Enter the new one
+    if (mode == PanelMode::Partial)
+    {
+        amoled.setPartialArea(firstLine, lastLine);
+        amoled.setPartialMode(true);
+        FlushCoalescer::getInstance().setClip(&band);
+        partialBand = band;
+        Serial.printf("Display: Panel partial, lines %u-%u (%d,%d - %d,%d)\n", firstLine, lastLine, band.x1,
+                      band.y1, band.x2, band.y2);
+    }
+    else
+    {
+        if (mode == PanelMode::Idle)
+        {
+            amoled.setIdleMode(true);
+        }
+        Serial.printf("Display: Panel %s\n", panelModeName(mode));
+    }
+    PowerEstimator::getInstance().setView(mode == PanelMode::Partial ? &band : nullptr, mode == PanelMode::Idle);
+
+    // Parked, the changes are few and slow: draw them together
+    if (disp && disp->refr_timer && defaultRefreshMs)
+    {
+        lv_timer_set_period(disp->refr_timer, mode == PanelMode::Full ? defaultRefreshMs : PARKED_REFRESH_MS);
+    }
+
+    panelMode = mode;
+    panelStats[(int)mode].entries++;
+    return true;
+}
+
+void Display::requestPanelMode(PanelMode mode)
+{
+    requestedPanelMode = (uint8_t)mode;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+void Display::updatePanelMode(Activity activity)
+{
+    uint32_t now = millis();
+    accountPanelMode(now);
+
+    uint8_t pending = requestedPanelMode;
+    if (pending != NO_REQUEST)
+    {
+        requestedPanelMode = NO_REQUEST;
+        panelAuto = pending == (uint8_t)PanelMode::Count;
+        if (panelAuto)
+        {
+            Serial.println("Display: Panel mode automatic");
+        }
+        else if (!setPanelMode((PanelMode)pending))
+        {
+            Serial.println("Display: This page has no parked area, panel stays as it is");
+        }
+    }
+
+    if (activity != Activity::Parked)
+    {
+        parkedSince = 0;
+    }
+    else if (parkedSince == 0)
+    {
+        parkedSince = now;
+    }
+
+    if (!panelAuto)
+    {
+        return;
+    }
+
+    // Deeper the longer the bike stands; anything else wakes the panel at once
+    uint32_t parked = parkedSince ? now - parkedSince : 0;
+    PanelMode target = PanelMode::Full;
+    if (parkedSince != 0 && parked >= PARTIAL_AFTER_MS)
+    {
+        target = PanelMode::Partial;
+    }
+    else if (parkedSince != 0 && parked >= IDLE_AFTER_MS)
+    {
+        target = PanelMode::Idle;
+    }
+
+    if (target != panelMode && !setPanelMode(target))
+    {
+        // No parked area on this page
+        setPanelMode(PanelMode::Idle);
+    }
+}
+
+void Display::printPanelModes()
+{
+    // Runs on the loop task: leave the display task's accounting alone and add the
+    // still-open interval to a copy instead.
+    uint32_t now = millis();
+    PanelMode mode = panelMode;
+    uint32_t since = lastAccount;
+    PanelModeStats stats[(int)PanelMode::Count];
+    memcpy(stats, panelStats, sizeof(stats));
+    if (since != 0)
+    {
+        uint32_t elapsed = now - since;
+        stats[(int)mode].timeMs += elapsed;
+        stats[(int)mode].energyMj += PowerEstimator::getInstance().estimateMw() * elapsed / 1000.0;
+    }
+
+    Serial.printf("[Panel] %s (%s), parked %lu s\n", panelModeName(mode), panelAuto ? "auto" : "held",
+                  (unsigned long)(parkedSince ? (now - parkedSince) / 1000 : 0));
+    if (mode == PanelMode::Partial)
+    {
+        Serial.printf("[Panel] Lit %d,%d - %d,%d\n", partialBand.x1, partialBand.y1, partialBand.x2,
+                      partialBand.y2);
+    }
+    Serial.println("[Panel] mode      entries   time s   avg mW");
+    for (int i = 0; i < (int)PanelMode::Count; i++)
+    {
+        const PanelModeStats &s = stats[i];
+        float avgMw = s.timeMs ? s.energyMj * 1000.0 / s.timeMs : 0.0f;
+        Serial.printf("[Panel] %-8s  %7lu  %7lu  %7.0f\n", panelModeName((PanelMode)i), (unsigned long)s.entries,
+                      (unsigned long)(s.timeMs / 1000), avgMw);
+    }
 }
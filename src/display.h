@@ -3,6 +3,18 @@
 #include <LilyGo_AMOLED.h>
 #include "ui/lvgl/LV_Helper.h"
 #include "ui/PageManager.h"
+#include "ui/FrameScheduler.h"
+
+/**
+ * Panel power states, lightest first.
+ */
+enum class PanelMode : uint8_t
+{
+    Full,    // Whole panel in full color
+    Idle,    // Whole panel in 8 colors (top bit of each channel)
+    Partial, // Only the current page's parked area is scanned, the rest is black
+    Count
+};
 
 /**
  * Display class - handles hardware initialization and delegates UI to PageManager.
@@ -10,9 +22,47 @@
  */
 class Display
 {
+public:
+    /**
+     * Time and estimated panel energy spent in one panel mode.
+     */
+    struct PanelModeStats
+    {
+        uint32_t entries = 0;
+        uint64_t timeMs = 0;
+        double energyMj = 0.0;
+    };
+
 private:
     LilyGo_AMOLED amoled;
 
+    // Parked this long (after FrameScheduler's own parked delay) before
+    // the panel goes to idle colors, then to the parked area only
+    static constexpr uint32_t IDLE_AFTER_MS = 30000;
+    static constexpr uint32_t PARTIAL_AFTER_MS = 120000;
+    // LVGL refresh period in Idle and Partial: changes go out together once a second
+    static constexpr uint32_t PARKED_REFRESH_MS = 1000;
+
+    static constexpr uint8_t NO_REQUEST = 0xFF;
+    static volatile uint8_t requestedPanelMode; // A PanelMode, Count = automatic
+
+    PanelMode panelMode = PanelMode::Full;
+    bool panelAuto = true;
+    uint32_t parkedSince = 0; // millis() the display task first saw Parked (0 = not parked)
+    uint32_t lastAccount = 0;
+    uint32_t defaultRefreshMs = 0;
+    lv_area_t partialBand;
+    PanelModeStats panelStats[(int)PanelMode::Count];
+
+    /**
+     * The current page's parked area widened to whole panel scan lines, and
+     * those scan lines.
+     * @return false if the page has no parked area
+     */
+    bool getPartialBand(lv_area_t &band, uint16_t &firstLine, uint16_t &lastLine);
+
+    void accountPanelMode(uint32_t now);
+
 public:
     Display();
 
@@ -33,6 +83,39 @@ public:
      */
     void setBrightness(uint8_t brightness);
 
+    /**
+     * Put the panel in a power state, with its LVGL invalidation policy:
+     *   Full    - every change is drawn at the activity's frame rate
+     *   Idle    - changes are drawn together every PARKED_REFRESH_MS
+     *   Partial - as Idle, and only what falls inside the lit band is drawn;
+     *             the whole screen is redrawn when leaving it
+     * Display task only.
+     * @return false if Partial was asked for and the page has no parked area
+     */
+    bool setPanelMode(PanelMode mode);
+    PanelMode getPanelMode() const { return panelMode; }
+    static const char *panelModeName(PanelMode mode);
+
+    /**
+     * Follow the activity: Full unless parked, then Idle after IDLE_AFTER_MS
+     * and Partial after PARTIAL_AFTER_MS (Idle on pages without a parked
+     * area). Applies serial requests. Call from the display task every pass.
+     */
+    void updatePanelMode(Activity activity);
+
+    /**
+     * Ask for a panel mode from any task; PanelMode::Count goes back to
+     * automatic. Applied by updatePanelMode().
+     */
+    static void requestPanelMode(PanelMode mode);
+
+    const PanelModeStats &getPanelModeStats(PanelMode mode) const { return panelStats[(int)mode]; }
+
+    /**
+     * Print the current mode and time and estimated panel power per mode.
+     */
+    void printPanelModes();
+
     /**
      * Get reference to the AMOLED object (if needed for advanced features).
      */
@@ -1,6 +1,22 @@
 #include <Arduino.h>
 #include "display.h"
 #include "sensors/GPS.h"
+#include "ui/FrameScheduler.h"
+#include "ui/FrameProfiler.h"
+#include "ui/TearSync.h"
+#include "ui/FlushCoalescer.h"
+#include "ui/PowerEstimator.h"
+#include "ui/RenderBench.h"
+#include "ui/Binding.h"
+#include "ui/Theme.h"
+#include "ui/MemoryReport.h"
+#include "ui/FontResidency.h"
+#include "ui/Assets.h"
+#include "ui/SdfFont.h"
+#include "ui/StaticLayer.h"
+#include "ui/RenderGovernor.h"
+#include "ui/DrawUnit.h"
+#include "ui/pages/GForcePage.h"
 
 // Deep sleep configuration
 #define BOOT_BUTTON_PIN 0
@@ -36,6 +52,7 @@ bool lastCapButtonState = true; // Pull-up, so HIGH when not pressed
 // Function prototypes
 void enterDeepSleep();
 void checkWakeupReason();
+void handleSerialCommand(const char *command);
 
 // ============================================================================
 // DISPLAY TASK - Runs on Core 1 (main core)
@@ -45,28 +62,45 @@ void displayTask(void *parameter)
 {
     Serial.println("[Core 1] Display task started");
 
-    const TickType_t targetInterval = pdMS_TO_TICKS(5); // 5ms target interval
-    TickType_t lastWakeTime = xTaskGetTickCount();
+    FrameScheduler &scheduler = FrameScheduler::getInstance();
+    scheduler.begin();
+    RenderGovernor::getInstance().begin();
+#if FRAME_PROFILER
+    FrameProfiler::getInstance().begin();
+#endif
 
     for (;;)
     {
-        TickType_t startTime = xTaskGetTickCount();
+        // Update the current page first so LVGL renders the new values this pass
+        {
+            PROFILE_SCOPE(Stage::Update);
+            display.updatePanelMode(scheduler.getActivity());
+            display.update();
+        }
 
-        // Call LVGL task handler for UI responsiveness
-        lv_task_handler();
+        // Resolve layout up front so it is timed separately from drawing
+        {
+            PROFILE_SCOPE(Stage::Layout);
+            lv_obj_update_layout(lv_scr_act());
+        }
 
-        // Update the current page (for any dynamic content)
-        display.update();
+        // Run LVGL timers (refresh, animations, input) - returns ms until the next is due
+        uint32_t lvglDue = lv_timer_handler();
 
-        // Calculate elapsed time and delay only if needed
-        TickType_t elapsedTime = xTaskGetTickCount() - startTime;
+        // Build pages coming into range / release far ones, never mid-swipe
+        if (scheduler.getActivity() != Activity::Swipe)
+        {
+            PageManager::getInstance().idleWork();
+            RenderBench::runPending();
+        }
 
-        if (elapsedTime < targetInterval)
+        // Sleep until new data, input, an LVGL timer or a page tick is due
         {
-            // Only delay for remaining time if we finished early
-            vTaskDelay(targetInterval - elapsedTime);
+            PROFILE_SCOPE(Stage::Idle);
+            scheduler.waitForWork(lvglDue);
         }
-        // If processing took >= 5ms, continue immediately (no extra delay)
+
+        PROFILE_END_FRAME();
     }
 }
 
@@ -102,6 +136,7 @@ void sensorTask(void *parameter)
     for (;;)
     {
         uint32_t now = millis();
+        DrawUnit::getInstance().markSensorPass();
 
         // Monitor GPIO15 level for sleep trigger
         if (now - lastCapButtonCheck >= capButtonCheckInterval)
@@ -172,7 +207,11 @@ void sensorTask(void *parameter)
         }
 
         // Process GPS data (this also reads from Serial1)
-        gps.loop();
+        // Wake the display task only when a new sentence actually arrived
+        if (gps.loop())
+        {
+            FrameScheduler::getInstance().publish(gps.hasFix() ? gps.getSpeedMph() : 0.0f);
+        }
 
         // Get NMEA character count from GPS class for debugging
         nmeaCharCount = gps.getCharsProcessed();
@@ -274,6 +313,227 @@ void sensorTask(void *parameter)
     }
 }
 
+// ============================================================================
+// SERIAL COMMANDS
+// Line based debug commands typed into the serial monitor
+// ============================================================================
+void handleSerialCommand(const char *command)
+{
+    if (strcmp(command, "prof") == 0)
+    {
+#if FRAME_PROFILER
+        FrameProfiler::getInstance().dump();
+#else
+        Serial.println("Profiler not compiled in (FRAME_PROFILER=0)");
+#endif
+    }
+#if FRAME_PROFILER
+    else if (strcmp(command, "prof reset") == 0)
+    {
+        FrameProfiler::getInstance().requestReset();
+    }
+    else if (strcmp(command, "prof on") == 0 || strcmp(command, "prof off") == 0)
+    {
+        bool on = strcmp(command, "prof on") == 0;
+        FrameProfiler::getInstance().setEnabled(on);
+        Serial.printf("[Profiler] %s\n", on ? "Enabled" : "Disabled");
+    }
+#endif
+    else if (strcmp(command, "frames") == 0)
+    {
+        FrameScheduler::getInstance().requestStats();
+        Serial.printf("[Bindings] %lu label updates applied, %lu skipped as unchanged\n",
+                      (unsigned long)LabelBinding::getAppliedCount(), (unsigned long)LabelBinding::getSkippedCount());
+    }
+    else if (strcmp(command, "gforce reset") == 0)
+    {
+        GForcePage::requestPeakReset();
+        Serial.println("[GForce] Peaks reset");
+    }
+    else if (strcmp(command, "pages") == 0)
+    {
+        PageManager::getInstance().printStats();
+    }
+    else if (strncmp(command, "page ", 5) == 0)
+    {
+        Page *page = PageManager::getInstance().findPage(command + 5);
+        if (page != nullptr)
+        {
+            page->printStats();
+        }
+        else
+        {
+            Serial.printf("No page '%s'\n", command + 5);
+        }
+    }
+    else if (strcmp(command, "swipe live") == 0 || strcmp(command, "swipe snapshot") == 0)
+    {
+        bool snapshots = strcmp(command, "swipe snapshot") == 0;
+        PageManager::getInstance().setSnapshotTransitions(snapshots);
+        Serial.printf("PageManager: Swipes on %s\n", snapshots ? "snapshots" : "live widgets");
+    }
+    else if (strcmp(command, "te") == 0)
+    {
+        TearSync::getInstance().printStats();
+    }
+    else if (strcmp(command, "te reset") == 0)
+    {
+        TearSync::getInstance().requestReset();
+        Serial.println("[TearSync] Reset");
+    }
+    else if (strcmp(command, "te on") == 0 || strcmp(command, "te off") == 0)
+    {
+        bool on = strcmp(command, "te on") == 0;
+        TearSync::getInstance().setEnabled(on);
+        Serial.printf("[TearSync] Pacing %s\n", on ? "enabled" : "disabled");
+    }
+    else if (strcmp(command, "te flip") == 0)
+    {
+        bool reversed = !TearSync::getInstance().isScanReversed();
+        TearSync::getInstance().requestScanReversed(reversed);
+        Serial.printf("[TearSync] Scan direction %s\n", reversed ? "reversed" : "normal");
+    }
+    else if (strcmp(command, "flush") == 0)
+    {
+        FlushCoalescer::getInstance().printStats();
+    }
+    else if (strcmp(command, "flush reset") == 0)
+    {
+        FlushCoalescer::getInstance().requestReset();
+        Serial.println("[Flush] Reset");
+    }
+    else if (strcmp(command, "flush on") == 0 || strcmp(command, "flush off") == 0)
+    {
+        bool on = strcmp(command, "flush on") == 0;
+        FlushCoalescer::getInstance().setEnabled(on);
+        Serial.printf("[Flush] Coalescing %s\n", on ? "enabled" : "disabled");
+    }
+    else if (strcmp(command, "draw") == 0)
+    {
+        DrawUnit::getInstance().print();
+    }
+    else if (strcmp(command, "draw reset") == 0)
+    {
+        DrawUnit::getInstance().requestReset();
+        Serial.println("[Draw] Reset");
+    }
+    else if (strcmp(command, "draw on") == 0 || strcmp(command, "draw off") == 0)
+    {
+        bool on = strcmp(command, "draw on") == 0;
+        DrawUnit::getInstance().setEnabled(on);
+        Serial.printf("[Draw] Second draw unit %s\n", DrawUnit::getInstance().isEnabled() ? "on" : "off");
+    }
+    else if (strcmp(command, "bench") == 0 || strncmp(command, "bench ", 6) == 0)
+    {
+        RenderBench::request(command[5] ? atoi(command + 6) : RenderBench::DEFAULT_FRAMES);
+    }
+    else if (strcmp(command, "layers") == 0)
+    {
+        PageManager::getInstance().printLayers();
+    }
+    else if (strcmp(command, "layers on") == 0 || strcmp(command, "layers off") == 0)
+    {
+        StaticLayer::request(strcmp(command, "layers on") == 0);
+    }
+    else if (strcmp(command, "gov") == 0)
+    {
+        RenderGovernor::getInstance().print();
+    }
+    else if (strcmp(command, "gov on") == 0 || strcmp(command, "gov off") == 0)
+    {
+        RenderGovernor::request(strcmp(command, "gov on") == 0);
+    }
+    else if (strcmp(command, "power") == 0)
+    {
+        PowerEstimator::getInstance().print();
+    }
+    else if (strcmp(command, "power reset") == 0)
+    {
+        PowerEstimator::requestReset();
+        Serial.println("[Power] Reset");
+    }
+    else if (strcmp(command, "power budget off") == 0)
+    {
+        PowerEstimator::requestBudget(0);
+    }
+    else if (strncmp(command, "power budget ", 13) == 0)
+    {
+        int milliwatts = atoi(command + 13);
+        if (milliwatts > 0)
+        {
+            PowerEstimator::requestBudget(milliwatts);
+        }
+        else
+        {
+            Serial.printf("Invalid budget '%s'. Use power budget <mW> or power budget off\n", command + 13);
+        }
+    }
+    else if (strcmp(command, "panel") == 0)
+    {
+        display.printPanelModes();
+    }
+    else if (strcmp(command, "panel full") == 0)
+    {
+        Display::requestPanelMode(PanelMode::Full);
+    }
+    else if (strcmp(command, "panel idle") == 0)
+    {
+        Display::requestPanelMode(PanelMode::Idle);
+    }
+    else if (strcmp(command, "panel partial") == 0)
+    {
+        Display::requestPanelMode(PanelMode::Partial);
+    }
+    else if (strcmp(command, "panel auto") == 0)
+    {
+        Display::requestPanelMode(PanelMode::Count);
+    }
+    else if (strcmp(command, "theme") == 0)
+    {
+        Serial.printf("Theme: %s palette\n", Theme::modeName(Theme::getMode()));
+    }
+    else if (strcmp(command, "theme day") == 0 || strcmp(command, "theme night") == 0)
+    {
+        Theme::requestMode(strcmp(command, "theme night") == 0 ? Theme::Mode::Night : Theme::Mode::Day);
+    }
+    else if (strcmp(command, "mem") == 0)
+    {
+        MemoryReport::print();
+    }
+    else if (strncmp(command, "mem ", 4) == 0)
+    {
+        tiered_placement_t placement;
+        if (MemoryReport::parsePlacement(command + 4, placement))
+        {
+            MemoryReport::setPlacement(placement);
+        }
+        else
+        {
+            Serial.printf("Unknown placement '%s'. Use tiered, psram or internal\n", command + 4);
+        }
+    }
+    else if (strcmp(command, "fonts") == 0)
+    {
+        FontResidency::print();
+    }
+    else if (strcmp(command, "fonts ram") == 0 || strcmp(command, "fonts flash") == 0)
+    {
+        FontResidency::request(strcmp(command, "fonts ram") == 0);
+    }
+    else if (strcmp(command, "assets") == 0)
+    {
+        Assets::print();
+    }
+    else if (strcmp(command, "sdf") == 0)
+    {
+        SdfFont::print();
+    }
+    else if (command[0] != '\0')
+    {
+        Serial.printf("Unknown command '%s'. Commands: prof, prof reset, prof on, prof off, frames, pages, page <name>, gforce reset, swipe live, swipe snapshot, te, te reset, te on, te off, te flip, flush, flush reset, flush on, flush off, draw, draw reset, draw on, draw off, bench [frames], layers, layers on, layers off, gov, gov on, gov off, power, power reset, power budget <mW>, power budget off, panel, panel full, panel idle, panel partial, panel auto, theme, theme day, theme night, mem, mem <placement>, fonts, fonts ram, fonts flash, assets, sdf\n", command);
+    }
+}
+
 // ============================================================================
 // DEEP SLEEP FUNCTIONS
 // ============================================================================
@@ -402,7 +662,25 @@ void setup(void)
 
 void loop()
 {
-    // Main loop is now empty - all work done in dedicated tasks
-    // Just yield to let other tasks run
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    // All real work is done in the dedicated tasks - the main loop only
+    // collects serial debug commands, one per line
+    static char command[32];
+    static size_t length = 0;
+
+    while (Serial.available() > 0)
+    {
+        char c = Serial.read();
+        if (c == '\n' || c == '\r')
+        {
+            command[length] = '\0';
+            handleSerialCommand(command);
+            length = 0;
+        }
+        else if (length < sizeof(command) - 1)
+        {
+            command[length++] = c;
+        }
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(50));
 }
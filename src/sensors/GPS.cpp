@@ -26,19 +26,20 @@ bool GPS::begin()
     return initialized;
 }
 
-void GPS::loop()
+bool GPS::loop()
 {
     if (!initialized)
     {
-        return;
+        return false;
     }
 
-    processIncomingData();
+    return processIncomingData();
 }
 
-void GPS::processIncomingData()
+bool GPS::processIncomingData()
 {
     bool receivedData = false;
+    bool newSentence = false;
     uint32_t validSentencesBefore = gps.passedChecksum(); // Use total valid sentences, not just fix sentences
 
     while (gpsSerial.available() > 0)
@@ -55,6 +56,7 @@ void GPS::processIncomingData()
         if (gps.encode(c))
         {
             lastDataTime = millis();
+            newSentence = true;
         }
     }
 
@@ -138,6 +140,88 @@ void GPS::processIncomingData()
     {
         moduleDetected = false;
     }
+
+    if (newSentence)
+    {
+        updateMotion();
+    }
+
+    return newSentence;
+}
+
+// ============================================================================
+// DERIVED MOTION
+// Lateral acceleration is speed times the course's rate of change and
+// longitudinal is the change in speed, both taken between consecutive RMC
+// fixes on the module's own timestamps
+// ============================================================================
+void GPS::updateMotion()
+{
+    // Only RMC carries course; nothing else reads it, so its updated flag is ours
+    if (!gps.course.isUpdated())
+    {
+        return;
+    }
+    float courseDeg = gps.course.deg();
+    float speedMps = gps.speed.mps();
+
+    if (!hasFix() || !gps.time.isValid())
+    {
+        haveLastFix = false;
+        motionValid = false;
+        return;
+    }
+
+    uint32_t fixMs = gps.time.hour() * 3600000UL + gps.time.minute() * 60000UL + gps.time.second() * 1000UL +
+                     gps.time.centisecond() * 10UL;
+    uint32_t dtMs = fixMs >= lastFixMs ? fixMs - lastFixMs : fixMs + 86400000UL - lastFixMs;
+    bool consecutive = haveLastFix && dtMs <= MOTION_MAX_GAP_MS;
+    if (consecutive && dtMs < MOTION_MIN_GAP_MS)
+    {
+        // Too close to the last fix to difference; wait for the next one
+        return;
+    }
+
+    if (consecutive)
+    {
+        float dt = dtMs / 1000.0f;
+        float meanMps = (speedMps + lastSpeedMps) * 0.5f;
+        float lateral = 0.0f;
+        if (meanMps >= MOTION_MIN_MPS)
+        {
+            // Course turns clockwise: a rising course is a right turn
+            float turnDeg = courseDeg - lastCourseDeg;
+            turnDeg -= 360.0f * roundf(turnDeg / 360.0f);
+            lateral = meanMps * (turnDeg * (float)M_PI / 180.0f) / dt / GRAVITY;
+        }
+        float longitudinal = (speedMps - lastSpeedMps) / dt / GRAVITY;
+        if (fabsf(lateral) > MOTION_MAX_G || fabsf(longitudinal) > MOTION_MAX_G)
+        {
+            // A speed or course glitch: drop the fix and difference the
+            // next one against the last good one
+            return;
+        }
+        lateralG += (lateral - lateralG) * MOTION_SMOOTHING;
+        longitudinalG += (longitudinal - longitudinalG) * MOTION_SMOOTHING;
+        motionValid = true;
+        motionSamples++;
+    }
+    else
+    {
+        lateralG = 0.0f;
+        longitudinalG = 0.0f;
+        motionValid = false;
+    }
+
+    haveLastFix = true;
+    lastFixMs = fixMs;
+    lastSpeedMps = speedMps;
+    lastCourseDeg = courseDeg;
+}
+
+float GPS::getLeanDeg() const
+{
+    return atanf(lateralG) * 180.0f / (float)M_PI;
 }
 
 GPSStatus GPS::calculateStatus(float hdop)
@@ -72,8 +72,25 @@ private:
     uint32_t lastDebugPrint = 0;
     static constexpr uint32_t DEBUG_INTERVAL_MS = 10000; // Print NMEA stats every 10s
 
+    // Motion derived from consecutive fixes (there is no IMU)
+    static constexpr float MOTION_MIN_MPS = 4.5f;       // Course is noise below ~10 mph
+    static constexpr uint32_t MOTION_MIN_GAP_MS = 100;  // Closer fixes are repeats or out of step
+    static constexpr uint32_t MOTION_MAX_GAP_MS = 2000; // Start over after a longer gap
+    static constexpr float MOTION_MAX_G = 1.5f;         // Beyond what a bike can do: a glitch
+    static constexpr float MOTION_SMOOTHING = 0.5f;     // Share of a new fix in the estimate
+    static constexpr float GRAVITY = 9.80665f;
+    bool haveLastFix = false;
+    uint32_t lastFixMs = 0;     // Fix time, ms since midnight UTC
+    float lastSpeedMps = 0.0f;
+    float lastCourseDeg = 0.0f;
+    float lateralG = 0.0f;
+    float longitudinalG = 0.0f;
+    bool motionValid = false;
+    uint32_t motionSamples = 0;
+
     // Internal methods
-    void processIncomingData();
+    bool processIncomingData();
+    void updateMotion();
     void configureConstellations();
     GPSStatus calculateStatus(float hdop);
 
@@ -90,8 +107,9 @@ public:
     /**
      * Process incoming GPS data.
      * Call this regularly in your main loop to keep GPS data updated.
+     * @return true if at least one complete, valid sentence was decoded
      */
-    void loop();
+    bool loop();
 
     /**
      * Get the current GPS status.
@@ -154,6 +172,36 @@ public:
      */
     bool hasFix();
 
+    /**
+     * Check if the motion estimate follows recent fixes.
+     * @return true once two fixes close together have been seen
+     */
+    bool hasMotion() const { return motionValid && moduleDetected; }
+
+    /**
+     * Get the sideways acceleration from speed times turn rate.
+     * @return Acceleration in g, positive turning right, 0 below ~10 mph
+     */
+    float getLateralG() const { return lateralG; }
+
+    /**
+     * Get the fore-aft acceleration from the change in speed.
+     * @return Acceleration in g, positive speeding up, negative braking
+     */
+    float getLongitudinalG() const { return longitudinalG; }
+
+    /**
+     * Get the number of motion estimates so far, one per fix.
+     * Lets a reader take each estimate once, at the fix rate.
+     */
+    uint32_t getMotionCount() const { return motionSamples; }
+
+    /**
+     * Get the lean angle a balanced bike needs for the lateral acceleration.
+     * @return Degrees from upright, positive leaning right
+     */
+    float getLeanDeg() const;
+
     /**
      * Get the total number of NMEA characters processed.
      * Useful for debugging to confirm data is being received.
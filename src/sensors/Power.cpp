@@ -0,0 +1,39 @@
+#include "Power.h"
+#include "../display.h"
+
+// Display owns the board, and with it the PMU
+extern Display display;
+
+namespace Power
+{
+    uint16_t getBattVoltage()
+    {
+        return display.getAmoled().getBattVoltage();
+    }
+
+    bool isVbusIn()
+    {
+        return display.getAmoled().isVbusIn();
+    }
+
+    int32_t getChargeCurrent()
+    {
+        LilyGo_AMOLED &amoled = display.getAmoled();
+
+        // Check both chips but validate the readings
+        uint16_t syCurrentraw = amoled.SY.getChargeCurrent();
+        uint16_t bqCurrent = amoled.BQ.getChargeCurrent();
+
+        // BQ25896 appears to be the active charging chip on this board
+        // SY6970 returns invalid high values, so prefer BQ25896
+        if (bqCurrent > 0 && bqCurrent <= 1000)
+        {
+            return bqCurrent;
+        }
+        if (syCurrentraw > 0 && syCurrentraw <= 1000)
+        {
+            return syCurrentraw;
+        }
+        return 0; // Both invalid or zero
+    }
+}
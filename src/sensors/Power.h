@@ -0,0 +1,26 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * Battery and charger readings from the board PMU.
+ * Every call is an I2C transaction, so callers should rate limit them.
+ */
+namespace Power
+{
+    /**
+     * Get the battery voltage.
+     * @return Millivolts, or 0 if no battery is present
+     */
+    uint16_t getBattVoltage();
+
+    /**
+     * Check if USB power is connected.
+     */
+    bool isVbusIn();
+
+    /**
+     * Get the charge current from whichever charger chip reports a sane value.
+     * @return Milliamps, 0 if neither reading is valid
+     */
+    int32_t getChargeCurrent();
+}
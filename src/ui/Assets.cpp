@@ -0,0 +1,316 @@
+#include "Assets.h"
+#include <esp_timer.h>
+
+#ifdef HUD_FONT_ASSETS
+#include <esp_idf_version.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+
+lv_font_t RobotoBlack_60;
+lv_font_t RobotoBlack_200;
+#endif
+
+namespace Assets
+{
+    static_assert(sizeof(Header) == 16, "Header layout is shared with pack_assets.py");
+    static_assert(sizeof(Entry) == 32, "Entry layout is shared with pack_assets.py");
+    static_assert(sizeof(FontRecord) == 32, "FontRecord layout is shared with pack_assets.py");
+    static_assert(sizeof(CmapRecord) == 20, "CmapRecord layout is shared with pack_assets.py");
+    static_assert(sizeof(lv_font_fmt_txt_glyph_dsc_t) == 8, "Glyph descriptors are packed for LV_FONT_FMT_TXT_LARGE 0");
+
+    static const uint8_t *blob = nullptr;
+    static bool started = false;
+    static uint32_t partitionAddress = 0;
+    static uint32_t beginUs = 0;
+
+    // Glyph lookups timed per font by print()
+    static constexpr int LOOKUP_ROUNDS = 100;
+    static const char *const LOOKUP_TEXT = "0123456789";
+
+    const uint8_t *find(const char *name, Type type, uint32_t *size)
+    {
+        if (blob == nullptr)
+        {
+            return nullptr;
+        }
+
+        const Header *header = (const Header *)blob;
+        const Entry *entries = (const Entry *)(blob + sizeof(Header));
+        for (uint16_t i = 0; i < header->count; i++)
+        {
+            const Entry &entry = entries[i];
+            if (entry.type == type && strncmp(entry.name, name, sizeof(entry.name)) == 0)
+            {
+                if (size != nullptr)
+                {
+                    *size = entry.size;
+                }
+                return blob + entry.offset;
+            }
+        }
+        return nullptr;
+    }
+
+#ifdef HUD_FONT_ASSETS
+    // Character maps a font record may have
+    static constexpr int MAX_CMAPS = 8;
+
+    /**
+     * RAM side of one asset font: the descriptor structs that hold pointers.
+     * Everything they point at stays in the mapping.
+     */
+    struct FontSlot
+    {
+        const char *name;
+        lv_font_t *font;
+        lv_font_fmt_txt_dsc_t dsc = {};
+        lv_font_fmt_txt_cmap_t cmaps[MAX_CMAPS] = {};
+        lv_font_fmt_txt_kern_classes_t kern = {};
+        lv_font_fmt_txt_glyph_cache_t cache = {};
+    };
+
+    static FontSlot fontSlots[] = {
+        {"RobotoBlack_200", &RobotoBlack_200},
+        {"RobotoBlack_60", &RobotoBlack_60},
+    };
+
+    // Mapping kept for the life of the app
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    static esp_partition_mmap_handle_t mapHandle;
+#define ASSETS_MMAP_DATA ESP_PARTITION_MMAP_DATA
+#else
+    static spi_flash_mmap_handle_t mapHandle;
+#define ASSETS_MMAP_DATA SPI_FLASH_MMAP_DATA
+#endif
+
+    static bool within(uint32_t offset, uint32_t bytes, uint32_t size)
+    {
+        return offset <= size && bytes <= size - offset;
+    }
+
+    static bool validFont(const uint8_t *record, uint32_t size)
+    {
+        if (size < sizeof(FontRecord))
+        {
+            return false;
+        }
+
+        const FontRecord &r = *(const FontRecord *)record;
+        bool valid = (r.bpp == 1 || r.bpp == 2 || r.bpp == 4 || r.bpp == 8) && r.bitmapFormat <= 1 &&
+                     r.cmapCount <= MAX_CMAPS && r.glyphCount > 0 &&
+                     within(r.glyphDsc, r.glyphCount * sizeof(lv_font_fmt_txt_glyph_dsc_t), size) &&
+                     within(r.cmaps, r.cmapCount * sizeof(CmapRecord), size) && r.bitmap < size &&
+                     (r.kern == 0 || within(r.kern, 2 * r.glyphCount + r.kernLeftClasses * r.kernRightClasses, size));
+
+        const CmapRecord *cmaps = (const CmapRecord *)(record + r.cmaps);
+        for (uint16_t i = 0; valid && i < r.cmapCount; i++)
+        {
+            const CmapRecord &c = cmaps[i];
+            uint32_t ofsBytes = c.type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL ? c.listLength : c.listLength * sizeof(uint16_t);
+            valid = (c.unicodeList == 0 || within(c.unicodeList, c.listLength * sizeof(uint16_t), size)) &&
+                    (c.glyphIdOfsList == 0 || within(c.glyphIdOfsList, ofsBytes, size));
+        }
+        return valid;
+    }
+
+    static bool loadFont(FontSlot &slot)
+    {
+        uint32_t size = 0;
+        const uint8_t *record = find(slot.name, Type::Font, &size);
+        if (record == nullptr || !validFont(record, size))
+        {
+            return false;
+        }
+
+        const FontRecord &r = *(const FontRecord *)record;
+        const CmapRecord *cmaps = (const CmapRecord *)(record + r.cmaps);
+        for (uint16_t i = 0; i < r.cmapCount; i++)
+        {
+            lv_font_fmt_txt_cmap_t &cmap = slot.cmaps[i];
+            cmap.range_start = cmaps[i].rangeStart;
+            cmap.range_length = cmaps[i].rangeLength;
+            cmap.glyph_id_start = cmaps[i].glyphIdStart;
+            cmap.list_length = cmaps[i].listLength;
+            cmap.type = (lv_font_fmt_txt_cmap_type_t)cmaps[i].type;
+            cmap.unicode_list = cmaps[i].unicodeList ? (const uint16_t *)(record + cmaps[i].unicodeList) : nullptr;
+            cmap.glyph_id_ofs_list = cmaps[i].glyphIdOfsList ? record + cmaps[i].glyphIdOfsList : nullptr;
+        }
+
+        if (r.kern)
+        {
+            slot.kern.left_class_mapping = record + r.kern;
+            slot.kern.right_class_mapping = record + r.kern + r.glyphCount;
+            slot.kern.class_pair_values = (const int8_t *)(record + r.kern + 2 * r.glyphCount);
+            slot.kern.left_class_cnt = r.kernLeftClasses;
+            slot.kern.right_class_cnt = r.kernRightClasses;
+        }
+
+        lv_font_fmt_txt_dsc_t &dsc = slot.dsc;
+        dsc.glyph_bitmap = record + r.bitmap;
+        dsc.glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)(record + r.glyphDsc);
+        dsc.cmaps = slot.cmaps;
+        dsc.kern_dsc = r.kern ? &slot.kern : nullptr;
+        dsc.kern_scale = r.kernScale;
+        dsc.cmap_num = r.cmapCount;
+        dsc.bpp = r.bpp;
+        dsc.kern_classes = r.kern ? 1 : 0;
+        dsc.bitmap_format = r.bitmapFormat;
+        dsc.cache = &slot.cache;
+
+        lv_font_t &font = *slot.font;
+        font = lv_font_t();
+        font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+        font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+        font.line_height = r.lineHeight;
+        font.base_line = r.baseLine;
+        font.subpx = LV_FONT_SUBPX_NONE;
+        font.underline_position = r.underlinePosition;
+        font.underline_thickness = r.underlineThickness;
+        font.dsc = &slot.dsc;
+        return true;
+    }
+
+    static bool mapPartition()
+    {
+        const esp_partition_t *partition = esp_partition_find_first(
+            ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)PARTITION_SUBTYPE, PARTITION_LABEL);
+        if (partition == nullptr)
+        {
+            Serial.println("Assets: No asset partition, flash boards/partitions_16MB_assets.csv over serial");
+            return false;
+        }
+        partitionAddress = partition->address;
+
+        Header header;
+        if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK || header.magic != MAGIC)
+        {
+            Serial.println("Assets: Partition is empty, upload the blob with -t uploadassets");
+            return false;
+        }
+        if (header.version != VERSION)
+        {
+            Serial.printf("Assets: Blob version %u, this build reads version %u\n", header.version, VERSION);
+            return false;
+        }
+        if (header.size < sizeof(Header) + header.count * sizeof(Entry) || header.size > partition->size)
+        {
+            Serial.println("Assets: Blob header is corrupt");
+            return false;
+        }
+
+        const void *mapped = nullptr;
+        if (esp_partition_mmap(partition, 0, header.size, ASSETS_MMAP_DATA, &mapped, &mapHandle) != ESP_OK)
+        {
+            Serial.println("Assets: Could not map the asset partition");
+            return false;
+        }
+
+        const uint8_t *data = (const uint8_t *)mapped;
+        if (esp_rom_crc32_le(0, data + sizeof(Header), header.size - sizeof(Header)) != header.crc32)
+        {
+            Serial.println("Assets: Blob CRC mismatch, upload it again");
+            esp_partition_munmap(mapHandle);
+            return false;
+        }
+
+        blob = data;
+        return true;
+    }
+#endif
+
+    bool begin()
+    {
+        if (started)
+        {
+            return blob != nullptr;
+        }
+        started = true;
+
+#ifdef HUD_FONT_ASSETS
+        int64_t start = esp_timer_get_time();
+        bool mapped = mapPartition();
+        for (FontSlot &slot : fontSlots)
+        {
+            if (!mapped || !loadFont(slot))
+            {
+                *slot.font = lv_font_montserrat_48;
+                Serial.printf("Assets: %s unavailable, drawing it in Montserrat 48\n", slot.name);
+            }
+        }
+        beginUs = esp_timer_get_time() - start;
+
+        if (mapped)
+        {
+            const Header *header = (const Header *)blob;
+            Serial.printf("Assets: %u assets, %lu bytes mapped from 0x%06lx in %lu us\n", header->count,
+                          (unsigned long)header->size, (unsigned long)partitionAddress, (unsigned long)beginUs);
+        }
+        return mapped;
+#else
+        return false;
+#endif
+    }
+
+    // ============================================================================
+    // REPORT
+    // ============================================================================
+    static void printLookups(const char *name, const lv_font_t *font, const char *source)
+    {
+        uint32_t lookups = 0;
+        int64_t start = esp_timer_get_time();
+        for (int round = 0; round < LOOKUP_ROUNDS; round++)
+        {
+            for (const char *c = LOOKUP_TEXT; *c; c++)
+            {
+                lv_font_glyph_dsc_t glyph;
+                lookups += lv_font_get_glyph_dsc(font, &glyph, *c, 0);
+            }
+        }
+        int64_t dscDone = esp_timer_get_time();
+        for (int round = 0; round < LOOKUP_ROUNDS; round++)
+        {
+            for (const char *c = LOOKUP_TEXT; *c; c++)
+            {
+                lv_font_get_glyph_bitmap(font, *c);
+            }
+        }
+        int64_t end = esp_timer_get_time();
+
+        uint32_t n = LOOKUP_ROUNDS * strlen(LOOKUP_TEXT);
+        Serial.printf("[Assets] %-16s %-6s %lu ns/glyph descriptor, %lu ns/bitmap (%lu of %lu found)\n", name, source,
+                      (unsigned long)((dscDone - start) * 1000 / n), (unsigned long)((end - dscDone) * 1000 / n),
+                      (unsigned long)lookups, (unsigned long)n);
+    }
+
+    void print()
+    {
+        if (blob != nullptr)
+        {
+            const Header *header = (const Header *)blob;
+            const Entry *entries = (const Entry *)(blob + sizeof(Header));
+            Serial.printf("[Assets] Blob v%u at 0x%06lx, %lu bytes, mapped in %lu us\n", header->version,
+                          (unsigned long)partitionAddress, (unsigned long)header->size, (unsigned long)beginUs);
+            for (uint16_t i = 0; i < header->count; i++)
+            {
+                Serial.printf("[Assets] %-20.20s %8lu bytes at +0x%lx\n", entries[i].name,
+                              (unsigned long)entries[i].size, (unsigned long)entries[i].offset);
+            }
+        }
+        else
+        {
+#ifdef HUD_FONT_ASSETS
+            Serial.println("[Assets] No blob mapped, asset fonts drawn in Montserrat 48");
+#else
+            Serial.println("[Assets] Fonts compiled into the app (build with HUD_FONT_ASSETS for the partition)");
+#endif
+        }
+
+#ifndef HUD_SDF_NUMERALS
+        // SDF glyph lookups fill its cache, which belongs to the display task
+        const char *source = blob != nullptr ? "mapped" : "app";
+        printLookups("RobotoBlack_200", &RobotoBlack_200, source);
+        printLookups("RobotoBlack_60", &RobotoBlack_60, source);
+#endif
+        printLookups("montserrat_28", &lv_font_montserrat_28, "app");
+    }
+}
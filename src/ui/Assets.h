@@ -0,0 +1,125 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * Fonts and other assets kept in their own flash partition.
+ *
+ * With HUD_FONT_ASSETS defined the Roboto Black fonts are not compiled into
+ * the app. tools/assets/pack_assets.py packs them into a versioned blob with
+ * an index, which is flashed once into the "assets" partition
+ * (boards/partitions_16MB_assets.csv). At boot the blob is memory-mapped with
+ * esp_partition_mmap() and the font descriptors below are filled in
+ * pointing straight into the mapping; the glyph bitmaps, glyph descriptors
+ * and unicode lists are used in place. Only the descriptor structs that
+ * hold pointers live in RAM.
+ *
+ * A missing or mismatched blob leaves the fonts standing in as Montserrat 48
+ * so the display still comes up.
+ *
+ * Without HUD_FONT_ASSETS the fonts are the compiled-in ones and begin()
+ * does nothing.
+ */
+#if defined(HUD_FONT_ASSETS) && defined(HUD_SDF_NUMERALS)
+#error "HUD_FONT_ASSETS and HUD_SDF_NUMERALS both replace the numeral fonts, pick one"
+#elif defined(HUD_FONT_ASSETS) || defined(HUD_SDF_NUMERALS)
+// Filled in from the asset partition by Assets::begin(), or by SdfFont::begin()
+extern lv_font_t RobotoBlack_60;
+extern lv_font_t RobotoBlack_200;
+#else
+LV_FONT_DECLARE(RobotoBlack_60);
+LV_FONT_DECLARE(RobotoBlack_200);
+#endif
+
+namespace Assets
+{
+    // Blob layout version, bumped with any change to the records below
+    constexpr uint16_t VERSION = 1;
+    constexpr uint32_t MAGIC = 0x41445548; // "HUDA"
+
+    // Custom data partition subtype and label of the asset partition
+    constexpr uint8_t PARTITION_SUBTYPE = 0x40;
+    constexpr const char *PARTITION_LABEL = "assets";
+
+    enum class Type : uint32_t
+    {
+        Font = 1, // LVGL fmt_txt font, see FontRecord
+    };
+
+    /**
+     * Blob header, at offset 0. The CRC covers everything after it.
+     */
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t count; // Index entries following the header
+        uint32_t size;  // Whole blob, header included
+        uint32_t crc32;
+    };
+
+    /**
+     * One index entry. Offsets count from the start of the blob.
+     */
+    struct Entry
+    {
+        char name[20];
+        Type type;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    /**
+     * Font record. Offsets count from the start of the record; the glyph
+     * descriptors are stored in lv_font_fmt_txt_glyph_dsc_t layout.
+     */
+    struct FontRecord
+    {
+        uint16_t lineHeight;
+        int16_t baseLine;
+        int8_t underlinePosition;
+        uint8_t underlineThickness;
+        uint8_t bpp;
+        uint8_t bitmapFormat;
+        uint16_t kernScale;
+        uint16_t cmapCount;
+        uint16_t glyphCount; // Including the reserved id 0
+        uint8_t kernLeftClasses;
+        uint8_t kernRightClasses;
+        uint32_t glyphDsc;
+        uint32_t cmaps;  // CmapRecord[cmapCount]
+        uint32_t kern;   // Left map, right map (glyphCount bytes each), class values; 0 = none
+        uint32_t bitmap;
+    };
+
+    struct CmapRecord
+    {
+        uint32_t rangeStart;
+        uint16_t rangeLength;
+        uint16_t glyphIdStart;
+        uint16_t listLength;
+        uint8_t type;
+        uint8_t reserved;
+        uint32_t unicodeList;   // Offset in the font record, 0 = none
+        uint32_t glyphIdOfsList; // Offset in the font record, 0 = none
+    };
+
+    /**
+     * Map the asset partition and fill in the asset fonts. Call once after
+     * lv_init(), before anything uses the fonts.
+     * @return false if the blob is missing or invalid
+     */
+    bool begin();
+
+    /**
+     * Find an asset by name.
+     * @return pointer into the mapping, or nullptr
+     */
+    const uint8_t *find(const char *name, Type type, uint32_t *size = nullptr);
+
+    /**
+     * Print the blob's contents and glyph lookup times of the asset fonts
+     * next to a font compiled into the app.
+     */
+    void print();
+}
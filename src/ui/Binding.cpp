@@ -0,0 +1,129 @@
+#include "Binding.h"
+#include "FrameScheduler.h"
+#include <stdarg.h>
+
+uint32_t LabelBinding::appliedCount = 0;
+uint32_t LabelBinding::skippedCount = 0;
+
+// ============================================================================
+// LABEL TEXT
+// ============================================================================
+void LabelText::set(const char *str)
+{
+    strncpy(text, str, MAX_LENGTH - 1);
+    text[MAX_LENGTH - 1] = '\0';
+}
+
+void LabelText::format(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, MAX_LENGTH, fmt, args);
+    va_end(args);
+}
+
+// ============================================================================
+// LABEL BINDING
+// ============================================================================
+void LabelBinding::attach(lv_obj_t *labelObj, uint32_t interval)
+{
+    label = labelObj;
+    minIntervalMs = interval;
+    invalidate();
+}
+
+void LabelBinding::detach()
+{
+    label = nullptr;
+    invalidate();
+}
+
+bool LabelBinding::due()
+{
+    if (minIntervalMs == 0 || !hasText)
+    {
+        return true;
+    }
+
+    uint32_t elapsed = millis() - lastChange;
+    if (elapsed >= minIntervalMs)
+    {
+        return true;
+    }
+
+    // Come back when the rate limit expires so the pending change shows
+    FrameScheduler::getInstance().requestUpdate(minIntervalMs - elapsed);
+    return false;
+}
+
+bool LabelBinding::apply(const LabelText &next)
+{
+    if (label == nullptr)
+    {
+        return false;
+    }
+
+    bool changed = false;
+
+    if (!hasText || strcmp(shown.text, next.text) != 0)
+    {
+        memcpy(shown.text, next.text, sizeof(shown.text));
+        // The label points at our buffer, so LVGL never reallocates the text
+        lv_label_set_text_static(label, shown.text);
+        hasText = true;
+        changed = true;
+    }
+
+    if (next.hasTone && setTone(next.tone))
+    {
+        changed = true;
+    }
+
+    if (changed)
+    {
+        lastChange = millis();
+        appliedCount++;
+    }
+    else
+    {
+        skippedCount++;
+    }
+    return changed;
+}
+
+bool LabelBinding::setText(const char *text)
+{
+    LabelText next;
+    next.set(text);
+    return apply(next);
+}
+
+bool LabelBinding::format(const char *fmt, ...)
+{
+    LabelText next;
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(next.text, LabelText::MAX_LENGTH, fmt, args);
+    va_end(args);
+    return apply(next);
+}
+
+bool LabelBinding::setTone(Theme::Tone tone)
+{
+    if (label == nullptr || (hasTone && shown.tone == tone))
+    {
+        return false;
+    }
+
+    // Swaps the label's shared theme style, so no local color is stored
+    Theme::setTone(label, tone);
+    shown.tone = tone;
+    hasTone = true;
+    return true;
+}
+
+void LabelBinding::invalidate()
+{
+    hasText = false;
+    hasTone = false;
+}
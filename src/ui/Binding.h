@@ -0,0 +1,200 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "Theme.h"
+
+/**
+ * Value-to-label bindings with change detection.
+ *
+ * Pages push fresh values every update; a binding only formats when the
+ * value changed and only calls into LVGL when the formatted text or tone
+ * differs from what the label already shows. Each binding keeps its own
+ * text buffer and hands it to the label with lv_label_set_text_static(),
+ * so updates don't reallocate the label text either.
+ *
+ * Usage:
+ *   BoundLabel<int32_t> sats;
+ *   sats.bind(satsLabel, [](const int32_t &v, LabelText &out) {
+ *       out.format("Sats. %ld", v);
+ *   });
+ *   ...
+ *   sats.set(gps.getSatelliteCount()); // from update()
+ */
+
+/**
+ * A typed value that remembers whether it changed.
+ */
+template <typename T>
+class Observable
+{
+private:
+    T value{};
+    uint32_t version = 0; // Bumped on every change, 0 = never set
+
+public:
+    /**
+     * Store a new value.
+     * @return true if it differs from the previous one
+     */
+    bool set(const T &newValue)
+    {
+        if (version != 0 && newValue == value)
+        {
+            return false;
+        }
+        value = newValue;
+        version++;
+        return true;
+    }
+
+    const T &get() const { return value; }
+    uint32_t getVersion() const { return version; }
+    bool hasValue() const { return version != 0; }
+};
+
+/**
+ * Output of a formatter: label text plus an optional theme tone.
+ */
+struct LabelText
+{
+    static constexpr size_t MAX_LENGTH = 48;
+
+    char text[MAX_LENGTH] = "";
+    Theme::Tone tone = Theme::Tone::Primary;
+    bool hasTone = false;
+
+    void set(const char *str);
+    void format(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    void setTone(Theme::Tone t)
+    {
+        tone = t;
+        hasTone = true;
+    }
+};
+
+/**
+ * Owns what one label shows and skips LVGL calls that wouldn't change it.
+ * Optionally limits how often the label may change (minIntervalMs).
+ */
+class LabelBinding
+{
+private:
+    lv_obj_t *label = nullptr;
+    LabelText shown;           // Text/tone currently on the label
+    bool hasText = false;      // Label shows our buffer
+    bool hasTone = false;      // Label tone was set by us
+    uint32_t minIntervalMs = 0;
+    uint32_t lastChange = 0;
+
+    // Counters for the binding stats
+    static uint32_t appliedCount;
+    static uint32_t skippedCount;
+
+public:
+    /**
+     * Attach to a label. minIntervalMs = 0 means no rate limit.
+     */
+    void attach(lv_obj_t *labelObj, uint32_t minIntervalMs = 0);
+
+    /**
+     * Let go of the label (it is about to be deleted).
+     * Later updates are ignored until attach() is called again.
+     */
+    void detach();
+
+    /**
+     * True when the rate limit allows the label to change now.
+     * If not, asks the frame scheduler to come back when it does.
+     */
+    bool due();
+
+    /**
+     * Show the given text/tone, touching LVGL only for what differs.
+     * @return true if the label changed
+     */
+    bool apply(const LabelText &next);
+
+    /**
+     * Convenience wrappers around apply().
+     */
+    bool setText(const char *text);
+    bool format(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+    bool setTone(Theme::Tone tone);
+
+    /**
+     * Forget the cached state so the next apply() always writes.
+     */
+    void invalidate();
+
+    lv_obj_t *getLabel() const { return label; }
+
+    static uint32_t getAppliedCount() { return appliedCount; }
+    static uint32_t getSkippedCount() { return skippedCount; }
+};
+
+/**
+ * Observable value bound to a label through a formatter.
+ */
+template <typename T>
+class BoundLabel
+{
+public:
+    using Formatter = void (*)(const T &value, LabelText &out);
+
+private:
+    Observable<T> value;
+    LabelBinding binding;
+    Formatter formatter = nullptr;
+    uint32_t shownVersion = 0; // Version of value last formatted onto the label
+
+public:
+    /**
+     * Attach to a label with a formatter and optional rate limit.
+     */
+    void bind(lv_obj_t *label, Formatter fmt, uint32_t minIntervalMs = 0)
+    {
+        binding.attach(label, minIntervalMs);
+        formatter = fmt;
+        shownVersion = 0;
+    }
+
+    /**
+     * Let go of the label; the value keeps updating and is shown again
+     * after the next bind().
+     */
+    void unbind()
+    {
+        binding.detach();
+        formatter = nullptr;
+    }
+
+    /**
+     * Push a value. Formats only if it changed since it was last shown
+     * (or a rate-limited change is still pending) and the label is due.
+     */
+    void set(const T &newValue)
+    {
+        value.set(newValue);
+        if (formatter == nullptr || value.getVersion() == shownVersion || !binding.due())
+        {
+            return;
+        }
+
+        LabelText out;
+        formatter(value.get(), out);
+        binding.apply(out);
+        shownVersion = value.getVersion();
+    }
+
+    /**
+     * Re-format the current value on the next set(), e.g. after the
+     * label was recreated or restyled elsewhere.
+     */
+    void invalidate()
+    {
+        shownVersion = 0;
+        binding.invalidate();
+    }
+
+    const T &get() const { return value.get(); }
+};
@@ -0,0 +1,316 @@
+#include "DrawUnit.h"
+#include "PageManager.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#ifdef HUD_DUAL_CORE_DRAW
+static constexpr bool ON_AT_BOOT = true;
+#else
+static constexpr bool ON_AT_BOOT = false;
+#endif
+
+// Singleton instance
+DrawUnit *DrawUnit::instance = nullptr;
+
+DrawUnit &DrawUnit::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new DrawUnit();
+    }
+    return *instance;
+}
+
+bool DrawUnit::begin()
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == nullptr || disp->driver->draw_ctx == nullptr)
+    {
+        Serial.println("DrawUnit: No display registered");
+        return false;
+    }
+
+    scratch = (lv_color_t *)heap_caps_malloc(SLICE_PIXELS * sizeof(lv_color_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (scratch == nullptr)
+    {
+        Serial.println("DrawUnit: No scratch buffer, drawing on one core");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(workerTask, "DrawUnit", STACK_BYTES, nullptr, PRIORITY, &worker, CORE) != pdPASS)
+    {
+        worker = nullptr;
+        Serial.println("DrawUnit: No worker task, drawing on one core");
+        return false;
+    }
+
+    lv_draw_sw_ctx_t *ctx = (lv_draw_sw_ctx_t *)disp->driver->draw_ctx;
+    originalBlend = ctx->blend;
+    ctx->blend = blendHook;
+    setEnabled(ON_AT_BOOT);
+
+    Serial.printf("DrawUnit: Worker on core %d, blends of %lu+ px shared %s\n", CORE,
+                  (unsigned long)MIN_SPLIT_PIXELS, enabled ? "from now" : "after \"draw on\"");
+    return true;
+}
+
+// ============================================================================
+// SLICING
+// ============================================================================
+bool DrawUnit::claimSlice(uint32_t gen, uint16_t index, SliceState from, SliceState to)
+{
+    uint32_t expected = tag(gen, from);
+    return sliceState[index].compare_exchange_strong(expected, tag(gen, to), std::memory_order_acq_rel,
+                                                     std::memory_order_acquire);
+}
+
+void DrawUnit::sliceArea(const Job &j, uint16_t index, lv_area_t &slice)
+{
+    slice.x1 = j.area.x1;
+    slice.x2 = j.area.x2;
+    slice.y1 = j.area.y1 + index * j.rows;
+    slice.y2 = LV_MIN(slice.y1 + j.rows - 1, j.area.y2);
+}
+
+void DrawUnit::drawSlice(const Job &j, const lv_area_t &slice, lv_color_t *buf, const lv_area_t &bufArea)
+{
+    // Same descriptor, drawn into `buf` and clipped to the slice's rows
+    lv_area_t area = bufArea;
+    lv_draw_sw_ctx_t ctx = j.ctx;
+    ctx.base_draw.buf = buf;
+    ctx.base_draw.buf_area = &area;
+    ctx.base_draw.clip_area = &slice;
+    lv_draw_sw_blend_dsc_t dsc = j.dsc;
+    dsc.blend_area = &j.blendArea;
+    dsc.mask_area = j.dsc.mask_area ? &j.maskArea : nullptr;
+    originalBlend(&ctx.base_draw, &dsc);
+}
+
+void DrawUnit::shareJob()
+{
+    uint32_t gen = open.load(std::memory_order_acquire);
+    if (gen == 0)
+    {
+        return;
+    }
+    Job j = job;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (open.load(std::memory_order_relaxed) != gen)
+    {
+        // Core 1 moved on while this copied the job
+        return;
+    }
+
+    lv_color_t *buf = (lv_color_t *)j.ctx.base_draw.buf;
+    lv_coord_t stride = lv_area_get_width(&j.bufArea);
+
+    // Up from the last slice until meeting core 1
+    for (int i = j.slices - 1; i >= 0 && claimSlice(gen, i, Free, Core0); i--)
+    {
+        lv_area_t slice;
+        sliceArea(j, i, slice);
+        lv_coord_t width = lv_area_get_width(&slice);
+        lv_coord_t height = lv_area_get_height(&slice);
+        lv_color_t *rows = buf + (slice.y1 - j.bufArea.y1) * stride + (slice.x1 - j.bufArea.x1);
+
+        // Start from what is under the slice, as the blend mixes with it
+        for (lv_coord_t y = 0; y < height; y++)
+        {
+            memcpy(scratch + y * width, rows + y * stride, width * sizeof(lv_color_t));
+        }
+        drawSlice(j, slice, scratch, slice);
+
+        // Copy it in unless core 1 took it back. Nothing on this core runs
+        // in between, so core 1 waits on the copy and never on a preemption
+        vTaskSuspendAll();
+        bool mine = claimSlice(gen, i, Core0, Committing);
+        if (mine)
+        {
+            for (lv_coord_t y = 0; y < height; y++)
+            {
+                memcpy(rows + y * stride, scratch + y * width, width * sizeof(lv_color_t));
+            }
+            workerSlices++;
+            sliceState[i].store(tag(gen, Done), std::memory_order_release);
+        }
+        xTaskResumeAll();
+        if (!mine)
+        {
+            return;
+        }
+
+        // Time box: sensor work that got ready runs before the next slice
+        taskYIELD();
+    }
+}
+
+void DrawUnit::workerTask(void * /*parameter*/)
+{
+    DrawUnit &self = *instance;
+    for (;;)
+    {
+        // A late wakeup finds the job closed or taken and goes back to sleep
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self.shareJob();
+    }
+}
+
+void DrawUnit::blendHook(lv_draw_ctx_t *ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    DrawUnit &self = *instance;
+
+    // No job is open here, so core 0 is done with workerSlices
+    if (self.resetRequested)
+    {
+        self.resetRequested = false;
+        self.stats = Stats();
+        self.workerSlices = 0;
+    }
+    self.stats.blends++;
+
+    lv_area_t area;
+    lv_disp_drv_t *driver = _lv_refr_get_disp_refreshing()->driver;
+    if (!self.enabled || dsc->opa <= LV_OPA_MIN || !_lv_area_intersect(&area, dsc->blend_area, ctx->clip_area) ||
+        lv_area_get_size(&area) < MIN_SPLIT_PIXELS || lv_area_get_width(&area) > (lv_coord_t)SLICE_PIXELS ||
+        driver->set_px_cb != nullptr || (dsc->mask_buf && driver->antialiasing == 0))
+    {
+        self.originalBlend(ctx, dsc);
+        return;
+    }
+
+    uint32_t rows = SLICE_PIXELS / lv_area_get_width(&area);
+    uint32_t slices = (lv_area_get_height(&area) + rows - 1) / rows;
+    if (slices > MAX_SLICES)
+    {
+        self.originalBlend(ctx, dsc);
+        return;
+    }
+
+    // `open` is 0 since the last job closed; order that before the writes
+    std::atomic_thread_fence(std::memory_order_release);
+    Job &j = self.job;
+    j.ctx = *(lv_draw_sw_ctx_t *)ctx;
+    j.dsc = *dsc;
+    j.bufArea = *ctx->buf_area;
+    j.blendArea = *dsc->blend_area;
+    if (dsc->mask_area)
+    {
+        j.maskArea = *dsc->mask_area;
+    }
+    j.area = area;
+    j.rows = rows;
+    j.slices = slices;
+
+    uint32_t gen = (self.generation + 1) & GENERATION_MASK;
+    self.generation = gen ? gen : 1;
+    gen = self.generation;
+    for (uint32_t i = 0; i < slices; i++)
+    {
+        self.sliceState[i].store(tag(gen, Free), std::memory_order_relaxed);
+    }
+    self.open.store(gen, std::memory_order_release);
+    xTaskNotifyGive(self.worker);
+
+    // Down from the first slice until meeting core 0
+    lv_color_t *buf = (lv_color_t *)ctx->buf;
+    lv_area_t slice;
+    int64_t start = esp_timer_get_time();
+    uint32_t drawn = 0;
+    while (drawn < slices && self.claimSlice(gen, drawn, Free, Core1))
+    {
+        sliceArea(j, drawn, slice);
+        self.drawSlice(j, slice, buf, j.bufArea);
+        drawn++;
+    }
+
+    // The rest is core 0's, at most one of them still in hand. Give it one
+    // slice's time, then take it back
+    int64_t waitStart = esp_timer_get_time();
+    int64_t deadline = waitStart + (drawn ? (waitStart - start) / drawn : 0);
+    for (uint32_t i = drawn; i < slices; i++)
+    {
+        for (;;)
+        {
+            uint32_t state = self.sliceState[i].load(std::memory_order_acquire);
+            if (state == tag(gen, Done))
+            {
+                break;
+            }
+            if (state == tag(gen, Core0) && esp_timer_get_time() >= deadline &&
+                self.claimSlice(gen, i, Core0, Retaken))
+            {
+                sliceArea(j, i, slice);
+                self.drawSlice(j, slice, buf, j.bufArea);
+                self.stats.retaken++;
+                break;
+            }
+        }
+    }
+    self.stats.waitUs += esp_timer_get_time() - waitStart;
+    self.open.store(0, std::memory_order_release);
+
+    self.stats.splits++;
+    self.stats.slices += slices;
+    self.stats.splitPixels += lv_area_get_size(&area);
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+void DrawUnit::markSensorPass()
+{
+    int64_t now = esp_timer_get_time();
+    if (sensorResetRequested)
+    {
+        sensorResetRequested = false;
+        sensorPassUs[0].reset();
+        sensorPassUs[1].reset();
+        lastSensorPass = 0;
+    }
+    if (lastSensorPass != 0)
+    {
+        sensorPassUs[enabled].add(now - lastSensorPass);
+    }
+    lastSensorPass = now;
+}
+
+void DrawUnit::print()
+{
+    float splits = stats.splits ? stats.splits : 1;
+    Serial.printf("[Draw] Second draw unit %s, %lu blends, %lu shared (%.0f px, %.1f slices avg)\n",
+                  worker == nullptr ? "not running" : enabled ? "on" : "off", (unsigned long)stats.blends,
+                  (unsigned long)stats.splits, stats.splitPixels / splits, stats.slices / splits);
+    Serial.printf("[Draw] Core 0 drew %lu of %lu slices (%.0f%%), core 1 took back %lu and waited %.1f us per "
+                  "shared blend\n",
+                  (unsigned long)workerSlices, (unsigned long)stats.slices,
+                  stats.slices ? workerSlices * 100.0f / stats.slices : 0.0f, (unsigned long)stats.retaken,
+                  stats.waitUs / splits);
+
+    for (int on = 0; on < 2; on++)
+    {
+        const Histogram &h = sensorPassUs[on];
+        Serial.printf("[Draw] Sensor pass, unit %-3s n=%lu p50=%lu p99=%lu max=%lu us, jitter %ld us\n",
+                      on ? "on" : "off", (unsigned long)h.count, (unsigned long)h.percentile(50),
+                      (unsigned long)h.percentile(99), (unsigned long)h.maxUs,
+                      (long)(h.count ? h.maxUs - h.percentile(50) : 0));
+    }
+
+    PageManager &pages = PageManager::getInstance();
+    Serial.println("[Draw] page          off avg/p95 us   on avg/p95 us");
+    for (int i = 0; i < PageManager::PAGE_COUNT; i++)
+    {
+        const Histogram *draw = pages.getPageStats(i).drawUnitUs;
+        Serial.printf("[Draw] %-12s  %7lu / %6lu  %6lu / %6lu\n", pages.getPage(i)->getName(),
+                      (unsigned long)draw[0].average(), (unsigned long)draw[0].percentile(95),
+                      (unsigned long)draw[1].average(), (unsigned long)draw[1].percentile(95));
+    }
+#if !FRAME_PROFILER
+    Serial.println("[Draw] (draw times need FRAME_PROFILER)");
+#endif
+}
+
+void DrawUnit::requestReset()
+{
+    resetRequested = true;
+    sensorResetRequested = true;
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <lvgl.h>
+#include <src/draw/sw/lv_draw_sw.h>
+#include "FrameProfiler.h"
+
+/**
+ * A second software draw unit on core 0, sharing the big blends with the
+ * display task on core 1.
+ *
+ * LVGL 8 draws on one task, and nearly all of its time goes into the
+ * software blend: filling and mixing rectangles, glyph masks and images
+ * into the draw buffer. A blend only writes the rows of its own area and
+ * reads its descriptor, so rows can be drawn on both cores at once. Blends
+ * of at least MIN_SPLIT_PIXELS are cut into row slices of about
+ * SLICE_PIXELS and core 0 is woken. Core 1 claims slices from the top and
+ * draws them in place; core 0 claims them from the bottom, draws each into
+ * a scratch buffer and copies it in only if the slice is still its own.
+ * Smaller blends cost less than the handoff and stay on core 1.
+ *
+ * The sensor task owns core 0, and anything else on core 0 can preempt the
+ * worker mid-slice. So once core 1 runs out of free slices it gives core 0
+ * about one slice's time to finish the one in hand, then takes it back and
+ * draws it itself; core 0's late copy is dropped. A slice being copied in
+ * can't be taken back, but the copy runs with core 0's scheduler suspended
+ * and lasts a few microseconds. Core 1 therefore waits at most about one
+ * slice plus a copy per shared blend, however long core 0 is held up.
+ *
+ * The worker runs at the sensor task's priority and yields after every
+ * slice, so sensor work that becomes ready waits at most one slice, a few
+ * tens of microseconds.
+ *
+ * Hooks the SW draw context's blend, so draw_letter and the other draw
+ * hooks see nothing. Blends with antialiasing off round their mask in
+ * place and are never split.
+ *
+ * Built with HUD_DUAL_CORE_DRAW (env T-Display-AMOLED-dualcore) blends are
+ * shared from boot, otherwise after "draw on". "draw on"/"draw off" switch
+ * it for A/B runs; "draw" compares per-page draw time and the sensor loop's
+ * worst pass with it off and on.
+ */
+class DrawUnit
+{
+public:
+    struct Stats
+    {
+        uint32_t blends = 0;        // Blends through the hook
+        uint32_t splits = 0;        // Blends shared between the cores
+        uint32_t slices = 0;        // Slices of the shared blends
+        uint64_t splitPixels = 0;   // Pixels of the shared blends
+        uint64_t waitUs = 0;        // Core 1 waiting on or redrawing core 0's last slice
+        uint32_t retaken = 0;       // Slices core 1 took back from core 0
+    };
+
+private:
+    // Singleton instance
+    static DrawUnit *instance;
+
+    // Private constructor for singleton
+    DrawUnit() = default;
+
+    // Below this the wakeup costs more than the half it saves
+    static constexpr uint32_t MIN_SPLIT_PIXELS = 6144;
+    // Core 0 is back for the sensor task within one slice, and core 1
+    // redraws at most one
+    static constexpr uint32_t SLICE_PIXELS = 2048;
+    static constexpr uint16_t MAX_SLICES = 128;
+    static constexpr uint32_t STACK_BYTES = 3072;
+    static constexpr UBaseType_t PRIORITY = 1; // The sensor task's
+    static constexpr BaseType_t CORE = 0;
+
+    // Slice states, tagged with the job's generation: generation << 4 | state
+    enum SliceState : uint32_t
+    {
+        Free,
+        Core1,      // Drawn in place by core 1
+        Core0,      // Core 0 drawing it into the scratch buffer
+        Committing, // Core 0 copying it in
+        Done,
+        Retaken     // Taken back by core 1; core 0's copy is dropped
+    };
+    static constexpr uint32_t GENERATION_MASK = 0x0FFFFFFF;
+
+    /**
+     * A shared blend. The areas the descriptor and context point at are
+     * copied too, so core 0 running late never follows a pointer into the
+     * stack of a blend that has returned.
+     */
+    struct Job
+    {
+        lv_draw_sw_ctx_t ctx;
+        lv_draw_sw_blend_dsc_t dsc;
+        lv_area_t bufArea;
+        lv_area_t blendArea;
+        lv_area_t maskArea;
+        lv_area_t area; // The blend inside the clip area
+        uint16_t rows;
+        uint16_t slices;
+    };
+
+    TaskHandle_t worker = nullptr;
+    void (*originalBlend)(lv_draw_ctx_t *, const lv_draw_sw_blend_dsc_t *) = nullptr;
+    bool enabled = false;
+
+    // Written by core 1 while `open` is 0 and copied by core 0, which
+    // checks `open` is unchanged after its copy
+    Job job;
+    uint32_t generation = 0;
+    std::atomic<uint32_t> open{0}; // Generation of the shared blend, 0 = none
+    std::atomic<uint32_t> sliceState[MAX_SLICES];
+    lv_color_t *scratch = nullptr; // Core 0 draws here, SLICE_PIXELS
+
+    Stats stats;
+    volatile uint32_t workerSlices = 0; // Slices core 0 drew and copied in
+
+    // Sensor loop pass times with the draw unit off and on
+    Histogram sensorPassUs[2];
+    int64_t lastSensorPass = 0;
+
+    // Reset requests, applied by the task that owns each half of the stats
+    volatile bool resetRequested = false;       // Display task, next blend
+    volatile bool sensorResetRequested = false; // Sensor task, next pass
+
+    static void blendHook(lv_draw_ctx_t *ctx, const lv_draw_sw_blend_dsc_t *dsc);
+    static void workerTask(void * /*parameter*/);
+
+    static uint32_t tag(uint32_t gen, SliceState state) { return gen << 4 | state; }
+    bool claimSlice(uint32_t gen, uint16_t index, SliceState from, SliceState to);
+    static void sliceArea(const Job &j, uint16_t index, lv_area_t &slice);
+
+    /**
+     * Blend slice `slice` of job `j` into `buf`, which covers `bufArea`.
+     */
+    void drawSlice(const Job &j, const lv_area_t &slice, lv_color_t *buf, const lv_area_t &bufArea);
+
+    /**
+     * Core 0's side of the open job, if there is one.
+     */
+    void shareJob();
+
+public:
+    // Get singleton instance
+    static DrawUnit &getInstance();
+
+    // Delete copy constructor and assignment
+    DrawUnit(const DrawUnit &) = delete;
+    DrawUnit &operator=(const DrawUnit &) = delete;
+
+    /**
+     * Start the core 0 worker and hook the default display's blend.
+     * Call once the display is registered, before the sensor task starts.
+     * @return false if there is no display or the worker can't start
+     */
+    bool begin();
+
+    /**
+     * Share blends with core 0 or draw everything on core 1.
+     * Taken up at the next blend.
+     */
+    void setEnabled(bool on) { enabled = on && worker != nullptr; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Called by the sensor task once per pass, to time the pass.
+     */
+    void markSensorPass();
+
+    const Stats &getStats() const { return stats; }
+    uint32_t getWorkerSlices() const { return workerSlices; }
+
+    void print();
+
+    /**
+     * Clear the stats from any task. The blend counts are cleared at the
+     * next blend, the sensor pass times at the next pass.
+     */
+    void requestReset();
+};
@@ -0,0 +1,248 @@
+#include "FlushCoalescer.h"
+#include <esp_timer.h>
+
+// Singleton instance
+FlushCoalescer *FlushCoalescer::instance = nullptr;
+
+FlushCoalescer &FlushCoalescer::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new FlushCoalescer();
+    }
+    return *instance;
+}
+
+bool FlushCoalescer::begin(LilyGo_Display *panel)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == nullptr)
+    {
+        Serial.println("FlushCoalescer: No display, areas flush as invalidated");
+        return false;
+    }
+
+    board = panel;
+
+    // Merge after LVGL's join, chain in front of the panel flush
+    originalRenderStart = disp->driver->render_start_cb;
+    disp->driver->render_start_cb = renderStartHook;
+    originalFlush = disp->driver->flush_cb;
+    disp->driver->flush_cb = flushHook;
+
+    Serial.printf("FlushCoalescer: Merging areas at %.0f us per window, %.1f B/us\n", windowUs, bytesPerUs);
+    return true;
+}
+
+float FlushCoalescer::costUs(const lv_area_t &area) const
+{
+    // RGB565 on the wire, whatever depth LVGL renders at
+    return windowUs + lv_area_get_size(&area) * sizeof(uint16_t) / bytesPerUs;
+}
+
+// ============================================================================
+// MERGING
+// ============================================================================
+uint32_t FlushCoalescer::merge(lv_area_t *areas, uint32_t count)
+{
+    // At most LV_INV_BUF_SIZE areas, and a handful in practice
+    while (count > 1)
+    {
+        float bestSaving = 0.0f;
+        uint32_t bestA = 0;
+        uint32_t bestB = 0;
+        lv_area_t bestBox;
+
+        for (uint32_t a = 0; a < count; a++)
+        {
+            float costA = costUs(areas[a]);
+            for (uint32_t b = a + 1; b < count; b++)
+            {
+                lv_area_t box;
+                _lv_area_join(&box, &areas[a], &areas[b]);
+                float saving = costA + costUs(areas[b]) - costUs(box);
+                if (saving > bestSaving)
+                {
+                    bestSaving = saving;
+                    bestA = a;
+                    bestB = b;
+                    bestBox = box;
+                }
+            }
+        }
+
+        if (bestSaving <= 0.0f)
+        {
+            break;
+        }
+        areas[bestA] = bestBox;
+        areas[bestB] = areas[--count];
+        stats.merges++;
+    }
+    return count;
+}
+
+void FlushCoalescer::renderStartHook(lv_disp_drv_t *drv)
+{
+    FlushCoalescer &self = *instance;
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+
+    if (self.resetRequested)
+    {
+        self.resetRequested = false;
+        self.stats = Stats();
+    }
+
+    lv_area_t areas[LV_INV_BUF_SIZE];
+    uint32_t count = 0;
+    uint32_t clipped = 0;
+    int32_t lastSlot = -1;
+    for (uint32_t i = 0; i < disp->inv_p; i++)
+    {
+        if (disp->inv_area_joined[i])
+        {
+            continue;
+        }
+        lastSlot = i;
+        if (!self.clipping)
+        {
+            areas[count++] = disp->inv_areas[i];
+        }
+        else if (_lv_area_intersect(&areas[count], &disp->inv_areas[i], &self.clipArea))
+        {
+            count++;
+        }
+        else
+        {
+            clipped++;
+        }
+    }
+    self.stats.clipped += clipped;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        self.stats.pixelsIn += lv_area_get_size(&areas[i]);
+        self.stats.modelInUs += self.costUs(areas[i]);
+    }
+    self.stats.windowsIn += count;
+
+    uint32_t merged = self.enabled ? self.merge(areas, count) : count;
+    if (merged < count || self.clipping)
+    {
+        // LVGL found its last area before calling us and flags the flush
+        // at that slot as the end of the frame, so the survivors end there
+        for (uint32_t i = 0; i < disp->inv_p; i++)
+        {
+            disp->inv_area_joined[i] = 1;
+        }
+        // Nothing left inside the clip area: the frame draws nothing
+        for (uint32_t i = 0; i < merged; i++)
+        {
+            uint32_t slot = lastSlot - (merged - 1 - i);
+            disp->inv_areas[slot] = areas[i];
+            disp->inv_area_joined[slot] = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < merged; i++)
+    {
+        self.stats.pixelsOut += lv_area_get_size(&areas[i]);
+        self.stats.modelOutUs += self.costUs(areas[i]);
+    }
+
+    if (self.originalRenderStart)
+    {
+        self.originalRenderStart(drv);
+    }
+}
+
+void FlushCoalescer::setClip(const lv_area_t *area)
+{
+    clipping = area != nullptr;
+    if (clipping)
+    {
+        clipArea = *area;
+    }
+}
+
+// ============================================================================
+// FLUSH HOOK
+// ============================================================================
+void FlushCoalescer::learn(uint32_t bytes, uint32_t elapsedUs)
+{
+    if (bytes >= MIN_LEARN_BYTES && elapsedUs > 2 * windowUs)
+    {
+        float measured = bytes / (elapsedUs - windowUs);
+        bytesPerUs += (measured - bytesPerUs) / 8;
+        bytesPerUs = fminf(fmaxf(bytesPerUs, MIN_BYTES_PER_US), MAX_BYTES_PER_US);
+    }
+    else if (bytes <= MAX_SETUP_BYTES)
+    {
+        float setup = elapsedUs - bytes / bytesPerUs;
+        windowUs += (setup - windowUs) / 8;
+        windowUs = fminf(fmaxf(windowUs, MIN_WINDOW_US), MAX_WINDOW_US);
+    }
+}
+
+void FlushCoalescer::flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    FlushCoalescer &self = *instance;
+
+    // lv_disp_flush_ready() clears this, read it before flushing
+    bool lastOfFrame = lv_disp_flush_is_last(drv);
+
+    if (!self.writing && self.enabled && self.board)
+    {
+        self.board->startWrite();
+        self.writing = true;
+    }
+
+    int64_t start = esp_timer_get_time();
+    self.originalFlush(drv, area, color_p);
+    uint32_t elapsed = esp_timer_get_time() - start;
+
+    self.learn(lv_area_get_size(area) * sizeof(uint16_t), elapsed);
+    self.frameBusUs += elapsed;
+    self.frameWindows++;
+
+    if (lastOfFrame)
+    {
+        if (self.writing)
+        {
+            self.board->endWrite();
+            self.writing = false;
+        }
+
+        self.stats.frames++;
+        self.stats.windowsOut += self.frameWindows;
+        self.stats.busUs.add(self.frameBusUs);
+        if (self.frameWindows > self.stats.maxWindows)
+        {
+            self.stats.maxWindows = self.frameWindows;
+        }
+        self.frameBusUs = 0;
+        self.frameWindows = 0;
+    }
+}
+
+void FlushCoalescer::printStats()
+{
+    const Histogram &h = stats.busUs;
+    float frames = stats.frames ? stats.frames : 1;
+
+    Serial.printf("[Flush] Coalescing %s, model %.0f us per window + %.1f B/us, %lu merges, %lu clipped\n",
+                  enabled ? "on" : "off", windowUs, bytesPerUs, (unsigned long)stats.merges,
+                  (unsigned long)stats.clipped);
+    if (clipping)
+    {
+        Serial.printf("[Flush] Clipped to %d,%d - %d,%d\n", clipArea.x1, clipArea.y1, clipArea.x2, clipArea.y2);
+    }
+    Serial.printf("[Flush] Per frame: windows %.2f invalidated, %.2f flushed (max %lu), pixels %.0f -> %.0f\n",
+                  stats.windowsIn / frames, stats.windowsOut / frames, (unsigned long)stats.maxWindows,
+                  stats.pixelsIn / frames, stats.pixelsOut / frames);
+    Serial.printf("[Flush] Modelled bus %.0f -> %.0f us per frame\n", stats.modelInUs / frames,
+                  stats.modelOutUs / frames);
+    Serial.printf("[Flush] Bus n=%lu avg=%lu p50=%lu p95=%lu max=%lu us\n", (unsigned long)h.count,
+                  (unsigned long)h.average(), (unsigned long)h.percentile(50), (unsigned long)h.percentile(95),
+                  (unsigned long)h.maxUs);
+}
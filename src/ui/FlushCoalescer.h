@@ -0,0 +1,141 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "FrameProfiler.h"
+#include "LilyGo_Display.h"
+
+/**
+ * Merges a frame's dirty areas into fewer, larger panel transfers when the
+ * bus says that is cheaper.
+ *
+ * Every flushed area costs an address window (CASET, RASET, RAMWR, each its
+ * own CS-framed command) and a new 0x32/0x2C00 pixel transaction before a
+ * single byte of it moves, so a frame that updates the satellites, quality,
+ * clock and speed labels pays that four times. LVGL only joins areas that
+ * overlap and get smaller by joining. Here each area is costed as a fixed
+ * per-window time plus its RGB565 bytes over the measured throughput, and
+ * pairs are merged into their bounding box, the biggest saving first, for
+ * as long as the box costs less than the two apart.
+ *
+ * The merge runs from the display driver's render_start_cb, after LVGL's
+ * own join and before anything is drawn. Both cost terms are learned from
+ * the flushes: throughput from big ones, the window cost from small ones.
+ * Merged boxes of even-rounded areas stay even, as the RM67162 wants.
+ *
+ * While the panel shows only part of the screen (Display's partial mode)
+ * areas are first clipped to that part, and whatever falls outside it is
+ * not drawn at all.
+ *
+ * Its flush hook also holds the bus from the first flush of a frame to the
+ * last (LilyGo_Display::startWrite), so the frame's windows go out back to
+ * back without the bus lock being taken per transaction. Chains in front
+ * of the panel flush like TearSync, so begin() it first and TearSync's
+ * waits don't count as bus time. "flush" prints windows and bus time per
+ * frame; "flush off" passes LVGL's areas through for comparison.
+ */
+class FlushCoalescer
+{
+public:
+    struct Stats
+    {
+        uint32_t frames = 0;      // Refreshes that flushed
+        uint32_t merges = 0;      // Pairs merged
+        uint32_t clipped = 0;     // Areas dropped outside the clip area
+        uint32_t windowsIn = 0;   // Areas as LVGL invalidated them
+        uint32_t windowsOut = 0;  // Areas flushed, one address window each
+        uint32_t maxWindows = 0;  // Most windows flushed in one frame
+        uint64_t pixelsIn = 0;
+        uint64_t pixelsOut = 0;
+        uint64_t modelInUs = 0;   // Modelled bus time of the areas as invalidated
+        uint64_t modelOutUs = 0;  // Modelled bus time of the areas as flushed
+        Histogram busUs;          // Measured bus time per frame
+    };
+
+private:
+    // Singleton instance
+    static FlushCoalescer *instance;
+
+    // Private constructor for singleton
+    FlushCoalescer() = default;
+
+    // Flushes at least this big teach the throughput, at most this big the window cost
+    static constexpr uint32_t MIN_LEARN_BYTES = 4096;
+    static constexpr uint32_t MAX_SETUP_BYTES = 512;
+    // Keep the learned model inside what the bus can actually do
+    static constexpr float MIN_WINDOW_US = 5.0f;
+    static constexpr float MAX_WINDOW_US = 500.0f;
+    static constexpr float MIN_BYTES_PER_US = 2.0f;
+    static constexpr float MAX_BYTES_PER_US = 80.0f;
+
+    LilyGo_Display *board = nullptr;
+    bool enabled = true;
+    bool writing = false; // Bus held for the frame being flushed
+    bool clipping = false;
+    lv_area_t clipArea;
+
+    // Cost model
+    float windowUs = 40.0f;
+    float bytesPerUs = 20.0f;
+
+    void (*originalFlush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = nullptr;
+    void (*originalRenderStart)(lv_disp_drv_t *) = nullptr;
+
+    Stats stats;
+    volatile bool resetRequested = false; // Applied at the next render start
+    uint32_t frameBusUs = 0;
+    uint32_t frameWindows = 0;
+
+    static void renderStartHook(lv_disp_drv_t *drv);
+    static void flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+    /**
+     * Merge areas in place while a merge lowers the modelled cost.
+     * @return the number of areas left
+     */
+    uint32_t merge(lv_area_t *areas, uint32_t count);
+
+    void learn(uint32_t bytes, uint32_t elapsedUs);
+
+public:
+    // Get singleton instance
+    static FlushCoalescer &getInstance();
+
+    // Delete copy constructor and assignment
+    FlushCoalescer(const FlushCoalescer &) = delete;
+    FlushCoalescer &operator=(const FlushCoalescer &) = delete;
+
+    /**
+     * Hook the default display's render start and flush.
+     * Call right after the LVGL display is registered, before TearSync.
+     * @param panel  display to hold the bus on per frame, or nullptr
+     * @return false if there is no display
+     */
+    bool begin(LilyGo_Display *panel);
+
+    /**
+     * Modelled bus time of flushing one area, in microseconds.
+     */
+    float costUs(const lv_area_t &area) const;
+
+    /**
+     * Switch merging and per-frame bus holding on and off (A/B comparison).
+     * Taken up at the next frame.
+     */
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Only draw inside `area` from the next frame on (nullptr = whole screen).
+     * Display task only.
+     */
+    void setClip(const lv_area_t *area);
+
+    const Stats &getStats() const { return stats; }
+
+    void printStats();
+
+    /**
+     * Clear the stats from any task; done when the next frame starts.
+     */
+    void requestReset() { resetRequested = true; }
+};
@@ -0,0 +1,53 @@
+#include "FontReport.h"
+#include "Assets.h"
+#include "SdfFont.h"
+#include <Arduino.h>
+
+#ifdef FONT_REPORT
+
+namespace FontReport
+{
+    static void printFont(const char *name, const lv_font_t *font)
+    {
+        const lv_font_fmt_txt_dsc_t *dsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+        uint32_t worst = 0;
+        uint32_t total = 0;
+        uint32_t pixels = 0;
+
+        for (uint32_t letter = '0'; letter <= '9'; letter++)
+        {
+            lv_font_glyph_dsc_t glyph;
+            if (!lv_font_get_glyph_dsc(font, &glyph, letter, 0))
+            {
+                continue;
+            }
+
+            uint32_t start = micros();
+            lv_font_get_glyph_bitmap(font, letter);
+            uint32_t elapsed = micros() - start;
+
+            total += elapsed;
+            pixels += glyph.box_w * glyph.box_h;
+            if (elapsed > worst)
+            {
+                worst = elapsed;
+            }
+        }
+
+        Serial.printf("FontReport: %s %ubpp %s - 10 digits %lu us (worst %lu us, %lu px)\n",
+                      name, dsc->bpp, dsc->bitmap_format ? "compressed" : "raw",
+                      (unsigned long)total, (unsigned long)worst, (unsigned long)pixels);
+    }
+
+    void print()
+    {
+#ifdef HUD_SDF_NUMERALS
+        SdfFont::print();
+#else
+        printFont("RobotoBlack_200", &RobotoBlack_200);
+        printFont("RobotoBlack_60", &RobotoBlack_60);
+#endif
+    }
+}
+
+#endif
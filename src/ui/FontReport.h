@@ -0,0 +1,14 @@
+#pragma once
+#include <lvgl.h>
+
+/**
+ * Glyph decode timing for the page fonts.
+ * Build with -DFONT_REPORT to print how long LVGL takes to fetch each digit
+ * bitmap. With the RLE compressed subsets this is the decompression cost,
+ * with the uncompressed masters it is only the table lookup.
+ */
+namespace FontReport
+{
+    // Print decode times for the digits of every page font - call after lv_init()
+    void print();
+}
@@ -0,0 +1,468 @@
+#include "FontResidency.h"
+#include "FrameProfiler.h"
+#include "FrameScheduler.h"
+#include "Theme.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+namespace FontResidency
+{
+    /**
+     * One font considered for copying, in order of preference for internal RAM.
+     */
+    struct Entry
+    {
+        const char *name;
+        const lv_font_t *font;
+        const lv_font_t *copy = nullptr; // Patched descriptor, nullptr while in flash
+        Placement placement = Placement::Flash;
+        size_t bytes = 0;
+        uint32_t copyUs = 0;
+    };
+
+    static Entry entries[] = {
+#if !defined(HUD_SDF_NUMERALS) && !defined(HUD_FONT_ASSETS)
+        // SDF numerals draw from their own glyph cache, asset fonts from the mmapped partition
+        {"RobotoBlack_200", &RobotoBlack_200},
+        {"RobotoBlack_60", &RobotoBlack_60},
+#endif
+        {"montserrat_28", &lv_font_montserrat_28},
+    };
+
+    /**
+     * Draw times recorded while one mode was active.
+     * Snapshotted from the profiler when the mode is switched.
+     */
+    struct Timing
+    {
+        uint32_t frames = 0;
+        uint32_t avgUs = 0;
+        uint32_t p50Us = 0;
+        uint32_t p95Us = 0;
+        uint32_t p99Us = 0;
+        uint32_t maxUs = 0;
+    };
+
+    static Timing timings[2]; // [0] flash, [1] copies
+
+    static bool started = false;
+    static bool usingCopies = FONT_RESIDENCY;
+    static volatile int8_t requested = -1; // -1 = nothing pending
+    static uint32_t bootCopyUs = 0;
+
+    static const char *placementName(Placement placement)
+    {
+        switch (placement)
+        {
+        case Placement::Internal:
+            return "internal";
+        case Placement::Psram:
+            return "psram";
+        default:
+            return "flash";
+        }
+    }
+
+    // ============================================================================
+    // FONT SIZES
+    // ============================================================================
+    static size_t align4(size_t n)
+    {
+        return (n + 3) & ~(size_t)3;
+    }
+
+    // Bits MSB first, as LVGL's get_bits() reads them
+    static uint8_t readBits(const uint8_t *in, uint32_t pos, uint8_t len)
+    {
+        uint8_t value = 0;
+        for (uint8_t i = 0; i < len; i++, pos++)
+        {
+            value = (value << 1) | ((in[pos >> 3] >> (7 - (pos & 7))) & 1);
+        }
+        return value;
+    }
+
+    /**
+     * Bits of compressed glyph data read to decode a glyph: the state machine
+     * of LVGL's rle_next(), keeping only the read position.
+     */
+    static uint32_t compressedBits(const uint8_t *in, uint32_t pixels, uint8_t bpp)
+    {
+        enum
+        {
+            SINGLE,
+            REPEAT,
+            COUNTER
+        } state = SINGLE;
+        uint32_t pos = 0;
+        uint8_t prev = 0;
+        uint8_t count = 0;
+
+        for (uint32_t i = 0; i < pixels; i++)
+        {
+            if (state == SINGLE)
+            {
+                uint8_t value = readBits(in, pos, bpp);
+                if (pos != 0 && value == prev)
+                {
+                    count = 0;
+                    state = REPEAT;
+                }
+                prev = value;
+                pos += bpp;
+            }
+            else if (state == REPEAT)
+            {
+                bool repeat = readBits(in, pos, 1);
+                count++;
+                pos++;
+                if (!repeat)
+                {
+                    prev = readBits(in, pos, bpp);
+                    pos += bpp;
+                    state = SINGLE;
+                }
+                else if (count == 11)
+                {
+                    count = readBits(in, pos, 6);
+                    pos += 6;
+                    if (count != 0)
+                    {
+                        state = COUNTER;
+                    }
+                    else
+                    {
+                        prev = readBits(in, pos, bpp);
+                        pos += bpp;
+                        state = SINGLE;
+                    }
+                }
+            }
+            else if (--count == 0)
+            {
+                prev = readBits(in, pos, bpp);
+                pos += bpp;
+                state = SINGLE;
+            }
+        }
+        return pos;
+    }
+
+    // Glyph ids run from 1 to the highest one any character map hands out
+    static uint32_t glyphCount(const lv_font_fmt_txt_dsc_t *dsc)
+    {
+        uint32_t count = 1;
+        for (uint16_t i = 0; i < dsc->cmap_num; i++)
+        {
+            const lv_font_fmt_txt_cmap_t &cmap = dsc->cmaps[i];
+            uint32_t last = 0;
+            switch (cmap.type)
+            {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                last = cmap.range_length ? cmap.glyph_id_start + cmap.range_length - 1 : 0;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                last = cmap.list_length ? cmap.glyph_id_start + cmap.list_length - 1 : 0;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            {
+                const uint8_t *ofs = (const uint8_t *)cmap.glyph_id_ofs_list;
+                for (uint16_t j = 0; j < cmap.list_length; j++)
+                {
+                    last = LV_MAX(last, (uint32_t)(cmap.glyph_id_start + ofs[j]));
+                }
+                break;
+            }
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            {
+                const uint16_t *ofs = (const uint16_t *)cmap.glyph_id_ofs_list;
+                for (uint16_t j = 0; j < cmap.list_length; j++)
+                {
+                    last = LV_MAX(last, (uint32_t)(cmap.glyph_id_start + ofs[j]));
+                }
+                break;
+            }
+            }
+            count = LV_MAX(count, last + 1);
+        }
+        return count;
+    }
+
+    // Bytes of the glyph bitmap array: glyphs are stored back to back, so it
+    // ends with the glyph at the highest offset
+    static size_t bitmapBytes(const lv_font_fmt_txt_dsc_t *dsc, uint32_t glyphs)
+    {
+        const lv_font_fmt_txt_glyph_dsc_t *last = nullptr;
+        for (uint32_t id = 1; id < glyphs; id++)
+        {
+            const lv_font_fmt_txt_glyph_dsc_t &g = dsc->glyph_dsc[id];
+            if (g.box_w && g.box_h && (last == nullptr || g.bitmap_index > last->bitmap_index))
+            {
+                last = &g;
+            }
+        }
+        if (last == nullptr)
+        {
+            return 0;
+        }
+
+        uint32_t pixels = last->box_w * last->box_h;
+        if (dsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN)
+        {
+            return last->bitmap_index + (pixels * dsc->bpp + 7) / 8;
+        }
+        // The decoder may peek one byte past the data it uses
+        uint32_t bits = compressedBits(&dsc->glyph_bitmap[last->bitmap_index], pixels, dsc->bpp);
+        return last->bitmap_index + (bits + 7) / 8 + 1;
+    }
+
+    // Bytes of a character map's lists
+    static size_t listBytes(const lv_font_fmt_txt_cmap_t &cmap, size_t &unicodeBytes)
+    {
+        unicodeBytes = 0;
+        switch (cmap.type)
+        {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            return cmap.list_length;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+            unicodeBytes = cmap.list_length * sizeof(uint16_t);
+            return 0;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            unicodeBytes = cmap.list_length * sizeof(uint16_t);
+            return cmap.list_length * sizeof(uint16_t);
+        default:
+            return 0;
+        }
+    }
+
+    static size_t copyBytes(const lv_font_fmt_txt_dsc_t *dsc)
+    {
+        uint32_t glyphs = glyphCount(dsc);
+        size_t bytes = align4(sizeof(lv_font_t)) + align4(sizeof(lv_font_fmt_txt_dsc_t)) +
+                       align4(glyphs * sizeof(lv_font_fmt_txt_glyph_dsc_t)) +
+                       align4(dsc->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+        for (uint16_t i = 0; i < dsc->cmap_num; i++)
+        {
+            size_t unicodeBytes;
+            size_t ofsBytes = listBytes(dsc->cmaps[i], unicodeBytes);
+            bytes += align4(unicodeBytes) + align4(ofsBytes);
+        }
+        return bytes + bitmapBytes(dsc, glyphs);
+    }
+
+    // ============================================================================
+    // COPYING
+    // ============================================================================
+    // Hands out aligned pieces of one allocation, copying each in
+    struct Block
+    {
+        uint8_t *next;
+
+        void *take(const void *source, size_t bytes)
+        {
+            void *piece = next;
+            memcpy(piece, source, bytes);
+            next += align4(bytes);
+            return piece;
+        }
+    };
+
+    /**
+     * Copy a font into block, which must hold copyBytes() of it.
+     * Kerning tables are small and looked up once per glyph pair; they stay in flash.
+     */
+    static const lv_font_t *copyFont(const lv_font_t *font, uint8_t *memory)
+    {
+        const lv_font_fmt_txt_dsc_t *dsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+        uint32_t glyphs = glyphCount(dsc);
+        Block block = {memory};
+
+        lv_font_t *fontCopy = (lv_font_t *)block.take(font, sizeof(lv_font_t));
+        lv_font_fmt_txt_dsc_t *dscCopy = (lv_font_fmt_txt_dsc_t *)block.take(dsc, sizeof(lv_font_fmt_txt_dsc_t));
+        fontCopy->dsc = dscCopy;
+
+        dscCopy->glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)block.take(
+            dsc->glyph_dsc, glyphs * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+
+        lv_font_fmt_txt_cmap_t *cmaps = (lv_font_fmt_txt_cmap_t *)block.take(
+            dsc->cmaps, dsc->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+        for (uint16_t i = 0; i < dsc->cmap_num; i++)
+        {
+            size_t unicodeBytes;
+            size_t ofsBytes = listBytes(cmaps[i], unicodeBytes);
+            if (unicodeBytes)
+            {
+                cmaps[i].unicode_list = (const uint16_t *)block.take(cmaps[i].unicode_list, unicodeBytes);
+            }
+            if (ofsBytes)
+            {
+                cmaps[i].glyph_id_ofs_list = block.take(cmaps[i].glyph_id_ofs_list, ofsBytes);
+            }
+        }
+        dscCopy->cmaps = cmaps;
+
+        dscCopy->glyph_bitmap = (const uint8_t *)block.take(dsc->glyph_bitmap, bitmapBytes(dsc, glyphs));
+        return fontCopy;
+    }
+
+    static uint8_t *allocate(size_t bytes, Placement &placement, size_t &internalUsed, size_t &psramUsed)
+    {
+        size_t internalFree = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (internalUsed + bytes <= INTERNAL_BUDGET && internalFree >= bytes + INTERNAL_RESERVE)
+        {
+            void *memory = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            if (memory != nullptr)
+            {
+                internalUsed += bytes;
+                placement = Placement::Internal;
+                return (uint8_t *)memory;
+            }
+        }
+        if (psramUsed + bytes <= PSRAM_BUDGET)
+        {
+            void *memory = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (memory != nullptr)
+            {
+                psramUsed += bytes;
+                placement = Placement::Psram;
+                return (uint8_t *)memory;
+            }
+        }
+        placement = Placement::Flash;
+        return nullptr;
+    }
+
+    void begin()
+    {
+        if (started)
+        {
+            return;
+        }
+        started = true;
+
+#if FONT_RESIDENCY
+        int64_t bootStart = esp_timer_get_time();
+        size_t internalUsed = 0;
+        size_t psramUsed = 0;
+
+        for (Entry &entry : entries)
+        {
+            int64_t start = esp_timer_get_time();
+            const lv_font_fmt_txt_dsc_t *dsc = (const lv_font_fmt_txt_dsc_t *)entry.font->dsc;
+            entry.bytes = copyBytes(dsc);
+
+            uint8_t *memory = allocate(entry.bytes, entry.placement, internalUsed, psramUsed);
+            if (memory != nullptr)
+            {
+                entry.copy = copyFont(entry.font, memory);
+            }
+            entry.copyUs = esp_timer_get_time() - start;
+
+            Serial.printf("FontResidency: %s %u bytes in %s (%lu us)\n", entry.name, (unsigned)entry.bytes,
+                          placementName(entry.placement), (unsigned long)entry.copyUs);
+        }
+
+        bootCopyUs = esp_timer_get_time() - bootStart;
+        Serial.printf("FontResidency: Fonts copied in %lu us, %u bytes internal, %u bytes PSRAM\n",
+                      (unsigned long)bootCopyUs, (unsigned)internalUsed, (unsigned)psramUsed);
+#endif
+    }
+
+    const lv_font_t *resolve(const lv_font_t *font)
+    {
+        if (usingCopies)
+        {
+            for (const Entry &entry : entries)
+            {
+                if (entry.font == font && entry.copy != nullptr)
+                {
+                    return entry.copy;
+                }
+            }
+        }
+        return font;
+    }
+
+    // ============================================================================
+    // A/B SWITCH
+    // ============================================================================
+    static Timing currentTiming()
+    {
+        Timing t;
+#if FRAME_PROFILER
+        const Histogram &draw = FrameProfiler::getInstance().getHistogram(Stage::Draw);
+        t.frames = draw.count;
+        t.avgUs = draw.average();
+        t.p50Us = draw.percentile(50);
+        t.p95Us = draw.percentile(95);
+        t.p99Us = draw.percentile(99);
+        t.maxUs = draw.maxUs;
+#endif
+        return t;
+    }
+
+    void request(bool useCopies)
+    {
+        requested = useCopies;
+        FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+    }
+
+    void applyRequested()
+    {
+        int8_t pending = requested;
+        if (pending < 0)
+        {
+            return;
+        }
+        requested = -1;
+        if ((bool)pending == usingCopies)
+        {
+            return;
+        }
+
+        timings[usingCopies] = currentTiming();
+        usingCopies = pending;
+        Theme::refreshFonts();
+#if FRAME_PROFILER
+        // Start the new mode's draw times from a clean slate
+        FrameProfiler::getInstance().reset();
+#endif
+        Serial.printf("FontResidency: Drawing from %s fonts\n", usingCopies ? "RAM" : "flash");
+    }
+
+    bool isUsingCopies()
+    {
+        return usingCopies;
+    }
+
+    void print()
+    {
+        for (const Entry &entry : entries)
+        {
+            Serial.printf("[Fonts] %-16s %8u bytes  %-8s copied in %lu us\n", entry.name, (unsigned)entry.bytes,
+                          placementName(entry.placement), (unsigned long)entry.copyUs);
+        }
+        Serial.printf("[Fonts] Boot copy %lu us, first frame %lu ms after boot, drawing from %s\n",
+                      (unsigned long)bootCopyUs, (unsigned long)FrameScheduler::getInstance().getFirstFrameMs(),
+                      usingCopies ? "RAM" : "flash");
+
+#if FRAME_PROFILER
+        Serial.println("[Fonts] fonts   frames   draw avg/p50/p95/p99/max us   jitter (p99-p50) us");
+        for (int i = 0; i < 2; i++)
+        {
+            bool active = (bool)i == usingCopies;
+            const Timing t = active ? currentTiming() : timings[i];
+            if (t.frames == 0)
+            {
+                continue;
+            }
+            Serial.printf("[Fonts] %-5s%c %8lu   %lu/%lu/%lu/%lu/%lu   %lu\n", i ? "ram" : "flash", active ? '*' : ' ',
+                          (unsigned long)t.frames, (unsigned long)t.avgUs, (unsigned long)t.p50Us,
+                          (unsigned long)t.p95Us, (unsigned long)t.p99Us, (unsigned long)t.maxUs,
+                          (unsigned long)(t.p99Us - t.p50Us));
+        }
+#else
+        Serial.println("[Fonts] Draw times need the profiler (FRAME_PROFILER=1)");
+#endif
+    }
+}
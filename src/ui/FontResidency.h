@@ -0,0 +1,66 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Compiled in by default; build with -DFONT_RESIDENCY=0 to draw every font from flash
+#ifndef FONT_RESIDENCY
+#define FONT_RESIDENCY 1
+#endif
+
+/**
+ * RAM copies of the fonts the speed page draws with.
+ *
+ * Glyph bitmaps and lookup tables live in flash and are read through the
+ * same cache and SPI bus as the code drawing them, so a big glyph redraw
+ * evicts code and stalls on both. At boot the bitmaps, glyph descriptors
+ * and character maps of RobotoBlack_200, RobotoBlack_60 and Montserrat 28
+ * are copied into internal RAM while a budget allows, otherwise into PSRAM
+ * (its own bus, though still behind the data cache), and a patched font
+ * descriptor pointing at the copies is handed out in place of the original.
+ * A font that fits nowhere stays in flash. The Roboto Black fonts are left
+ * out when they come from SDF numerals or the font asset partition.
+ *
+ * Theme asks resolve() for every font it puts in a style. "fonts flash" and
+ * "fonts ram" on serial switch between the originals and the copies at
+ * runtime, recording draw times for each so the jitter can be compared.
+ */
+namespace FontResidency
+{
+    enum class Placement : uint8_t
+    {
+        Flash,
+        Internal,
+        Psram,
+    };
+
+    // Internal RAM the copies may take, and what must be left free after them
+    constexpr size_t INTERNAL_BUDGET = 48 * 1024;
+    constexpr size_t INTERNAL_RESERVE = 96 * 1024;
+    // PSRAM the copies may take
+    constexpr size_t PSRAM_BUDGET = 512 * 1024;
+
+    /**
+     * Copy the fonts. Call once after lv_init(), before any style uses them.
+     */
+    void begin();
+
+    /**
+     * The font to draw with in place of font: its RAM copy while copies are
+     * in use, otherwise font itself.
+     */
+    const lv_font_t *resolve(const lv_font_t *font);
+
+    /**
+     * Switch between the RAM copies and the flash originals from any task.
+     * Applied by applyRequested() on the display task.
+     */
+    void request(bool useCopies);
+    void applyRequested();
+
+    bool isUsingCopies();
+
+    /**
+     * Print where each font lives, the boot copy cost and draw times per mode.
+     */
+    void print();
+}
@@ -0,0 +1,235 @@
+#include "FrameProfiler.h"
+#include "FrameScheduler.h"
+#include <esp_timer.h>
+
+// Singleton instance
+FrameProfiler *FrameProfiler::instance = nullptr;
+
+const char *const FrameProfiler::STAGE_NAMES[(int)Stage::Count] = {
+    "update", "layout", "draw", "flush", "idle", "frame"};
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+void Histogram::add(uint32_t us)
+{
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && us >= bucketLimit(bucket))
+    {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    count++;
+    totalUs += us;
+    if (us > maxUs)
+    {
+        maxUs = us;
+    }
+}
+
+uint32_t Histogram::bucketLimit(int i)
+{
+    return i >= BUCKETS - 1 ? UINT32_MAX : 1UL << (i + FIRST_SHIFT);
+}
+
+uint32_t Histogram::percentile(float p) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    uint32_t target = (uint32_t)ceilf(count * p / 100.0f);
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        if (buckets[i] == 0)
+        {
+            continue;
+        }
+        if (seen + buckets[i] >= target)
+        {
+            // Interpolate linearly inside the bucket, capped by the real max
+            uint32_t low = i == 0 ? 0 : bucketLimit(i - 1);
+            uint32_t high = i == BUCKETS - 1 ? maxUs : bucketLimit(i);
+            uint32_t value = low + (uint64_t)(high - low) * (target - seen) / buckets[i];
+            return value < maxUs ? value : maxUs;
+        }
+        seen += buckets[i];
+    }
+    return maxUs;
+}
+
+// ============================================================================
+// PROFILER
+// ============================================================================
+FrameProfiler &FrameProfiler::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new FrameProfiler();
+    }
+    return *instance;
+}
+
+FrameProfiler::Scope::Scope(Stage s) : stage(s)
+{
+    start = instance != nullptr && instance->enabled ? esp_timer_get_time() : -1;
+}
+
+FrameProfiler::Scope::~Scope()
+{
+    if (start >= 0)
+    {
+        instance->add(stage, esp_timer_get_time() - start);
+    }
+}
+
+void FrameProfiler::begin()
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == nullptr || disp->refr_timer == nullptr)
+    {
+        Serial.println("FrameProfiler: No display registered");
+        return;
+    }
+
+    // Chain in front of the panel flush and LVGL's refresh timer
+    originalFlush = disp->driver->flush_cb;
+    disp->driver->flush_cb = flushHook;
+    originalRefresh = disp->refr_timer->timer_cb;
+    disp->refr_timer->timer_cb = refreshHook;
+
+    secondStart = millis();
+    Serial.println("FrameProfiler: Hooked display refresh and flush");
+}
+
+void FrameProfiler::flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    if (!instance->enabled)
+    {
+        instance->originalFlush(drv, area, color_p);
+        return;
+    }
+
+    int64_t start = esp_timer_get_time();
+    instance->originalFlush(drv, area, color_p);
+    instance->add(Stage::Flush, esp_timer_get_time() - start);
+    instance->rendered = true;
+}
+
+void FrameProfiler::refreshHook(lv_timer_t *timer)
+{
+    if (!instance->enabled)
+    {
+        instance->originalRefresh(timer);
+        return;
+    }
+
+    // Everything in the refresh that isn't flushing is drawing
+    uint32_t flushBefore = instance->stageUs[(int)Stage::Flush];
+    int64_t start = esp_timer_get_time();
+    instance->originalRefresh(timer);
+    uint32_t elapsed = esp_timer_get_time() - start;
+    uint32_t flushed = instance->stageUs[(int)Stage::Flush] - flushBefore;
+    instance->add(Stage::Draw, elapsed > flushed ? elapsed - flushed : 0);
+}
+
+void FrameProfiler::endFrame()
+{
+    if (resetRequested)
+    {
+        resetRequested = false;
+        reset();
+        memset(stageUs, 0, sizeof(stageUs));
+        rendered = false;
+        Serial.println("[Profiler] Reset");
+        return;
+    }
+
+    if (!enabled)
+    {
+        return;
+    }
+
+    histograms[(int)Stage::Update].add(stageUs[(int)Stage::Update]);
+    histograms[(int)Stage::Layout].add(stageUs[(int)Stage::Layout]);
+    histograms[(int)Stage::Idle].add(stageUs[(int)Stage::Idle]);
+
+    // Draw and flush only mean something for iterations that rendered
+    if (rendered)
+    {
+        histograms[(int)Stage::Draw].add(stageUs[(int)Stage::Draw]);
+        histograms[(int)Stage::Flush].add(stageUs[(int)Stage::Flush]);
+        histograms[(int)Stage::Frame].add(stageUs[(int)Stage::Update] + stageUs[(int)Stage::Layout] +
+                                          stageUs[(int)Stage::Draw] + stageUs[(int)Stage::Flush]);
+        memcpy(lastFrameUs, stageUs, sizeof(lastFrameUs));
+        frames++;
+        framesThisSecond++;
+    }
+
+    uint32_t now = millis();
+    if (now - secondStart >= 1000)
+    {
+        fps = framesThisSecond * 1000.0f / (now - secondStart);
+        framesThisSecond = 0;
+        secondStart = now;
+    }
+
+    memset(stageUs, 0, sizeof(stageUs));
+    rendered = false;
+}
+
+void FrameProfiler::dump()
+{
+    Serial.printf("[Profiler] %lu frames, %.1f fps, worst frame %lu us%s\n",
+                  (unsigned long)frames, fps, (unsigned long)getWorstFrameUs(),
+                  enabled ? "" : " (disabled)");
+
+    for (int s = 0; s < (int)Stage::Count; s++)
+    {
+        const Histogram &h = histograms[s];
+        Serial.printf("[Profiler] %-6s n=%lu avg=%lu p50=%lu p95=%lu p99=%lu max=%lu us\n",
+                      STAGE_NAMES[s], (unsigned long)h.count, (unsigned long)h.average(),
+                      (unsigned long)h.percentile(50), (unsigned long)h.percentile(95),
+                      (unsigned long)h.percentile(99), (unsigned long)h.maxUs);
+    }
+
+    // Raw bucket counts, one row per stage: "<limit_us>:<count>"
+    for (int s = 0; s < (int)Stage::Count; s++)
+    {
+        const Histogram &h = histograms[s];
+        Serial.printf("[Profiler] raw %s", STAGE_NAMES[s]);
+        for (int i = 0; i < Histogram::BUCKETS; i++)
+        {
+            if (i == Histogram::BUCKETS - 1)
+            {
+                Serial.printf(" inf:%lu", (unsigned long)h.buckets[i]);
+            }
+            else
+            {
+                Serial.printf(" %lu:%lu", (unsigned long)Histogram::bucketLimit(i), (unsigned long)h.buckets[i]);
+            }
+        }
+        Serial.println();
+    }
+}
+
+void FrameProfiler::reset()
+{
+    for (Histogram &h : histograms)
+    {
+        h.reset();
+    }
+    frames = 0;
+    framesThisSecond = 0;
+    fps = 0.0f;
+    secondStart = millis();
+}
+
+void FrameProfiler::requestReset()
+{
+    resetRequested = true;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Compiled in by default; build with -DFRAME_PROFILER=0 to remove every probe
+#ifndef FRAME_PROFILER
+#define FRAME_PROFILER 1
+#endif
+
+/**
+ * Stages of one display task iteration.
+ */
+enum class Stage : uint8_t
+{
+    Update, // Page update() - reading data and setting label text
+    Layout, // lv_obj_update_layout() on the active screen
+    Draw,   // LVGL rendering into the draw buffer (refresh minus flush)
+    Flush,  // Pushing pixels to the panel over QSPI
+    Idle,   // Display task asleep in the frame scheduler
+    Frame,  // Update + layout + draw + flush of frames that rendered
+    Count
+};
+
+/**
+ * Fixed-bucket histogram of durations in microseconds.
+ * Bucket i holds samples below 2^(i + 6) us (64 us .. ~1 s), the last
+ * bucket is open ended. No allocation, safe to keep for every stage.
+ */
+class Histogram
+{
+public:
+    static constexpr int BUCKETS = 16;
+    static constexpr int FIRST_SHIFT = 6;
+
+    uint32_t buckets[BUCKETS] = {};
+    uint32_t count = 0;
+    uint32_t maxUs = 0;
+    uint64_t totalUs = 0;
+
+    void add(uint32_t us);
+    void reset() { *this = Histogram(); }
+
+    // Upper bound of bucket i in microseconds (UINT32_MAX for the last)
+    static uint32_t bucketLimit(int i);
+
+    // Percentile estimate (0-100), interpolated inside the bucket
+    uint32_t percentile(float p) const;
+    uint32_t average() const { return count ? totalUs / count : 0; }
+};
+
+/**
+ * FrameProfiler times each stage of the display task per frame.
+ *
+ * Update, layout and idle are timed with PROFILE_SCOPE() in the display
+ * task loop. Draw and flush are measured by wrapping the display driver's
+ * flush callback and LVGL's refresh timer, so the vendor helper is left
+ * alone. Timing uses esp_timer_get_time(); with FRAME_PROFILER=0 the
+ * macros expand to nothing, and at runtime the probes can be switched off
+ * with the "prof off" serial command.
+ */
+class FrameProfiler
+{
+public:
+    /**
+     * RAII probe that adds its lifetime to a stage of the current frame.
+     */
+    class Scope
+    {
+    private:
+        Stage stage;
+        int64_t start;
+
+    public:
+        explicit Scope(Stage s);
+        ~Scope();
+    };
+
+private:
+    // Singleton instance
+    static FrameProfiler *instance;
+
+    // Private constructor for singleton
+    FrameProfiler() = default;
+
+    static const char *const STAGE_NAMES[(int)Stage::Count];
+
+    bool enabled = true;
+    volatile bool resetRequested = false; // Applied by the next endFrame()
+
+    // Current iteration
+    uint32_t stageUs[(int)Stage::Count] = {};
+    bool rendered = false;
+
+    // Stage times of the last iteration that rendered
+    uint32_t lastFrameUs[(int)Stage::Count] = {};
+
+    // Original driver callbacks we chain to
+    void (*originalFlush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = nullptr;
+    void (*originalRefresh)(lv_timer_t *) = nullptr;
+
+    Histogram histograms[(int)Stage::Count];
+    uint32_t frames = 0;
+
+    // FPS over the last full second
+    uint32_t framesThisSecond = 0;
+    uint32_t secondStart = 0;
+    float fps = 0.0f;
+
+    static void flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    static void refreshHook(lv_timer_t *timer);
+
+public:
+    // Get singleton instance
+    static FrameProfiler &getInstance();
+
+    // Delete copy constructor and assignment
+    FrameProfiler(const FrameProfiler &) = delete;
+    FrameProfiler &operator=(const FrameProfiler &) = delete;
+
+    /**
+     * Hook into the default display. Call after the LVGL display is registered.
+     */
+    void begin();
+
+    /**
+     * Close the current iteration and add its stage times to the histograms.
+     */
+    void endFrame();
+
+    /**
+     * Add a measured duration to a stage of the current iteration.
+     */
+    void add(Stage stage, uint32_t us) { stageUs[(int)stage] += us; }
+
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Rendered frames per second over the last second.
+     */
+    float getFPS() const { return fps; }
+
+    /**
+     * Total frames rendered since the last reset.
+     */
+    uint32_t getFrameCount() const { return frames; }
+
+    /**
+     * Slowest rendered frame since the last reset, in microseconds.
+     */
+    uint32_t getWorstFrameUs() const { return histograms[(int)Stage::Frame].maxUs; }
+
+    const Histogram &getHistogram(Stage stage) const { return histograms[(int)stage]; }
+
+    /**
+     * Time a stage took in the last rendered frame, in microseconds.
+     */
+    uint32_t getLastFrameUs(Stage stage) const { return lastFrameUs[(int)stage]; }
+
+    /**
+     * Print a summary line per stage plus the raw bucket counts.
+     */
+    void dump();
+
+    /**
+     * Clear all histograms and counters. Display task only.
+     */
+    void reset();
+
+    /**
+     * Ask for a reset from any task; applied by the next endFrame().
+     */
+    void requestReset();
+};
+
+#if FRAME_PROFILER
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(stage) FrameProfiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(stage)
+#define PROFILE_END_FRAME() FrameProfiler::getInstance().endFrame()
+#else
+#define PROFILE_SCOPE(stage)
+#define PROFILE_END_FRAME()
+#endif
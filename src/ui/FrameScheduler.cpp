@@ -0,0 +1,248 @@
+#include "FrameScheduler.h"
+#include "RenderGovernor.h"
+
+// Singleton instance
+FrameScheduler *FrameScheduler::instance = nullptr;
+
+// Refresh cap, longest sleep and touch polling period for each state
+const FrameScheduler::StateConfig FrameScheduler::STATE_CONFIG[(int)Activity::Count] = {
+    {33, 250, 30},   // Riding - 30 fps cap
+    {100, 1000, 100}, // Parked - 10 fps cap, slower touch polling
+    {16, 100, 30},   // Swipe  - full LVGL refresh rate
+};
+
+const char *const FrameScheduler::STATE_NAMES[(int)Activity::Count] = {"Riding", "Parked", "Swipe"};
+
+FrameScheduler &FrameScheduler::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new FrameScheduler();
+    }
+    return *instance;
+}
+
+void FrameScheduler::begin()
+{
+    task = xTaskGetCurrentTaskHandle();
+
+    // Count real rendered frames through LVGL's monitor callback
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp != nullptr)
+    {
+        disp->driver->monitor_cb = monitorCallback;
+    }
+
+    applyStateConfig(activity);
+
+    iterationStart = micros();
+    lastIteration = millis();
+    lastStatsPrint = lastIteration;
+
+#ifdef FRAME_SCHEDULER_FIXED_MS
+    Serial.printf("FrameScheduler: Fixed %d ms interval (baseline mode)\n", FRAME_SCHEDULER_FIXED_MS);
+#else
+    Serial.println("FrameScheduler: Event driven");
+#endif
+}
+
+void FrameScheduler::wake(uint32_t reason)
+{
+    if (task != nullptr)
+    {
+        xTaskNotify(task, reason, eSetBits);
+    }
+}
+
+void FrameScheduler::publish(float speedMph)
+{
+    // Hysteresis so GPS jitter at walking pace doesn't flip the state
+    uint32_t now = millis();
+    if (speedMph >= RIDING_ENTER_MPH)
+    {
+        moving = true;
+        stoppedSince = 0;
+    }
+    else if (moving && speedMph < RIDING_EXIT_MPH)
+    {
+        if (stoppedSince == 0)
+        {
+            stoppedSince = now;
+        }
+        else if (now - stoppedSince >= PARKED_DELAY_MS)
+        {
+            moving = false;
+        }
+    }
+
+    wake(WAKE_DATA);
+}
+
+void FrameScheduler::setSwiping(bool isSwiping)
+{
+    swiping = isSwiping;
+}
+
+void FrameScheduler::requestUpdate(uint32_t withinMs)
+{
+    uint32_t due = millis() + withinMs;
+    if (pageTickDue == 0 || (int32_t)(due - pageTickDue) < 0)
+    {
+        pageTickDue = due;
+    }
+}
+
+void FrameScheduler::monitorCallback(lv_disp_drv_t * /*drv*/, uint32_t /*time*/, uint32_t px)
+{
+    StateStats &current = instance->stats[(int)instance->activity];
+    current.frames++;
+    current.pixels += px;
+    instance->rendered = true;
+
+    if (instance->firstFrameMs == 0)
+    {
+        instance->firstFrameMs = millis();
+        Serial.printf("FrameScheduler: First frame on screen %lu ms after boot\n", (unsigned long)instance->firstFrameMs);
+    }
+}
+
+Activity FrameScheduler::currentActivity()
+{
+    if (swiping)
+    {
+        return Activity::Swipe;
+    }
+
+    // A held finger counts as swiping even before the tileview starts scrolling
+    for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev != nullptr; indev = lv_indev_get_next(indev))
+    {
+        if (indev->driver->type == LV_INDEV_TYPE_POINTER && indev->proc.state == LV_INDEV_STATE_PRESSED)
+        {
+            return Activity::Swipe;
+        }
+    }
+
+    return moving ? Activity::Riding : Activity::Parked;
+}
+
+void FrameScheduler::applyStateConfig(Activity state)
+{
+    // Touch has no interrupt line wired up, so slow down its polling instead
+    for (lv_indev_t *indev = lv_indev_get_next(nullptr); indev != nullptr; indev = lv_indev_get_next(indev))
+    {
+        lv_timer_t *readTimer = indev->driver->read_timer;
+        if (readTimer != nullptr)
+        {
+            lv_timer_set_period(readTimer, STATE_CONFIG[(int)state].indevPeriodMs);
+        }
+    }
+}
+
+uint32_t FrameScheduler::frameIntervalMs(Activity state) const
+{
+    uint32_t interval = STATE_CONFIG[(int)state].minIntervalMs;
+    return pageFrameMs != 0 && pageFrameMs < interval ? pageFrameMs : interval;
+}
+
+void FrameScheduler::waitForWork(uint32_t lvglDueMs)
+{
+    Activity state = currentActivity();
+    StateStats &current = stats[(int)activity];
+    uint32_t busyUs = micros() - iterationStart;
+    current.busyUs += busyUs;
+    current.wakes++;
+
+    // Frames that took longer than the state's frame period slip
+    if (rendered)
+    {
+        RenderGovernor::getInstance().addFrame(busyUs, frameIntervalMs(activity) * 1000);
+        rendered = false;
+    }
+
+    if (state != activity)
+    {
+        activity = state;
+        applyStateConfig(state);
+    }
+
+    const StateConfig &config = STATE_CONFIG[(int)state];
+    uint32_t now = millis();
+
+#ifdef FRAME_SCHEDULER_FIXED_MS
+    // Baseline: the old fixed-interval polling loop
+    (void)config;
+    (void)lvglDueMs;
+    uint32_t elapsed = now - lastIteration;
+    if (elapsed < FRAME_SCHEDULER_FIXED_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(FRAME_SCHEDULER_FIXED_MS - elapsed));
+    }
+#else
+    // Sleep until the earliest of: LVGL timer due, page tick, state max sleep
+    uint32_t timeout = config.maxSleepMs;
+    if (lvglDueMs < timeout)
+    {
+        timeout = lvglDueMs;
+    }
+    if (pageTickDue != 0)
+    {
+        int32_t untilPage = (int32_t)(pageTickDue - now);
+        if (untilPage < (int32_t)timeout)
+        {
+            timeout = untilPage > 0 ? untilPage : 0;
+        }
+        pageTickDue = 0;
+    }
+
+    uint32_t reasons = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &reasons, pdMS_TO_TICKS(timeout));
+
+    // Woken early - hold off until the refresh cap allows another frame
+    uint32_t interval = frameIntervalMs(state);
+    uint32_t elapsed = millis() - lastIteration;
+    if (elapsed < interval)
+    {
+        vTaskDelay(pdMS_TO_TICKS(interval - elapsed));
+    }
+#endif
+
+    uint32_t end = micros();
+    current.totalUs += end - iterationStart;
+    iterationStart = end;
+    lastIteration = millis();
+
+    if (statsRequested || lastIteration - lastStatsPrint >= STATS_INTERVAL_MS)
+    {
+        statsRequested = false;
+        printStats();
+        lastStatsPrint = lastIteration;
+    }
+}
+
+void FrameScheduler::requestStats()
+{
+    statsRequested = true;
+    wake(WAKE_PAGE);
+}
+
+void FrameScheduler::printStats()
+{
+    for (int i = 0; i < (int)Activity::Count; i++)
+    {
+        StateStats &s = stats[i];
+        if (s.totalUs == 0)
+        {
+            continue;
+        }
+
+        float seconds = s.totalUs / 1000000.0f;
+        Serial.printf("[Frames] %s: %.0f frames/min, %.0f px/s redrawn, %.0f wakes/min, core 1 load %.1f%% (%.1fs)\n",
+                      STATE_NAMES[i],
+                      s.frames * 60.0f / seconds,
+                      s.pixels / seconds,
+                      s.wakes * 60.0f / seconds,
+                      100.0f * s.busyUs / s.totalUs,
+                      seconds);
+        s = StateStats();
+    }
+}
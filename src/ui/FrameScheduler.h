@@ -0,0 +1,185 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * Activity states the display task is scheduled for.
+ * Each state caps how often the UI may refresh and how long it may sleep.
+ */
+enum class Activity : uint8_t
+{
+    Riding, // Speed above the riding threshold - data changes every GPS fix
+    Parked, // Stationary - only the clock and status fields change
+    Swipe,  // Touch held or tileview scrolling - needs full frame rate
+    Count
+};
+
+/**
+ * FrameScheduler puts the display task to sleep until there is work.
+ *
+ * Instead of polling LVGL every 5 ms, the display task blocks on its task
+ * notification and is woken by:
+ *   - a data publish from the sensor task (new GPS sentence)
+ *   - touch input / tileview scrolling
+ *   - LVGL animations and timers (lv_timer_handler due time)
+ *   - pages asking for another update (e.g. the speed roll animation)
+ *
+ * The refresh rate is capped per activity state (a page can ask for a
+ * shorter frame period while it is visible), and frames rendered plus
+ * display task CPU time are accounted per state so the effect can be
+ * compared against the old fixed-interval loop (build with
+ * -DFRAME_SCHEDULER_FIXED_MS=5 to get that baseline with the same stats).
+ */
+class FrameScheduler
+{
+public:
+    // Wake reasons, delivered as task notification bits
+    static constexpr uint32_t WAKE_DATA = 1 << 0;
+    static constexpr uint32_t WAKE_INPUT = 1 << 1;
+    static constexpr uint32_t WAKE_PAGE = 1 << 2;
+
+    /**
+     * Per-state scheduling limits.
+     * minIntervalMs caps the refresh rate, maxSleepMs bounds how stale
+     * polled page content (battery, uptime) can get.
+     */
+    struct StateConfig
+    {
+        uint32_t minIntervalMs;
+        uint32_t maxSleepMs;
+        uint32_t indevPeriodMs; // Touch polling period
+    };
+
+    /**
+     * Accumulated figures for one activity state.
+     */
+    struct StateStats
+    {
+        uint32_t frames = 0;   // Frames LVGL actually rendered
+        uint64_t pixels = 0;   // Invalidated area LVGL redrew
+        uint32_t wakes = 0;    // Display task iterations
+        uint64_t busyUs = 0;   // Time the display task spent working
+        uint64_t totalUs = 0;  // Time spent in this state
+    };
+
+private:
+    // Singleton instance
+    static FrameScheduler *instance;
+
+    // Private constructor for singleton
+    FrameScheduler() = default;
+
+    static const StateConfig STATE_CONFIG[(int)Activity::Count];
+    static const char *const STATE_NAMES[(int)Activity::Count];
+
+    // Riding/parked hysteresis
+    static constexpr float RIDING_ENTER_MPH = 3.0f;
+    static constexpr float RIDING_EXIT_MPH = 1.0f;
+    static constexpr uint32_t PARKED_DELAY_MS = 10000; // Stay in riding this long after stopping
+
+    // Periodic report on serial
+    static constexpr uint32_t STATS_INTERVAL_MS = 60000;
+
+    TaskHandle_t task = nullptr;
+    volatile bool moving = false;
+    uint32_t stoppedSince = 0;
+    bool swiping = false;
+    Activity activity = Activity::Parked;
+
+    uint32_t iterationStart = 0;  // micros() when the current iteration began
+    uint32_t lastIteration = 0;   // millis() of the previous iteration
+    uint32_t pageTickDue = 0;     // millis() a page asked to be updated by (0 = none)
+    uint32_t pageFrameMs = 0;     // Visible page's frame period (0 = the state's cap)
+    uint32_t lastStatsPrint = 0;
+    volatile bool statsRequested = false; // Print and reset the stats on the next iteration
+    uint32_t firstFrameMs = 0;    // millis() when the first frame reached the panel (0 = not yet)
+    bool rendered = false;        // LVGL rendered a frame this iteration
+
+    StateStats stats[(int)Activity::Count];
+
+    static void monitorCallback(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+    Activity currentActivity();
+
+    /**
+     * Print frames per minute, redrawn area and CPU load per state, then
+     * reset the counters. Display task only.
+     */
+    void printStats();
+    void applyStateConfig(Activity state);
+
+    /**
+     * Refresh cap for a state: its own, or the visible page's if shorter.
+     */
+    uint32_t frameIntervalMs(Activity state) const;
+
+public:
+    // Get singleton instance
+    static FrameScheduler &getInstance();
+
+    // Delete copy constructor and assignment
+    FrameScheduler(const FrameScheduler &) = delete;
+    FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+    /**
+     * Attach to the calling task and the default LVGL display.
+     * Call from the display task before the first waitForWork().
+     */
+    void begin();
+
+    /**
+     * Wake the display task. Safe to call from any task.
+     */
+    void wake(uint32_t reason);
+
+    /**
+     * Publish new sensor data from the sensor task.
+     * Updates the riding/parked state and wakes the display task.
+     */
+    void publish(float speedMph);
+
+    /**
+     * Mark the tileview as scrolling (called from PageManager scroll events).
+     */
+    void setSwiping(bool isSwiping);
+    bool isSwiping() const { return swiping; }
+
+    /**
+     * Ask for the page update to run again within the given time.
+     * Pages use this for their own animations.
+     */
+    void requestUpdate(uint32_t withinMs);
+
+    /**
+     * Let the visible page refresh faster than the activity state's cap,
+     * every `ms` at most (0 = the state's cap). Set by PageManager from
+     * Page::getFrameIntervalMs() when the page changes.
+     */
+    void setPageFrameInterval(uint32_t ms) { pageFrameMs = ms; }
+
+    /**
+     * Block until the next frame is due.
+     * @param lvglDueMs return value of lv_timer_handler()
+     */
+    void waitForWork(uint32_t lvglDueMs);
+
+    /**
+     * Get the current activity state.
+     */
+    Activity getActivity() const { return activity; }
+
+    /**
+     * Get the boot-to-first-pixel time in ms (0 until the first frame).
+     */
+    uint32_t getFirstFrameMs() const { return firstFrameMs; }
+
+    /**
+     * Get accumulated stats for a state.
+     */
+    const StateStats &getStats(Activity state) const { return stats[(int)state]; }
+
+    /**
+     * Ask for the stats to be printed and reset from any task; done at the
+     * end of the next display task iteration.
+     */
+    void requestStats();
+};
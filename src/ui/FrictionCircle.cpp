@@ -0,0 +1,432 @@
+#include "FrictionCircle.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <string.h>
+
+// ============================================================================
+// MODEL
+// ============================================================================
+lv_coord_t FrictionCircle::toPixels(float g) const
+{
+    float radius = size / 2 - MARGIN;
+    return (lv_coord_t)lroundf(g / rangeG * radius);
+}
+
+void FrictionCircle::add(float lateralG, float longitudinalG, uint32_t now)
+{
+    // Forward is up; the 2 px brush sits right and below the point
+    lv_coord_t centre = size / 2;
+    lv_coord_t x = centre + toPixels(lateralG);
+    lv_coord_t y = centre - toPixels(longitudinalG);
+
+    Point &point = ring[added % TRAIL_POINTS];
+    point.x = LV_CLAMP(0, x, size - 2);
+    point.y = LV_CLAMP(0, y, size - 2);
+    point.joined = added > 0 && now - ring[(added - 1) % TRAIL_POINTS].ms <= GAP_MS;
+    point.ms = now;
+    added++;
+
+    peaks.left = LV_MAX(peaks.left, -lateralG);
+    peaks.right = LV_MAX(peaks.right, lateralG);
+    peaks.accel = LV_MAX(peaks.accel, longitudinalG);
+    peaks.brake = LV_MAX(peaks.brake, -longitudinalG);
+}
+
+uint8_t FrictionCircle::bandOf(uint32_t segment, uint32_t now) const
+{
+    // A segment is as old as its newer end
+    uint32_t age = now - ring[segment % TRAIL_POINTS].ms;
+    return age >= trailMs ? BANDS : (uint8_t)(age * BANDS / trailMs);
+}
+
+uint32_t FrictionCircle::msToNextFade(uint32_t now) const
+{
+    uint32_t next = 0;
+    for (uint32_t segment = shownFrom; segment < shownTo; segment++)
+    {
+        uint8_t band = shownBand[segment % TRAIL_POINTS];
+        if (band == NOT_SHOWN)
+        {
+            continue;
+        }
+        uint32_t age = now - ring[segment % TRAIL_POINTS].ms;
+        uint32_t due = (band + 1) * trailMs / BANDS;
+        uint32_t wait = due > age ? due - age : 1;
+        next = next == 0 ? wait : LV_MIN(next, wait);
+    }
+    return next;
+}
+
+// ============================================================================
+// VIEW
+// ============================================================================
+bool FrictionCircle::allocate()
+{
+    size_t bytes = (size_t)size * size * sizeof(lv_color_t);
+    pixels = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    background = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (pixels == nullptr || background == nullptr)
+    {
+        Serial.printf("FrictionCircle: Cannot allocate 2 x %u byte PSRAM buffers\n", (unsigned)bytes);
+        heap_caps_free(pixels);
+        heap_caps_free(background);
+        pixels = background = nullptr;
+        return false;
+    }
+
+    dsc.header.always_zero = 0;
+    dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc.header.w = size;
+    dsc.header.h = size;
+    dsc.data_size = bytes;
+    dsc.data = (const uint8_t *)pixels;
+    return true;
+}
+
+bool FrictionCircle::create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y)
+{
+    if (pixels == nullptr && !allocate())
+    {
+        return false;
+    }
+
+    image = lv_img_create(parent);
+    lv_obj_clear_flag(image, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_img_set_src(image, &dsc);
+    lv_obj_set_pos(image, x, y);
+    originX = x;
+    originY = y;
+
+    // Peak markers across the axes, placed by sync()
+    for (int i = 0; i < 4; i++)
+    {
+        bool lateral = i < 2;
+        markers[i] = lv_obj_create(parent);
+        lv_obj_remove_style_all(markers[i]);
+        lv_obj_clear_flag(markers[i], LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_size(markers[i], lateral ? MARKER_WIDTH : MARKER_LENGTH, lateral ? MARKER_LENGTH : MARKER_WIDTH);
+        lv_obj_set_style_bg_opa(markers[i], LV_OPA_COVER, 0);
+        Theme::apply(markers[i], Theme::Tone::Poor);
+        lv_obj_add_flag(markers[i], LV_OBJ_FLAG_HIDDEN);
+        markerShown[i] = -1;
+    }
+
+    // Current sample on top of everything
+    dot = lv_obj_create(parent);
+    lv_obj_remove_style_all(dot);
+    lv_obj_clear_flag(dot, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(dot, DOT_SIZE, DOT_SIZE);
+    lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, 0);
+    Theme::apply(dot, Theme::Tone::Primary);
+    lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
+    dotShown = -1;
+
+    // The buffer may be from before a release; draw it from the model
+    drawnAll = false;
+    sync(millis());
+    return true;
+}
+
+void FrictionCircle::release()
+{
+    // Deleted with the parent's other children; the buffers are kept
+    image = nullptr;
+    dot = nullptr;
+    for (lv_obj_t *&marker : markers)
+    {
+        marker = nullptr;
+    }
+    drawnAll = false;
+}
+
+void FrictionCircle::pickColors()
+{
+    // Accent fading to black towards the tail
+    lv_color_t accent = Theme::color(Theme::Tone::Accent);
+    for (uint8_t band = 0; band < BANDS; band++)
+    {
+        shades[band] = lv_color_mix(accent, lv_color_black(), LV_OPA_COVER - band * LV_OPA_COVER / BANDS);
+    }
+    gridColor = lv_color_mix(Theme::color(Theme::Tone::Secondary), lv_color_black(), GRID_OPA);
+    edgeColor = lv_color_mix(Theme::color(Theme::Tone::Secondary), lv_color_black(), EDGE_OPA);
+}
+
+bool FrictionCircle::colorsChanged() const
+{
+    return Theme::color(Theme::Tone::Accent).full != shades[0].full ||
+           lv_color_mix(Theme::color(Theme::Tone::Secondary), lv_color_black(), GRID_OPA).full != gridColor.full;
+}
+
+void FrictionCircle::plotCircle(lv_coord_t radius, lv_color_t color, bool dotted)
+{
+    // Midpoint circle, one octant mirrored eight ways
+    lv_coord_t centre = size / 2;
+    lv_coord_t x = radius;
+    lv_coord_t y = 0;
+    lv_coord_t error = 1 - radius;
+    while (x >= y)
+    {
+        if (!dotted || y % GRID_DOT == 0)
+        {
+            const int32_t points[8][2] = {{x, y}, {y, x}, {-y, x}, {-x, y}, {-x, -y}, {-y, -x}, {y, -x}, {x, -y}};
+            for (const auto &p : points)
+            {
+                background[(centre + p[1]) * size + centre + p[0]] = color;
+            }
+        }
+        y++;
+        if (error < 0)
+        {
+            error += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void FrictionCircle::renderBackground()
+{
+    lv_color_t black = lv_color_black();
+    for (uint32_t i = 0; i < (uint32_t)size * size; i++)
+    {
+        background[i] = black;
+    }
+
+    // Dotted axes and rings, the outer ring solid
+    lv_coord_t centre = size / 2;
+    for (lv_coord_t i = 0; i < size; i += GRID_DOT)
+    {
+        background[centre * size + i] = gridColor;
+        background[i * size + centre] = gridColor;
+    }
+    for (float g = ringG; g < rangeG - 0.01f; g += ringG)
+    {
+        plotCircle(toPixels(g), gridColor, true);
+    }
+    plotCircle(toPixels(rangeG), edgeColor, false);
+}
+
+void FrictionCircle::stroke(uint32_t segment, const lv_color_t *match, lv_color_t color, bool restore)
+{
+    const Point &from = ring[(segment - 1) % TRAIL_POINTS];
+    const Point &to = ring[segment % TRAIL_POINTS];
+
+    // Bresenham from one point to the other, a 2x2 brush at each step
+    int32_t x = from.x;
+    int32_t y = from.y;
+    int32_t dx = abs(to.x - from.x);
+    int32_t dy = -abs(to.y - from.y);
+    int32_t stepX = from.x < to.x ? 1 : -1;
+    int32_t stepY = from.y < to.y ? 1 : -1;
+    int32_t error = dx + dy;
+    while (true)
+    {
+        for (int32_t i = 0; i < 4; i++)
+        {
+            uint32_t index = (y + i / 2) * size + x + i % 2;
+            if (match == nullptr || pixels[index].full == match->full)
+            {
+                pixels[index] = restore ? background[index] : color;
+            }
+        }
+        if (x == to.x && y == to.y)
+        {
+            break;
+        }
+        int32_t twice = 2 * error;
+        if (twice >= dy)
+        {
+            error += dy;
+            x += stepX;
+        }
+        if (twice <= dx)
+        {
+            error += dx;
+            y += stepY;
+        }
+    }
+
+    // Only the segment's own box goes to the panel; a full render sends the lot
+    if (!drawnAll)
+    {
+        return;
+    }
+    lv_area_t area;
+    lv_obj_get_coords(image, &area);
+    lv_coord_t left = area.x1;
+    lv_coord_t top = area.y1;
+    area.x1 = left + LV_MIN(from.x, to.x);
+    area.y1 = top + LV_MIN(from.y, to.y);
+    area.x2 = left + LV_MAX(from.x, to.x) + 1;
+    area.y2 = top + LV_MAX(from.y, to.y) + 1;
+    lv_obj_invalidate_area(image, &area);
+}
+
+void FrictionCircle::renderAll(uint32_t now)
+{
+    pickColors();
+    renderBackground();
+    memcpy(pixels, background, (size_t)size * size * sizeof(lv_color_t));
+
+    // Every segment still in the ring, oldest first so newer ones end on top
+    shownFrom = added > TRAIL_POINTS ? added - TRAIL_POINTS + 1 : 1;
+    shownTo = LV_MAX(shownFrom, added);
+    for (uint32_t segment = shownFrom; segment < shownTo; segment++)
+    {
+        uint8_t band = bandOf(segment, now);
+        bool visible = band < BANDS && ring[segment % TRAIL_POINTS].joined;
+        shownBand[segment % TRAIL_POINTS] = visible ? band : NOT_SHOWN;
+        if (visible)
+        {
+            stroke(segment, nullptr, shades[band], false);
+        }
+    }
+
+    lv_obj_invalidate(image);
+    drawnAll = true;
+    stats.fullRenders++;
+}
+
+void FrictionCircle::sync(uint32_t now)
+{
+    if (image == nullptr)
+    {
+        return;
+    }
+    int64_t start = esp_timer_get_time();
+
+    // The oldest shown segment's first point was overwritten: its pixels are unknown
+    bool lost = shownFrom < shownTo && added - (shownFrom - 1) > TRAIL_POINTS;
+    bool changed = true;
+    if (!drawnAll || lost || colorsChanged())
+    {
+        renderAll(now);
+    }
+    else
+    {
+        changed = false;
+
+        // Age what is on screen: a shade darker, or back to the background
+        for (uint32_t segment = shownFrom; segment < shownTo; segment++)
+        {
+            uint8_t &shown = shownBand[segment % TRAIL_POINTS];
+            if (shown == NOT_SHOWN)
+            {
+                continue;
+            }
+            uint8_t band = bandOf(segment, now);
+            if (band == shown)
+            {
+                continue;
+            }
+            if (band >= BANDS)
+            {
+                stroke(segment, &shades[shown], shades[shown], true);
+                shown = NOT_SHOWN;
+                stats.erased++;
+            }
+            else
+            {
+                stroke(segment, &shades[shown], shades[band], false);
+                shown = band;
+                stats.faded++;
+            }
+            changed = true;
+        }
+        while (shownFrom < shownTo && shownBand[shownFrom % TRAIL_POINTS] == NOT_SHOWN)
+        {
+            shownFrom++;
+        }
+
+        // New segments at the head, over everything else
+        for (uint32_t segment = shownTo; segment < added; segment++)
+        {
+            uint8_t band = bandOf(segment, now);
+            bool visible = band < BANDS && ring[segment % TRAIL_POINTS].joined;
+            shownBand[segment % TRAIL_POINTS] = visible ? band : NOT_SHOWN;
+            if (visible)
+            {
+                stroke(segment, nullptr, shades[band], false);
+                stats.drawn++;
+                changed = true;
+            }
+        }
+        shownTo = LV_MAX(shownTo, added);
+    }
+
+    if (changed)
+    {
+        stats.syncs++;
+        stats.drawUs += esp_timer_get_time() - start;
+    }
+    placeMarkers();
+    placeDot(now);
+}
+
+void FrictionCircle::placeDot(uint32_t now)
+{
+    // On the newest sample while it is fresh
+    const Point &newest = ring[(added - 1) % TRAIL_POINTS];
+    bool fresh = added > 0 && now - newest.ms <= GAP_MS;
+    if (!fresh)
+    {
+        if (!lv_obj_has_flag(dot, LV_OBJ_FLAG_HIDDEN))
+        {
+            lv_obj_add_flag(dot, LV_OBJ_FLAG_HIDDEN);
+        }
+        return;
+    }
+
+    // Hidden or moved only when that changes
+    int32_t shown = newest.y * size + newest.x;
+    if (shown != dotShown)
+    {
+        lv_obj_set_pos(dot, originX + newest.x + 1 - DOT_SIZE / 2, originY + newest.y + 1 - DOT_SIZE / 2);
+        dotShown = shown;
+    }
+    if (lv_obj_has_flag(dot, LV_OBJ_FLAG_HIDDEN))
+    {
+        lv_obj_clear_flag(dot, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void FrictionCircle::placeMarkers()
+{
+    // Each peak's distance out along its own half-axis
+    const float values[4] = {peaks.left, peaks.right, peaks.accel, peaks.brake};
+    const int8_t signs[4] = {-1, 1, -1, 1}; // Left, right; forward is up
+    lv_coord_t centre = size / 2;
+    lv_coord_t reach = size / 2 - 1;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (values[i] <= 0.0f)
+        {
+            // None yet, or the peaks were reset
+            if (markerShown[i] >= 0)
+            {
+                lv_obj_add_flag(markers[i], LV_OBJ_FLAG_HIDDEN);
+                markerShown[i] = -1;
+            }
+            continue;
+        }
+
+        lv_coord_t distance = LV_MIN(toPixels(values[i]), reach);
+        if (distance == markerShown[i])
+        {
+            continue;
+        }
+        markerShown[i] = distance;
+
+        bool lateral = i < 2;
+        lv_coord_t along = centre + signs[i] * distance;
+        lv_coord_t x = lateral ? along - MARKER_WIDTH / 2 : centre - MARKER_LENGTH / 2;
+        lv_coord_t y = lateral ? centre - MARKER_LENGTH / 2 : along - MARKER_WIDTH / 2;
+        lv_obj_set_pos(markers[i], originX + x, originY + y);
+        lv_obj_clear_flag(markers[i], LV_OBJ_FLAG_HIDDEN);
+    }
+}
@@ -0,0 +1,180 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "Theme.h"
+
+/**
+ * Friction circle: lateral against longitudinal acceleration, as a dot
+ * with a trail that fades out over the last few seconds, and markers at
+ * the peaks in each direction.
+ *
+ * Redrawing a fading trail of lines every frame costs the whole trail each
+ * time. Here the plot is an RGB565 buffer in PSRAM shown by one image, and
+ * the grid (rings and axes) is rendered once into a second buffer kept as
+ * the background. The trail is a ring of the last TRAIL_POINTS samples and
+ * fades in BANDS steps by age. A sync() draws the new segments at the head
+ * in full color, steps the few segments that crossed into an older band
+ * down one shade, and erases the segments that aged out by copying the
+ * background back over their pixels. Each touches only the pixels of its
+ * own stroke and invalidates only its own box, so the cost per sync is set
+ * by the sample rate, not the trail length.
+ *
+ * Fading and erasing only change pixels still in the shade the segment was
+ * drawn in, so a newer segment crossing an older one stays on top. Two
+ * segments of one band crossing can lose a pixel early; a full render
+ * (create, palette change) draws the trail exactly.
+ *
+ * The model (add()) doesn't touch LVGL and can be fed from a page's
+ * backgroundUpdate(); sync() brings the view up to date from the display
+ * task.
+ */
+class FrictionCircle
+{
+public:
+    static constexpr uint8_t TRAIL_POINTS = 64; // Power of two
+    static constexpr uint8_t BANDS = 4;         // Shades from head to tail
+
+    struct Stats
+    {
+        uint32_t syncs = 0;       // sync() calls that drew something
+        uint32_t drawn = 0;       // Segments drawn at the head
+        uint32_t faded = 0;       // Segments stepped down a shade
+        uint32_t erased = 0;      // Segments restored to the background
+        uint32_t fullRenders = 0; // Whole plot redrawn
+        uint64_t drawUs = 0;      // Time spent drawing into the buffer
+    };
+
+    /**
+     * Largest acceleration seen each way, in g, all positive.
+     */
+    struct Peaks
+    {
+        float left = 0.0f;
+        float right = 0.0f;
+        float accel = 0.0f;
+        float brake = 0.0f;
+    };
+
+private:
+    /**
+     * One sample in plot pixels, when it was taken, and whether the trail
+     * joins it to the one before.
+     */
+    struct Point
+    {
+        int16_t x;
+        int16_t y;
+        uint32_t ms;
+        bool joined;
+    };
+
+    static constexpr uint8_t NOT_SHOWN = 0xFF;
+    static constexpr uint32_t GAP_MS = 1000;        // Samples further apart aren't joined
+    static constexpr lv_coord_t MARGIN = 4;         // Between the outer ring and the edge
+    static constexpr lv_coord_t DOT_SIZE = 12;
+    static constexpr lv_coord_t MARKER_LENGTH = 14;
+    static constexpr lv_coord_t MARKER_WIDTH = 4;
+    static constexpr uint8_t GRID_DOT = 3;          // Rings and axes are dotted every this many pixels
+    static constexpr lv_opa_t GRID_OPA = LV_OPA_40; // Of the Secondary tone
+    static constexpr lv_opa_t EDGE_OPA = LV_OPA_70;
+
+    const uint16_t size;
+    const float rangeG;  // At the outer ring
+    const float ringG;   // Dotted rings every this much inside it
+    const uint32_t trailMs;
+
+    // Model
+    Point ring[TRAIL_POINTS];
+    uint32_t added = 0;  // Samples since the start; the newest is added - 1
+    Peaks peaks;
+
+    // View
+    lv_color_t *pixels = nullptr;
+    lv_color_t *background = nullptr;
+    lv_img_dsc_t dsc;
+    lv_obj_t *image = nullptr;
+    lv_coord_t originX = 0;          // Image position on the parent
+    lv_coord_t originY = 0;
+    lv_obj_t *dot = nullptr;
+    lv_obj_t *markers[4] = {nullptr, nullptr, nullptr, nullptr}; // Left, right, accel, brake
+    lv_coord_t markerShown[4];       // Distance out each marker sits, -1 = hidden
+    int32_t dotShown = -1;           // Pixel the dot is on, -1 = none yet
+    uint8_t shownBand[TRAIL_POINTS]; // Shade each segment is drawn in, by the slot of its newer point
+    uint32_t shownFrom = 1;          // Oldest segment that may be on screen
+    uint32_t shownTo = 1;            // One past the newest segment drawn
+    bool drawnAll = false;
+    lv_color_t shades[BANDS];
+    lv_color_t gridColor;
+    lv_color_t edgeColor;
+    Stats stats;
+
+    bool allocate();
+    lv_coord_t toPixels(float g) const;
+    uint8_t bandOf(uint32_t segment, uint32_t now) const;
+
+    void pickColors();
+    bool colorsChanged() const;
+    void renderBackground();
+    void plotCircle(lv_coord_t radius, lv_color_t color, bool dotted);
+
+    /**
+     * Paint segment `segment` (from the point before it) with a 2 px
+     * brush: in `color`, or from the background if `restore`. With `match`
+     * set only pixels of that color change.
+     */
+    void stroke(uint32_t segment, const lv_color_t *match, lv_color_t color, bool restore);
+
+    void renderAll(uint32_t now);
+    void placeDot(uint32_t now);
+    void placeMarkers();
+
+public:
+    /**
+     * @param size     plot width and height in pixels
+     * @param rangeG   acceleration at the outer ring
+     * @param ringG    spacing of the dotted rings inside it
+     * @param trailMs  age at which the trail is gone
+     */
+    FrictionCircle(uint16_t size, float rangeG, float ringG, uint32_t trailMs)
+        : size(size), rangeG(rangeG), ringG(ringG), trailMs(trailMs)
+    {
+    }
+
+    /**
+     * Add a sample: right and forward positive. No LVGL calls.
+     */
+    void add(float lateralG, float longitudinalG, uint32_t now);
+
+    /**
+     * Start the peaks over. The markers go at the next sync(). No LVGL calls.
+     */
+    void resetPeaks() { peaks = Peaks(); }
+
+    /**
+     * Create the plot on `parent` at (x, y), then the dot and the peak
+     * markers over it.
+     * @return false if there is no PSRAM for the buffers
+     */
+    bool create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y);
+
+    /**
+     * Forget the LVGL objects. Call before the parent is cleaned.
+     */
+    void release();
+
+    /**
+     * Draw what changed since the last call. Display task, while the plot
+     * is created.
+     */
+    void sync(uint32_t now);
+
+    /**
+     * Time until the oldest segment on screen changes shade, to schedule
+     * the next sync while the trail fades out.
+     * @return 0 if the trail is gone
+     */
+    uint32_t msToNextFade(uint32_t now) const;
+
+    const Peaks &getPeaks() const { return peaks; }
+    const Stats &getStats() const { return stats; }
+};
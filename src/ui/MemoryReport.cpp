@@ -0,0 +1,138 @@
+#include "MemoryReport.h"
+#include "FrameProfiler.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+namespace MemoryReport
+{
+    /**
+     * Render times recorded under one placement.
+     * Snapshotted from the profiler when the placement is changed.
+     */
+    struct Timing
+    {
+        uint32_t frames = 0;
+        uint32_t drawAvgUs = 0;
+        uint32_t drawP95Us = 0;
+        uint32_t frameAvgUs = 0;
+        uint32_t frameP95Us = 0;
+    };
+
+    static Timing timings[TIERED_PLACEMENT_COUNT];
+
+    static Timing currentTiming()
+    {
+        Timing t;
+#if FRAME_PROFILER
+        const FrameProfiler &profiler = FrameProfiler::getInstance();
+        const Histogram &draw = profiler.getHistogram(Stage::Draw);
+        const Histogram &frame = profiler.getHistogram(Stage::Frame);
+        t.frames = frame.count;
+        t.drawAvgUs = draw.average();
+        t.drawP95Us = draw.percentile(95);
+        t.frameAvgUs = frame.average();
+        t.frameP95Us = frame.percentile(95);
+#endif
+        return t;
+    }
+
+    static void printClasses(const tiered_stats_t &stats)
+    {
+        Serial.println("[Memory] class   blocks  in use    peak      hits  misses  waste");
+        for (int i = 0; i < TIERED_ALLOC_CLASS_COUNT; i++)
+        {
+            const tiered_class_stats_t &c = stats.classes[i];
+            // Internal fragmentation: bytes handed out but not asked for
+            uint32_t held = c.in_use * c.block_size;
+            uint32_t waste = held ? 100 - (100 * c.requested_in_use) / held : 0;
+            Serial.printf("[Memory] %5u %8u %7lu %7lu %9lu %7lu %5lu%%\n",
+                          c.block_size, c.blocks, (unsigned long)c.in_use, (unsigned long)c.peak,
+                          (unsigned long)c.hits, (unsigned long)c.misses, (unsigned long)waste);
+        }
+    }
+
+    static void printHeaps(const tiered_stats_t &stats)
+    {
+        Serial.printf("[Memory] LVGL heap: internal %lu allocs / %lu bytes, PSRAM %lu allocs / %lu bytes, %lu failed\n",
+                      (unsigned long)stats.internal_allocs, (unsigned long)stats.internal_bytes,
+                      (unsigned long)stats.psram_allocs, (unsigned long)stats.psram_bytes,
+                      (unsigned long)stats.failures);
+
+        // External fragmentation: how much of the free SRAM is unusable as one block
+        size_t freeInternal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        size_t largestInternal = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        uint32_t fragmentation = freeInternal ? 100 - (100 * largestInternal) / freeInternal : 0;
+        Serial.printf("[Memory] Internal SRAM free %u bytes, largest block %u bytes (%lu%% fragmented)\n",
+                      (unsigned)freeInternal, (unsigned)largestInternal, (unsigned long)fragmentation);
+        Serial.printf("[Memory] PSRAM free %u bytes\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+
+        lv_disp_t *disp = lv_disp_get_default();
+        if (disp != nullptr)
+        {
+            uint32_t px = disp->driver->draw_buf->size;
+            Serial.printf("[Memory] Draw buffer %lu px x %u bytes (%s) = %lu bytes\n", (unsigned long)px,
+                          (unsigned)sizeof(lv_color_t), LV_COLOR_DEPTH == 8 ? "RGB332" : "RGB565",
+                          (unsigned long)(px * sizeof(lv_color_t)));
+        }
+    }
+
+    static void printTimings()
+    {
+#if FRAME_PROFILER
+        tiered_placement_t active = tiered_get_placement();
+        Serial.println("[Memory] placement   frames   draw avg/p95 us   frame avg/p95 us");
+        for (int i = 0; i < TIERED_PLACEMENT_COUNT; i++)
+        {
+            tiered_placement_t placement = (tiered_placement_t)i;
+            const Timing t = placement == active ? currentTiming() : timings[i];
+            if (t.frames == 0)
+            {
+                continue;
+            }
+            Serial.printf("[Memory] %-9s%c %8lu %8lu/%-8lu %9lu/%-8lu\n",
+                          tiered_placement_name(placement), placement == active ? '*' : ' ',
+                          (unsigned long)t.frames, (unsigned long)t.drawAvgUs, (unsigned long)t.drawP95Us,
+                          (unsigned long)t.frameAvgUs, (unsigned long)t.frameP95Us);
+        }
+#else
+        Serial.println("[Memory] Render times need the profiler (FRAME_PROFILER=1)");
+#endif
+    }
+
+    void print()
+    {
+        tiered_stats_t stats;
+        tiered_get_stats(&stats);
+
+        Serial.printf("[Memory] Placement: %s\n", tiered_placement_name(tiered_get_placement()));
+        printClasses(stats);
+        printHeaps(stats);
+        printTimings();
+    }
+
+    void setPlacement(tiered_placement_t placement)
+    {
+        timings[tiered_get_placement()] = currentTiming();
+        tiered_set_placement(placement);
+        tiered_reset_counters();
+#if FRAME_PROFILER
+        // Start the new placement's render times from a clean slate
+        FrameProfiler::getInstance().requestReset();
+#endif
+        Serial.printf("[Memory] Placement set to %s (applies to new allocations)\n",
+                      tiered_placement_name(placement));
+    }
+
+    bool parsePlacement(const char *name, tiered_placement_t &placement)
+    {
+        for (int i = 0; i < TIERED_PLACEMENT_COUNT; i++)
+        {
+            if (strcmp(name, tiered_placement_name((tiered_placement_t)i)) == 0)
+            {
+                placement = (tiered_placement_t)i;
+                return true;
+            }
+        }
+        return false;
+    }
+}
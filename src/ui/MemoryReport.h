@@ -0,0 +1,20 @@
+#pragma once
+#include "lvgl/tiered_alloc.h"
+
+/**
+ * LVGL heap placement report.
+ * Prints the tiered allocator's per-class counters and internal heap
+ * fragmentation, and compares render times measured by the frame profiler
+ * under each placement policy ("mem tiered|psram|internal" on serial).
+ */
+namespace MemoryReport
+{
+    // Print pool, heap and render time figures
+    void print();
+
+    // Record render times for the current placement, then switch to another
+    void setPlacement(tiered_placement_t placement);
+
+    // Parse a placement name ("tiered", "psram", "internal"), false if unknown
+    bool parsePlacement(const char *name, tiered_placement_t &placement);
+}
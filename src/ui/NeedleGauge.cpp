@@ -0,0 +1,141 @@
+#include "NeedleGauge.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+bool NeedleGauge::create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y, Theme::Tone tone)
+{
+    if (buffer == nullptr && !build())
+    {
+        return false;
+    }
+
+    pivotX = x;
+    pivotY = y;
+    shown = -1;
+
+    // The sprites are coverage only; the tone's image recolor is the needle color
+    image = lv_img_create(parent);
+    lv_obj_clear_flag(image, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    Theme::apply(image, tone);
+    lv_obj_set_style_img_recolor_opa(image, LV_OPA_COVER, 0);
+    setPosition(0.0f);
+    return true;
+}
+
+void NeedleGauge::release()
+{
+    // Deleted with the parent's other children
+    image = nullptr;
+    shown = -1;
+}
+
+void NeedleGauge::setPosition(float fraction)
+{
+    if (image == nullptr)
+    {
+        return;
+    }
+
+    fraction = fraction < 0.0f ? 0.0f : fraction > 1.0f ? 1.0f : fraction;
+    int16_t step = (int16_t)(fraction * (STEPS - 1) + 0.5f);
+    if (step == shown)
+    {
+        return;
+    }
+
+    // Both invalidate the old box and the new one
+    const Sprite &sprite = sprites[step];
+    lv_img_set_src(image, &sprite.dsc);
+    lv_obj_set_pos(image, pivotX + sprite.x, pivotY + sprite.y);
+    shown = step;
+    stats.moves++;
+}
+
+// ============================================================================
+// SPRITES
+// ============================================================================
+void NeedleGauge::direction(uint16_t step, float &x, float &y) const
+{
+    float angle = (startAngle + (float)sweepAngle * step / (STEPS - 1)) * (float)M_PI / 180.0f;
+    x = cosf(angle);
+    y = sinf(angle);
+}
+
+uint8_t NeedleGauge::coverage(float x, float y, float dirX, float dirY) const
+{
+    // Nearest point on the needle's axis, and the needle's half width there
+    float t = (x * dirX + y * dirY) / length;
+    t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+    float axis = t * length;
+    float half = BASE_HALF_WIDTH + (TIP_HALF_WIDTH - BASE_HALF_WIDTH) * t;
+
+    // Distance inside the edge, plus half a pixel: one pixel of anti-aliasing
+    float needle = half - hypotf(x - axis * dirX, y - axis * dirY) + 0.5f;
+    float hub = HUB_RADIUS - hypotf(x, y) + 0.5f;
+    float c = needle > hub ? needle : hub;
+    return c <= 0.0f ? 0 : c >= 1.0f ? 255 : (uint8_t)(c * 255.0f + 0.5f);
+}
+
+bool NeedleGauge::build()
+{
+    int64_t start = esp_timer_get_time();
+    float reach = BASE_HALF_WIDTH > HUB_RADIUS ? BASE_HALF_WIDTH : HUB_RADIUS;
+
+    // Boxes first, so the sprites share one allocation
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < STEPS; i++)
+    {
+        float dirX, dirY;
+        direction(i, dirX, dirY);
+
+        // From the hub to the tip
+        float tipX = dirX * length;
+        float tipY = dirY * length;
+        lv_coord_t x1 = (lv_coord_t)floorf(LV_MIN(tipX, 0.0f) - reach);
+        lv_coord_t y1 = (lv_coord_t)floorf(LV_MIN(tipY, 0.0f) - reach);
+        lv_coord_t x2 = (lv_coord_t)ceilf(LV_MAX(tipX, 0.0f) + reach);
+        lv_coord_t y2 = (lv_coord_t)ceilf(LV_MAX(tipY, 0.0f) + reach);
+
+        Sprite &sprite = sprites[i];
+        sprite.x = x1;
+        sprite.y = y1;
+        sprite.dsc.header.always_zero = 0;
+        sprite.dsc.header.cf = LV_IMG_CF_ALPHA_8BIT;
+        sprite.dsc.header.w = x2 - x1 + 1;
+        sprite.dsc.header.h = y2 - y1 + 1;
+        sprite.dsc.data_size = sprite.dsc.header.w * sprite.dsc.header.h;
+        total += sprite.dsc.data_size;
+    }
+
+    buffer = (uint8_t *)heap_caps_malloc(total, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buffer == nullptr)
+    {
+        Serial.printf("NeedleGauge: Cannot allocate %lu bytes of PSRAM for the needle\n", (unsigned long)total);
+        return false;
+    }
+
+    uint8_t *out = buffer;
+    for (uint16_t i = 0; i < STEPS; i++)
+    {
+        Sprite &sprite = sprites[i];
+        sprite.dsc.data = out;
+        float dirX, dirY;
+        direction(i, dirX, dirY);
+        for (int32_t row = 0; row < sprite.dsc.header.h; row++)
+        {
+            for (int32_t col = 0; col < sprite.dsc.header.w; col++)
+            {
+                *out++ = coverage(sprite.x + col, sprite.y + row, dirX, dirY);
+            }
+        }
+
+        stats.maxWidth = LV_MAX(stats.maxWidth, sprite.dsc.header.w);
+        stats.maxHeight = LV_MAX(stats.maxHeight, sprite.dsc.header.h);
+    }
+
+    stats.bytes = total;
+    stats.buildUs = esp_timer_get_time() - start;
+    Serial.printf("NeedleGauge: %u sprites, %lu bytes PSRAM, built in %lu us\n", STEPS, (unsigned long)total,
+                  (unsigned long)stats.buildUs);
+    return true;
+}
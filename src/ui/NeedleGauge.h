@@ -0,0 +1,104 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "Theme.h"
+
+/**
+ * Analog gauge needle drawn from pre-rendered sprites.
+ *
+ * Rotating a needle with lv_meter or a transformed image runs anti-aliased
+ * line or rotation math over the needle's box every frame. Here the needle
+ * (a tapered bar with round ends and a hub disc) is rasterized once per
+ * angle step into an A8 coverage sprite in PSRAM, trimmed to its own box.
+ * Moving the needle swaps the image source and position, so a frame costs
+ * the old box restored from whatever is behind it (the page's StaticLayer
+ * for a dial face) plus one masked fill of the new sprite in the tone's
+ * color. LVGL draws A8 images straight through the blend, with no
+ * decoding and no cache.
+ *
+ * STEPS sprites cover the sweep, about 1.5 degrees apart on a 270 degree
+ * dial, under three pixels at the tip of a 100 px needle; for that needle
+ * they take about 1 MB of PSRAM. They are built at the first create() and
+ * kept for the run; a released page rebuilds only its image object.
+ */
+class NeedleGauge
+{
+public:
+    static constexpr uint16_t STEPS = 181;
+
+    struct Stats
+    {
+        uint32_t bytes = 0;   // PSRAM held by the sprites
+        uint32_t buildUs = 0; // Time rasterizing them
+        uint16_t maxWidth = 0;
+        uint16_t maxHeight = 0;
+        uint32_t moves = 0;   // Step changes shown
+    };
+
+private:
+    /**
+     * One angle step: the sprite and its top-left corner from the pivot.
+     */
+    struct Sprite
+    {
+        lv_img_dsc_t dsc;
+        int16_t x;
+        int16_t y;
+    };
+
+    // Shape, in pixels
+    static constexpr float BASE_HALF_WIDTH = 3.5f;
+    static constexpr float TIP_HALF_WIDTH = 1.2f;
+    static constexpr float HUB_RADIUS = 9.0f;
+
+    uint16_t startAngle; // LVGL degrees: 0 = 3 o'clock, clockwise
+    uint16_t sweepAngle;
+    lv_coord_t length;   // Pivot to tip
+
+    Sprite sprites[STEPS];
+    uint8_t *buffer = nullptr;
+    lv_obj_t *image = nullptr;
+    lv_coord_t pivotX = 0;
+    lv_coord_t pivotY = 0;
+    int16_t shown = -1; // Step on screen, -1 = none yet
+    Stats stats;
+
+    bool build();
+
+    /**
+     * Unit vector a step's needle points along, y down.
+     */
+    void direction(uint16_t step, float &x, float &y) const;
+
+    /**
+     * Needle and hub coverage, 0-255, of the pixel centred at (x, y) from
+     * the pivot, for a needle pointing along (dirX, dirY).
+     */
+    uint8_t coverage(float x, float y, float dirX, float dirY) const;
+
+public:
+    NeedleGauge(uint16_t startAngle, uint16_t sweepAngle, lv_coord_t length)
+        : startAngle(startAngle), sweepAngle(sweepAngle), length(length)
+    {
+    }
+
+    /**
+     * Create the needle image on `parent` with its pivot at (x, y), in the
+     * color of `tone`, building the sprites if this is the first time.
+     * Create it after the dial face so it draws on top.
+     * @return false if there is no PSRAM for the sprites
+     */
+    bool create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y, Theme::Tone tone);
+
+    /**
+     * Forget the image object. Call before the parent is cleaned.
+     */
+    void release();
+
+    /**
+     * Point the needle at a fraction of the sweep, 0 (start) to 1 (end).
+     */
+    void setPosition(float fraction);
+
+    const Stats &getStats() const { return stats; }
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <lvgl.h>
+#include "StaticLayer.h"
 
 /**
  * Base class for all display pages.
@@ -8,13 +9,25 @@
  * To create a new page:
  * 1. Create a new .h/.cpp file in the pages/ folder
  * 2. Inherit from Page and implement create() and optionally update()
- * 3. Add the page to the pages array in PageManager.cpp
+ * 3. Add a HUD_PAGE line to PageRegistry.h and include the header in PageManager.cpp
+ *
+ * Widgets that never change after create() can be passed to markStatic()
+ * so they are drawn from the page's StaticLayer instead of live.
  */
 class Page
 {
 protected:
     lv_obj_t *tile = nullptr; // The tile object for this page
     const char *name;         // Page name for debugging
+    bool created = false;     // UI elements currently exist on the tile
+    StaticLayer staticLayer;  // Pre-rendered static widgets
+
+    /**
+     * Declare a widget created in create() as static: fixed text, position
+     * and style. It is drawn once into the page's background layer, behind
+     * every live widget, so it must not overlap a widget created before it.
+     */
+    void markStatic(lv_obj_t *obj) { StaticLayer::markStatic(obj); }
 
 public:
     Page(const char *pageName) : name(pageName) {}
@@ -40,20 +53,105 @@ public:
      */
     const char *getName() const { return name; }
 
+    /**
+     * Check if the page's UI elements currently exist.
+     */
+    bool isCreated() const { return created; }
+
+    /**
+     * Build the UI if it isn't already. Called by PageManager.
+     */
+    void build()
+    {
+        if (!created)
+        {
+            create();
+            created = true;
+            staticLayer.refresh(tile);
+        }
+    }
+
+    /**
+     * Delete the UI elements but keep the tile and the page's model state.
+     * Called by PageManager for pages far from the visible one.
+     */
+    void release()
+    {
+        if (created)
+        {
+            onRelease();
+            staticLayer.release();
+            lv_obj_clean(tile);
+            created = false;
+        }
+    }
+
+    /**
+     * Re-bake the static layer if it went stale, or drop it if layers were
+     * switched off. Called by PageManager while the tiles are not moving.
+     */
+    void refreshStaticLayer()
+    {
+        if (created)
+        {
+            staticLayer.refresh(tile);
+        }
+    }
+
+    const StaticLayer &getStaticLayer() const { return staticLayer; }
+
+    /**
+     * Pages whose readout must hold its frame deadline. RenderGovernor never
+     * throttles them and counts frames over budget while they are visible.
+     */
+    virtual bool isCritical() const { return false; }
+
+    /**
+     * Shortest frame period the page wants while visible, below the
+     * activity state's refresh cap (0 = the state's cap).
+     */
+    virtual uint32_t getFrameIntervalMs() const { return 0; }
+
+    /**
+     * Screen area worth keeping lit while parked with the panel in partial
+     * mode (the clock, say), in screen coordinates.
+     * @return false if the page has nothing to show there
+     */
+    virtual bool getParkedArea(lv_area_t & /*area*/) const { return false; }
+
+    /**
+     * Print the page's own figures on serial ("page <name>").
+     */
+    virtual void printStats() {}
+
     /**
      * Create the UI elements for this page.
-     * Called once during initialization after the tile is set.
+     * Called after the tile is set, and again if the page was released.
      * Must be implemented by each page.
      */
     virtual void create() = 0;
 
+    /**
+     * Called just before the page's LVGL objects are deleted.
+     * Override to drop bindings and handles that point at them.
+     */
+    virtual void onRelease() {}
+
     /**
      * Update the page with new data.
-     * Called periodically from the main loop.
+     * Called periodically from the main loop, only while the page is
+     * visible and created.
      * Override this if your page needs dynamic updates.
      */
     virtual void update() {}
 
+    /**
+     * Keep model state current while the page is not visible.
+     * Called every update, created or not, for pages registered with
+     * backgroundWork set - must not touch LVGL objects.
+     */
+    virtual void backgroundUpdate() {}
+
     /**
      * Called when this page becomes visible (user swipes to it).
      * Override to perform actions when page is shown.
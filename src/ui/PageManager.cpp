@@ -1,54 +1,82 @@
 #include "PageManager.h"
+#include "DrawUnit.h"
+#include "FontResidency.h"
+#include "FrameScheduler.h"
+#include "PowerEstimator.h"
+#include "RenderGovernor.h"
+#include "StaticLayer.h"
+#include "Theme.h"
+#include "lvgl/tiered_alloc.h"
 #include <Arduino.h>
+#include <esp_timer.h>
 
 // Include all page headers here
 #include "pages/SpeedPage.h"
+#include "pages/GaugePage.h"
 #include "pages/StatsPage.h"
+#include "pages/HistoryPage.h"
+#include "pages/GForcePage.h"
 #include "pages/InfoPage.h"
 
+// Page objects live for the whole run, whether or not their UI is built
+namespace
+{
+#define HUD_PAGE(type, object, interval, background) type object;
+    HUD_PAGES
+#undef HUD_PAGE
+}
+
+const PageManager::PageInfo PageManager::PAGES[PAGE_COUNT] = {
+#define HUD_PAGE(type, object, interval, background) {&object, interval, background},
+    HUD_PAGES
+#undef HUD_PAGE
+};
+
 // Singleton instance
-PageManager *PageManager::instance = nullptr;
+PageManager PageManager::instance;
 
-PageManager &PageManager::getInstance()
+// LVGL heap currently handed out, across the pools and both heaps
+static uint32_t lvglBytesInUse()
 {
-    if (instance == nullptr)
+    tiered_stats_t stats;
+    tiered_get_stats(&stats);
+
+    uint32_t bytes = stats.internal_bytes + stats.psram_bytes;
+    for (const tiered_class_stats_t &pool : stats.classes)
     {
-        instance = new PageManager();
+        bytes += pool.in_use * pool.block_size;
     }
-    return *instance;
+    return bytes;
 }
 
-void PageManager::init()
+static uint32_t countObjects(lv_obj_t *obj)
 {
-    // ============================================
-    // ADD YOUR PAGES HERE
-    // Pages will appear in the order they are added
-    // ============================================
-
-    addPage(new SpeedPage());
-    addPage(new StatsPage());
-    addPage(new InfoPage());
+    uint32_t count = 0;
+    uint32_t children = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        count += 1 + countObjects(lv_obj_get_child(obj, i));
+    }
+    return count;
+}
 
-    // ============================================
-    // Create all the pages
-    createPages();
+PageManager &PageManager::getInstance()
+{
+    return instance;
 }
 
-void PageManager::addPage(Page *page)
+void PageManager::init()
 {
-    pages.push_back(page);
-    Serial.printf("PageManager: Registered page '%s' at index %d\n",
-                  page->getName(), pages.size() - 1);
+    // Pages are listed in PageRegistry.h
+    static_assert(PAGE_COUNT > 0, "No pages registered in PageRegistry.h");
+
+    // Shared styles must exist before any page builds
+    Theme::init();
+    createPages();
 }
 
 void PageManager::createPages()
 {
-    if (pages.empty())
-    {
-        Serial.println("PageManager: No pages registered!");
-        return;
-    }
-
     // Create tileview container
     tileview = lv_tileview_create(lv_scr_act());
     lv_obj_set_style_bg_color(tileview, lv_color_black(), 0);
@@ -56,8 +84,12 @@ void PageManager::createPages()
     // Add event callback for tile changes
     lv_obj_add_event_cb(tileview, tileChangeCallback, LV_EVENT_VALUE_CHANGED, this);
 
+    // Run at full frame rate while the tiles are moving
+    lv_obj_add_event_cb(tileview, scrollCallback, LV_EVENT_SCROLL_BEGIN, nullptr);
+    lv_obj_add_event_cb(tileview, scrollCallback, LV_EVENT_SCROLL_END, nullptr);
+
     // Create tiles for each page
-    for (size_t i = 0; i < pages.size(); i++)
+    for (int i = 0; i < PAGE_COUNT; i++)
     {
         // Determine swipe directions based on position
         lv_dir_t dirs = LV_DIR_NONE;
@@ -66,7 +98,7 @@ void PageManager::createPages()
         {
             dirs |= LV_DIR_LEFT; // Can swipe left to go to previous
         }
-        if (i < pages.size() - 1)
+        if (i < PAGE_COUNT - 1)
         {
             dirs |= LV_DIR_RIGHT; // Can swipe right to go to next
         }
@@ -74,21 +106,117 @@ void PageManager::createPages()
         // Create the tile
         lv_obj_t *tile = lv_tileview_add_tile(tileview, i, 0, dirs);
 
-        // Assign tile to page and create its UI
-        pages[i]->setTile(tile);
-        pages[i]->create();
+        // Tiles remember their page index so tile changes need no search
+        lv_obj_set_user_data(tile, (void *)(intptr_t)i);
+
+        // Assign tile to page - the UI is built when the page comes into range
+        PAGES[i].page->setTile(tile);
 
-        Serial.printf("PageManager: Created page '%s' at position %d\n",
-                      pages[i]->getName(), i);
+        Serial.printf("PageManager: Registered page '%s' at index %d\n", PAGES[i].page->getName(), i);
     }
 
+    // Only the first page is needed for the first frame; idleWork() builds the rest
+    buildPage(currentPageIndex);
+    builtAtBoot = 1;
+
     // Notify first page that it's visible
-    if (!pages.empty())
+    PAGES[currentPageIndex].page->onEnter();
+    FrameScheduler::getInstance().setPageFrameInterval(PAGES[currentPageIndex].page->getFrameIntervalMs());
+
+    Serial.printf("PageManager: Initialized with %d pages\n", PAGE_COUNT);
+}
+
+void PageManager::buildPage(int index)
+{
+    Page *page = PAGES[index].page;
+    if (page->isCreated())
+    {
+        return;
+    }
+
+    PageStats &stats = pageStats[index];
+    uint32_t bytesBefore = lvglBytesInUse();
+    int64_t start = esp_timer_get_time();
+
+    page->build();
+
+    stats.buildUs = esp_timer_get_time() - start;
+    stats.bytes = lvglBytesInUse() - bytesBefore;
+    stats.objects = countObjects(page->getTile());
+    stats.builds++;
+    stats.lastInRange = millis();
+
+    Serial.printf("PageManager: Built page '%s' in %lu us (%lu objects, %lu bytes)\n", page->getName(),
+                  (unsigned long)stats.buildUs, (unsigned long)stats.objects, (unsigned long)stats.bytes);
+}
+
+void PageManager::releasePage(int index)
+{
+    Page *page = PAGES[index].page;
+    if (!page->isCreated())
+    {
+        return;
+    }
+
+    uint32_t bytesBefore = lvglBytesInUse();
+    page->release();
+    pageStats[index].releases++;
+
+    Serial.printf("PageManager: Released page '%s' (%lu bytes freed)\n", page->getName(),
+                  (unsigned long)(bytesBefore - lvglBytesInUse()));
+}
+
+void PageManager::buildNeighbours()
+{
+    for (int i = currentPageIndex - RESIDENT_DISTANCE; i <= currentPageIndex + RESIDENT_DISTANCE; i++)
+    {
+        if (i >= 0 && i < PAGE_COUNT)
+        {
+            buildPage(i);
+        }
+    }
+}
+
+void PageManager::idleWork()
+{
+    // Tiles are covered by snapshots until the swipe ends; an overloaded
+    // display task builds nothing it does not have to
+    if (transition.isActive() || RenderGovernor::getInstance().atLeast(Quality::FreezeSecondary))
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+
+    // Build the nearest missing page in range - one per call so a frame never
+    // waits on more than one create()
+    for (int distance = 0; distance <= RESIDENT_DISTANCE; distance++)
     {
-        pages[0]->onEnter();
+        for (int index : {currentPageIndex - distance, currentPageIndex + distance})
+        {
+            if (index >= 0 && index < PAGE_COUNT && !PAGES[index].page->isCreated())
+            {
+                buildPage(index);
+                // Come straight back for the next one
+                FrameScheduler::getInstance().requestUpdate(0);
+                return;
+            }
+        }
     }
 
-    Serial.printf("PageManager: Initialized with %d pages\n", pages.size());
+    // Release one page that has been out of range for long enough
+    for (int i = 0; i < PAGE_COUNT; i++)
+    {
+        if (inRange(i))
+        {
+            pageStats[i].lastInRange = now;
+        }
+        else if (PAGES[i].page->isCreated() && now - pageStats[i].lastInRange >= RELEASE_DELAY_MS)
+        {
+            releasePage(i);
+            return;
+        }
+    }
 }
 
 void PageManager::tileChangeCallback(lv_event_t *e)
@@ -96,55 +224,237 @@ void PageManager::tileChangeCallback(lv_event_t *e)
     PageManager *manager = static_cast<PageManager *>(lv_event_get_user_data(e));
     lv_obj_t *tileview = lv_event_get_target(e);
 
-    // Get the current tile
-    lv_obj_t *currentTile = lv_tileview_get_tile_act(tileview);
+    // The tile carries its page index
+    int index = (intptr_t)lv_obj_get_user_data(lv_tileview_get_tile_act(tileview));
+    if (index == manager->currentPageIndex)
+    {
+        return;
+    }
+
+    // Normally built already, unless the swipe outran idleWork()
+    manager->buildPage(index);
 
-    // Find which page index this corresponds to
-    for (size_t i = 0; i < manager->pages.size(); i++)
+    // Notify old page it's exiting
+    PAGES[manager->currentPageIndex].page->onExit();
+
+    // Update current index, and update the new page straight away
+    manager->currentPageIndex = index;
+    manager->lastPageUpdate = 0;
+
+    // Notify new page it's entering
+    PAGES[index].page->onEnter();
+    FrameScheduler::getInstance().setPageFrameInterval(PAGES[index].page->getFrameIntervalMs());
+
+    Serial.printf("PageManager: Switched to page '%s' (index %d)\n", PAGES[index].page->getName(), index);
+}
+
+void PageManager::scrollCallback(lv_event_t *e)
+{
+    bool begin = lv_event_get_code(e) == LV_EVENT_SCROLL_BEGIN;
+
+    // Whichever way the swipe goes, the tile sliding in must have its UI
+    if (begin)
+    {
+        getInstance().buildNeighbours();
+        getInstance().beginTransition();
+    }
+    else
     {
-        if (manager->pages[i]->getTile() == currentTile)
+        getInstance().transition.end();
+    }
+    FrameScheduler::getInstance().setSwiping(begin);
+}
+
+void PageManager::beginTransition()
+{
+    // Built pages, nearest to the visible one first
+    lv_obj_t *tiles[SnapshotTransition::MAX_TILES];
+    int count = 0;
+    for (int distance = 0; distance < PAGE_COUNT && count < SnapshotTransition::MAX_TILES; distance++)
+    {
+        for (int index : {currentPageIndex - distance, currentPageIndex + distance})
         {
-            if (manager->currentPageIndex != (int)i)
+            if (index >= 0 && index < PAGE_COUNT && PAGES[index].page->isCreated() &&
+                count < SnapshotTransition::MAX_TILES)
             {
-                // Notify old page it's exiting
-                manager->pages[manager->currentPageIndex]->onExit();
+                tiles[count++] = PAGES[index].page->getTile();
+            }
+            if (distance == 0)
+            {
+                break;
+            }
+        }
+    }
+    transition.begin(tiles, count);
+}
 
-                // Update current index
-                manager->currentPageIndex = i;
+void PageManager::update()
+{
+    // Palette and font placement switches asked for from the serial console
+    Theme::applyRequestedMode();
+    FontResidency::applyRequested();
+    StaticLayer::applyRequested();
+    RenderGovernor &governor = RenderGovernor::getInstance();
+    governor.applyRequested();
+    PowerEstimator::getInstance().update();
+    sampleDrawTime();
 
-                // Notify new page it's entering
-                manager->pages[i]->onEnter();
+    // Static layers follow palette, font and on/off switches (not under a swipe snapshot)
+    if (!transition.isActive())
+    {
+        for (const PageInfo &info : PAGES)
+        {
+            info.page->refreshStaticLayer();
+        }
+    }
 
-                Serial.printf("PageManager: Switched to page '%s' (index %d)\n",
-                              manager->pages[i]->getName(), i);
-            }
-            break;
+    // Model state is kept current for pages that track it, built or not
+    for (const PageInfo &info : PAGES)
+    {
+        if (info.backgroundWork)
+        {
+            info.page->backgroundUpdate();
         }
     }
+
+    // UI updates only for the current page, for performance
+    const PageInfo &current = PAGES[currentPageIndex];
+    if (!current.page->isCreated())
+    {
+        return;
+    }
+
+    // Secondary pages hold their last values while the governor has them frozen
+    if (governor.atLeast(Quality::FreezeSecondary) && !current.page->isCritical())
+    {
+        return;
+    }
+
+    // Rate-limited pages come back once their interval is up so the latest data shows
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastPageUpdate;
+    uint32_t interval = governor.scaleInterval(current.updateIntervalMs);
+    if (interval > 0 && lastPageUpdate != 0 && elapsed < interval)
+    {
+        FrameScheduler::getInstance().requestUpdate(interval - elapsed);
+        return;
+    }
+
+    lastPageUpdate = now;
+    current.page->update();
 }
 
-void PageManager::update()
+void PageManager::sampleDrawTime()
 {
-    // Update only the current page for performance
-    if (currentPageIndex >= 0 && currentPageIndex < (int)pages.size())
+#if FRAME_PROFILER
+    // One sample per rendered frame, credited to the page it showed
+    FrameProfiler &profiler = FrameProfiler::getInstance();
+    uint32_t frames = profiler.getFrameCount();
+    if (frames == lastFrameCount)
+    {
+        return;
+    }
+    lastFrameCount = frames;
+
+    // Swipe frames draw two tiles (or snapshots) and belong to no page
+    if (!FrameScheduler::getInstance().isSwiping() && !transition.isActive())
     {
-        pages[currentPageIndex]->update();
+        uint32_t drawUs = profiler.getLastFrameUs(Stage::Draw);
+        pageStats[currentPageIndex].drawUs[StaticLayer::isEnabled()].add(drawUs);
+        pageStats[currentPageIndex].drawUnitUs[DrawUnit::getInstance().isEnabled()].add(drawUs);
     }
+#endif
 }
 
 Page *PageManager::getPage(int index)
 {
-    if (index >= 0 && index < (int)pages.size())
+    if (index >= 0 && index < PAGE_COUNT)
+    {
+        return PAGES[index].page;
+    }
+    return nullptr;
+}
+
+void PageManager::goToPage(int index, bool animate)
+{
+    if (index >= 0 && index < PAGE_COUNT && tileview != nullptr)
+    {
+        // Build every page the scroll animation passes over
+        int step = index < currentPageIndex ? -1 : 1;
+        for (int i = currentPageIndex; i != index + step; i += step)
+        {
+            buildPage(i);
+        }
+
+        // Tile positions are only known once the tileview has been laid out
+        lv_obj_update_layout(tileview);
+        bool scroll = animate && !RenderGovernor::getInstance().atLeast(Quality::NoAnimations);
+        lv_obj_set_tile(tileview, PAGES[index].page->getTile(), scroll ? LV_ANIM_ON : LV_ANIM_OFF);
+    }
+}
+
+Page *PageManager::findPage(const char *name)
+{
+    for (const PageInfo &info : PAGES)
     {
-        return pages[index];
+        if (strcasecmp(info.page->getName(), name) == 0)
+        {
+            return info.page;
+        }
     }
     return nullptr;
 }
 
-void PageManager::goToPage(int index)
+void PageManager::printStats()
+{
+    Serial.printf("PageManager: First frame %lu ms after boot, %d of %d pages built for it\n",
+                  (unsigned long)FrameScheduler::getInstance().getFirstFrameMs(), builtAtBoot, PAGE_COUNT);
+
+    uint32_t residentBytes = 0;
+    int resident = 0;
+    Serial.println("  page          state     objects   bytes  build us  builds  releases");
+    for (int i = 0; i < PAGE_COUNT; i++)
+    {
+        const PageStats &stats = pageStats[i];
+        bool created = PAGES[i].page->isCreated();
+        const char *state = i == currentPageIndex ? "visible"
+                            : created                  ? "built"
+                            : stats.builds > 0         ? "released"
+                                                       : "unbuilt";
+        Serial.printf("  %-12s  %-8s  %7lu  %6lu  %8lu  %6lu  %8lu\n", PAGES[i].page->getName(), state,
+                      (unsigned long)stats.objects, (unsigned long)stats.bytes, (unsigned long)stats.buildUs,
+                      (unsigned long)stats.builds, (unsigned long)stats.releases);
+        if (created)
+        {
+            residentBytes += stats.bytes;
+            resident++;
+        }
+    }
+    Serial.printf("  %d pages resident, %lu bytes of LVGL heap\n", resident, (unsigned long)residentBytes);
+
+    const SnapshotTransition::Stats &swipes = transition.getStats();
+    Serial.printf("PageManager: Swipes on %s, %lu snapshot swipes (%lu tiles, avg %lu us, max %lu us to start), %lu left live\n",
+                  transition.isEnabled() ? "snapshots" : "live widgets", (unsigned long)swipes.transitions,
+                  (unsigned long)swipes.tiles,
+                  (unsigned long)(swipes.transitions ? swipes.snapshotUs / swipes.transitions : 0),
+                  (unsigned long)swipes.snapshotMaxUs, (unsigned long)swipes.fallbacks);
+}
+
+void PageManager::printLayers()
 {
-    if (index >= 0 && index < (int)pages.size() && tileview != nullptr)
+    Serial.printf("PageManager: Static layers %s\n", StaticLayer::isEnabled() ? "on" : "off");
+    Serial.println("  page          widgets    bytes  bakes  bake us  draw off avg/p95  draw on avg/p95");
+    for (int i = 0; i < PAGE_COUNT; i++)
     {
-        lv_obj_set_tile(tileview, pages[index]->getTile(), LV_ANIM_ON);
+        const StaticLayer::Stats &layer = PAGES[i].page->getStaticLayer().getStats();
+        const Histogram *draw = pageStats[i].drawUs;
+        Serial.printf("  %-12s  %7lu  %7lu  %5lu  %7lu  %7lu / %6lu  %6lu / %6lu\n", PAGES[i].page->getName(),
+                      (unsigned long)layer.objects, (unsigned long)layer.bytes, (unsigned long)layer.bakes,
+                      (unsigned long)layer.bakeUs, (unsigned long)draw[0].average(),
+                      (unsigned long)draw[0].percentile(95), (unsigned long)draw[1].average(),
+                      (unsigned long)draw[1].percentile(95));
     }
+#if !FRAME_PROFILER
+    Serial.println("  (draw times need FRAME_PROFILER)");
+#endif
 }
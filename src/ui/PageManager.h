@@ -1,26 +1,82 @@
 #pragma once
 #include <lvgl.h>
-#include <vector>
+#include <stdlib.h>
+#include "FrameProfiler.h"
 #include "Page.h"
+#include "PageRegistry.h"
+#include "SnapshotTransition.h"
 
 /**
  * PageManager handles the tileview and all registered pages.
  *
  * To add a new page:
  * 1. Create your page class inheriting from Page
- * 2. Add it to the pages vector in PageManager::init()
+ * 2. Add a HUD_PAGE line for it to PageRegistry.h
+ * 3. Include its header in PageManager.cpp
  *
- * The pages will be arranged horizontally in the order they are added.
+ * The pages are arranged horizontally in registry order. Page objects are
+ * statically allocated and each tile carries its page index in its user
+ * data, so nothing here touches the heap after boot.
+ *
+ * Every page gets its tile up front, but only the visible page is built at
+ * boot. Its neighbours are built one per idle frame, and pages more than
+ * RESIDENT_DISTANCE tiles from the visible one have their LVGL objects
+ * released after RELEASE_DELAY_MS. Page objects themselves (and their model
+ * state) live for the whole run.
  */
 class PageManager
 {
+public:
+    /**
+     * Registry entry for one page, generated from HUD_PAGES.
+     */
+    struct PageInfo
+    {
+        Page *page;
+        uint16_t updateIntervalMs; // 0 = update every display pass
+        bool backgroundWork;       // Has backgroundUpdate() work to run every pass
+    };
+
+    static constexpr int PAGE_COUNT = 0
+#define HUD_PAGE(type, object, interval, background) +1
+        HUD_PAGES
+#undef HUD_PAGE
+        ;
+
+    /**
+     * Build cost and residency figures for one page.
+     */
+    struct PageStats
+    {
+        uint32_t objects = 0;    // LVGL objects on the tile after the last build
+        uint32_t bytes = 0;      // LVGL heap the last build took
+        uint32_t buildUs = 0;    // Time the last build took
+        uint32_t builds = 0;
+        uint32_t releases = 0;
+        uint32_t lastInRange = 0; // millis() the page was last within RESIDENT_DISTANCE
+        Histogram drawUs[2];      // Draw time of settled frames showing the page, static layers off/on
+        Histogram drawUnitUs[2];  // The same, second draw unit off/on
+    };
+
 private:
+    // Pages this many tiles either side of the visible one are kept built
+    static constexpr int RESIDENT_DISTANCE = 1;
+
+    // How long a page must stay out of range before it is released
+    static constexpr uint32_t RELEASE_DELAY_MS = 5000;
+
+    static const PageInfo PAGES[PAGE_COUNT];
+
     lv_obj_t *tileview = nullptr;
-    std::vector<Page *> pages;
+    PageStats pageStats[PAGE_COUNT];
     int currentPageIndex = 0;
+    int builtAtBoot = 0;
+    uint32_t lastPageUpdate = 0; // millis() of the current page's last update() (0 = due now)
+    uint32_t lastFrameCount = 0; // Profiler frame count when the draw times were last sampled
+    SnapshotTransition transition;
 
     // Singleton instance
-    static PageManager *instance;
+    static PageManager instance;
 
     // Private constructor for singleton
     PageManager() = default;
@@ -28,6 +84,16 @@ private:
     // Callback for tile change events
     static void tileChangeCallback(lv_event_t *e);
 
+    // Callback for tileview scroll begin/end (drives the frame scheduler's swipe state)
+    static void scrollCallback(lv_event_t *e);
+
+    bool inRange(int index) const { return abs(index - currentPageIndex) <= RESIDENT_DISTANCE; }
+    void buildPage(int index);
+    void releasePage(int index);
+    void buildNeighbours();
+    void beginTransition();
+    void sampleDrawTime();
+
 public:
     // Get singleton instance
     static PageManager &getInstance();
@@ -43,32 +109,63 @@ public:
     void init();
 
     /**
-     * Register a page with the manager.
-     * Pages are added in order from left to right.
-     */
-    void addPage(Page *page);
-
-    /**
-     * Create the tileview and all registered pages.
-     * Call this after all pages have been added.
+     * Create the tileview, a tile per registered page, and the first page's UI.
      */
     void createPages();
 
     /**
-     * Update all pages (or just the current page for performance).
+     * Update every page's model state, then the visible page's UI.
      * Call this from the main loop.
      */
     void update();
 
+    /**
+     * Build or release at most one page. Call after the frame has been
+     * rendered, while the tiles are not moving.
+     */
+    void idleWork();
+
+    /**
+     * Get build and residency figures for a page.
+     */
+    const PageStats &getPageStats(int index) const { return pageStats[index]; }
+
+    /**
+     * Get how many pages were built before the first frame.
+     */
+    int getBuiltAtBoot() const { return builtAtBoot; }
+
+    /**
+     * Swipe on snapshots of the pages (default) or on the live widgets.
+     */
+    void setSnapshotTransitions(bool on) { transition.setEnabled(on); }
+    const SnapshotTransition &getTransition() const { return transition; }
+
+    /**
+     * Print boot time, per-page residency and swipe snapshot figures to serial.
+     */
+    void printStats();
+
+    /**
+     * Print each page's static layer and its draw times with layers off and on.
+     */
+    void printLayers();
+
     /**
      * Get a page by index.
      */
     Page *getPage(int index);
 
+    /**
+     * Get a page by name, ignoring case.
+     * @return nullptr if no page has that name
+     */
+    Page *findPage(const char *name);
+
     /**
      * Get the number of registered pages.
      */
-    int getPageCount() const { return pages.size(); }
+    int getPageCount() const { return PAGE_COUNT; }
 
     /**
      * Get the current page index.
@@ -77,6 +174,7 @@ public:
 
     /**
      * Navigate to a specific page by index.
+     * Pass animate = false to jump straight to it.
      */
-    void goToPage(int index);
+    void goToPage(int index, bool animate = true);
 };
@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * The HUD pages, in tile order from left to right.
+ *
+ * HUD_PAGE(Class, object, updateIntervalMs, backgroundWork)
+ *   Class            - Page subclass; its header is included by PageManager.cpp
+ *   object           - name of the statically allocated instance
+ *   updateIntervalMs - shortest gap between update() calls while visible
+ *                      (0 = every display pass)
+ *   backgroundWork   - call backgroundUpdate() every pass, on screen or not
+ *
+ * To add a page, add a line here and its include to PageManager.cpp.
+ */
+#define HUD_PAGES                                \
+    HUD_PAGE(SpeedPage, speedPage, 0, true)      \
+    HUD_PAGE(GaugePage, gaugePage, 0, false)     \
+    HUD_PAGE(StatsPage, statsPage, 100, false)   \
+    HUD_PAGE(HistoryPage, historyPage, 0, true)  \
+    HUD_PAGE(GForcePage, gforcePage, 0, true)    \
+    HUD_PAGE(InfoPage, infoPage, 250, false)
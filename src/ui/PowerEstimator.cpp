@@ -0,0 +1,362 @@
+#include "PowerEstimator.h"
+#include "FrameScheduler.h"
+#include "Theme.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+// Singleton instance
+PowerEstimator *PowerEstimator::instance = nullptr;
+
+volatile uint32_t PowerEstimator::requestedBudget = UINT32_MAX;
+volatile bool PowerEstimator::resetRequested = false;
+
+PowerEstimator &PowerEstimator::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new PowerEstimator();
+    }
+    return *instance;
+}
+
+bool PowerEstimator::begin(LilyGo_Display *panel)
+{
+    board = panel;
+
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == nullptr)
+    {
+        Serial.println("PowerEstimator: No display, panel power not estimated");
+        return false;
+    }
+
+    // One cell per sampled pixel; sampled every frame, so internal RAM
+    mapWidth = (lv_disp_get_hor_res(disp) + STEP - 1) / STEP;
+    mapHeight = (lv_disp_get_ver_res(disp) + STEP - 1) / STEP;
+    size_t mapBytes = mapWidth * mapHeight * sizeof(lv_color_t);
+    map = (lv_color_t *)heap_caps_malloc(mapBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (map == nullptr)
+    {
+        Serial.println("PowerEstimator: No memory for the emission map");
+        return false;
+    }
+    for (uint32_t i = 0; i < (uint32_t)mapWidth * mapHeight; i++)
+    {
+        map[i] = lv_color_black();
+    }
+    total = 0;
+    lv_area_set(&shownCells, 0, 0, mapWidth - 1, mapHeight - 1);
+
+    for (int i = 0; i < 256; i++)
+    {
+        float c = i / 255.0f;
+        float lin = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        linear[i] = (uint8_t)(lin * 255.0f + 0.5f);
+    }
+
+    // Chain in front of the panel flush (and TearSync's pacing)
+    originalFlush = disp->driver->flush_cb;
+    disp->driver->flush_cb = flushHook;
+
+    Serial.printf("PowerEstimator: Sampling 1 in %u x %u pixels, %u B map\n", STEP, STEP, (unsigned)mapBytes);
+    return true;
+}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+uint8_t PowerEstimator::emission(lv_color_t color) const
+{
+    lv_color32_t c;
+    c.full = lv_color_to32(color);
+    if (eightColor)
+    {
+        // Idle mode: a channel is on at full or off
+        return (WEIGHT_R * (c.ch.red >> 7) + WEIGHT_G * (c.ch.green >> 7) + WEIGHT_B * (c.ch.blue >> 7)) * 255 >> 8;
+    }
+    return (WEIGHT_R * linear[c.ch.red] + WEIGHT_G * linear[c.ch.green] + WEIGHT_B * linear[c.ch.blue]) >> 8;
+}
+
+bool PowerEstimator::isShown(int32_t cellX, int32_t cellY) const
+{
+    return cellX >= shownCells.x1 && cellX <= shownCells.x2 && cellY >= shownCells.y1 && cellY <= shownCells.y2;
+}
+
+void PowerEstimator::recount()
+{
+    total = 0;
+    for (int32_t y = shownCells.y1; y <= shownCells.y2; y++)
+    {
+        const lv_color_t *cell = map + y * mapWidth + shownCells.x1;
+        for (int32_t x = shownCells.x1; x <= shownCells.x2; x++)
+        {
+            total += emission(*cell++);
+        }
+    }
+}
+
+void PowerEstimator::setView(const lv_area_t *area, bool eightColors)
+{
+    if (map == nullptr)
+    {
+        return;
+    }
+
+    eightColor = eightColors;
+    if (area == nullptr)
+    {
+        lv_area_set(&shownCells, 0, 0, mapWidth - 1, mapHeight - 1);
+    }
+    else
+    {
+        // Cells whose sample pixel is inside the area
+        lv_area_set(&shownCells, (area->x1 + STEP - 1) / STEP, (area->y1 + STEP - 1) / STEP, area->x2 / STEP,
+                    area->y2 / STEP);
+    }
+    recount();
+}
+
+void PowerEstimator::sample(const lv_area_t *area, const lv_color_t *pixels)
+{
+    int32_t w = lv_area_get_width(area);
+
+    // First sampled row and column inside the area
+    int32_t x0 = (area->x1 + STEP - 1) / STEP * STEP;
+    int32_t y0 = (area->y1 + STEP - 1) / STEP * STEP;
+
+    for (int32_t y = y0; y <= area->y2; y += STEP)
+    {
+        const lv_color_t *row = pixels + (y - area->y1) * w;
+        lv_color_t *cell = map + (y / STEP) * mapWidth + x0 / STEP;
+        for (int32_t x = x0; x <= area->x2; x += STEP, cell++)
+        {
+            lv_color_t color = row[x - area->x1];
+            if (isShown(x / STEP, y / STEP))
+            {
+                total += emission(color) - emission(*cell);
+            }
+            *cell = color;
+            stats.samples++;
+        }
+    }
+}
+
+void PowerEstimator::flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    PowerEstimator &self = *instance;
+
+    // lv_disp_flush_ready() clears this, read it before flushing
+    if (lv_disp_flush_is_last(drv))
+    {
+        self.stats.frames++;
+    }
+
+    int64_t start = esp_timer_get_time();
+    self.sample(area, color_p);
+    self.stats.sampleUs += esp_timer_get_time() - start;
+
+    self.originalFlush(drv, area, color_p);
+}
+
+float PowerEstimator::getEmission() const
+{
+    // Of the whole screen: an unlit part emits nothing
+    return map ? (float)total / (mapWidth * mapHeight * 255.0f) : 0.0f;
+}
+
+float PowerEstimator::estimateMw(uint8_t brightness) const
+{
+    return BASE_MW + WHITE_MW * getEmission() * brightness / 255.0f;
+}
+
+// ============================================================================
+// BUDGET
+// ============================================================================
+void PowerEstimator::setBrightness(uint8_t brightness)
+{
+    userLevel = brightness;
+
+    // A cap in force stays, the control loop lifts it if the budget allows
+    uint8_t next = level < brightness && isLimiting() ? level : brightness;
+    level = next;
+    if (board)
+    {
+        board->setBrightness(level);
+    }
+}
+
+void PowerEstimator::setLevel(uint8_t next)
+{
+    if (next == level)
+    {
+        return;
+    }
+
+    if (next < userLevel && level >= userLevel)
+    {
+        stats.caps++;
+        Serial.printf("PowerEstimator: Brightness capped %u -> %u, %.0f mW over a %lu mW budget\n", level, next,
+                      estimateMw(userLevel), (unsigned long)budgetMw);
+    }
+    else if (next >= userLevel)
+    {
+        Serial.printf("PowerEstimator: Brightness back to %u\n", next);
+    }
+
+    level = next;
+    if (board)
+    {
+        board->setBrightness(level);
+    }
+}
+
+void PowerEstimator::setDimmed(bool on)
+{
+    if (on == dimmed)
+    {
+        return;
+    }
+
+    dimmed = on;
+    if (on)
+    {
+        stats.dims++;
+        measureSaving = true;
+    }
+    Theme::setSecondaryDimmed(on);
+}
+
+void PowerEstimator::control()
+{
+    float atUser = estimateMw(userLevel);
+
+    // The repaint after dimming has been sampled by now
+    if (measureSaving)
+    {
+        dimSavingMw = beforeDimMw > atUser ? beforeDimMw - atUser : 0.0f;
+        measureSaving = false;
+    }
+
+    if (budgetMw == 0)
+    {
+        setDimmed(false);
+        setLevel(userLevel);
+        return;
+    }
+
+    if (atUser > budgetMw)
+    {
+        // Cheapest first: the secondary tone, then check again once it is repainted
+        if (!dimmed)
+        {
+            beforeDimMw = atUser;
+            setDimmed(true);
+            return;
+        }
+
+        float lit = WHITE_MW * getEmission();
+        float fit = lit > 0.0f ? (budgetMw - BASE_MW) * 255.0f / lit : userLevel;
+        uint8_t target = fit < MIN_LEVEL ? MIN_LEVEL : fit > userLevel ? userLevel : (uint8_t)fit;
+        setLevel(target > level + RAISE_STEP ? level + RAISE_STEP : target);
+        return;
+    }
+
+    // Fits at the user's level: brightness back first, then the secondary tone
+    if (level < userLevel)
+    {
+        setLevel(userLevel - level > RAISE_STEP ? level + RAISE_STEP : userLevel);
+    }
+    else if (dimmed && !measureSaving && (atUser + dimSavingMw) * 100 <= budgetMw * RESTORE_PERCENT)
+    {
+        setDimmed(false);
+    }
+}
+
+void PowerEstimator::requestBudget(uint32_t milliwatts)
+{
+    requestedBudget = milliwatts;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+void PowerEstimator::update()
+{
+    uint32_t pending = requestedBudget;
+    if (pending != UINT32_MAX)
+    {
+        requestedBudget = UINT32_MAX;
+        budgetMw = pending;
+        if (budgetMw)
+        {
+            Serial.printf("PowerEstimator: Budget %lu mW\n", (unsigned long)budgetMw);
+        }
+        else
+        {
+            Serial.println("PowerEstimator: No budget");
+        }
+        // Check straight away
+        lastControl = millis() - CONTROL_MS;
+    }
+
+    if (resetRequested)
+    {
+        resetRequested = false;
+        stats = Stats();
+    }
+
+    if (map == nullptr)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastControl;
+    if (lastControl != 0 && elapsed < CONTROL_MS)
+    {
+        return;
+    }
+    if (lastControl != 0)
+    {
+        stats.energyMj += estimateMw() * elapsed / 1000.0;
+    }
+    lastControl = now;
+
+    control();
+
+    // Keep checking while held down, the page may not ask for updates on its own
+    if (isLimiting())
+    {
+        FrameScheduler::getInstance().requestUpdate(CONTROL_MS);
+    }
+}
+
+void PowerEstimator::print()
+{
+    if (map == nullptr)
+    {
+        Serial.println("[Power] Not running");
+        return;
+    }
+
+    Serial.printf("[Power] Panel ~%.0f mW, emission %.1f%%, brightness %u (user %u), secondary %s\n", estimateMw(),
+                  getEmission() * 100.0f, level, userLevel, dimmed ? "dimmed" : "normal");
+    if (budgetMw)
+    {
+        Serial.printf("[Power] Budget %lu mW, %.0f mW at the user's brightness, dimming saves %.0f mW\n",
+                      (unsigned long)budgetMw, estimateMw(userLevel), dimSavingMw);
+    }
+    else
+    {
+        Serial.println("[Power] No budget");
+    }
+
+    float frames = stats.frames ? stats.frames : 1;
+    Serial.printf("[Power] %lu frames, %.0f samples and %.1f us per frame, %lu dims, %lu caps, %.1f J\n",
+                  (unsigned long)stats.frames, stats.samples / frames, stats.sampleUs / frames,
+                  (unsigned long)stats.dims, (unsigned long)stats.caps, stats.energyMj / 1000.0);
+}
+
+void PowerEstimator::requestReset()
+{
+    resetRequested = true;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "LilyGo_Display.h"
+
+/**
+ * Estimates what the AMOLED panel draws from the pixels it shows, and keeps
+ * it under a power budget.
+ *
+ * An AMOLED pixel only draws current while lit, in proportion to the light
+ * it emits, so panel power follows the picture. The flush hook samples every
+ * STEP-th pixel in both directions of each flushed area, turns it into
+ * emitted light (sRGB to linear per channel, channels weighted by what they
+ * cost: blue subpixels are the least efficient). The samples are kept in a
+ * map of the whole screen at 1/STEP resolution; untouched regions keep
+ * their last sample, so the running total is the emission of the full
+ * screen, not just of what changed. The total follows what the panel shows
+ * (setView): in partial mode only the lit area counts, in idle mode each
+ * channel is fully on or off by its top bit. The estimate is
+ *
+ *   BASE_MW + WHITE_MW * emission * brightness / 255
+ *
+ * where emission is 0 for black and 1 for full white. BASE_MW and WHITE_MW
+ * are starting figures for the 1.91" RM67162; calibrate them against the
+ * PMU's discharge current with the panel on black and on white.
+ *
+ * With a budget set ("power budget <mW>"), update() checks the estimate at
+ * the brightness the user set every CONTROL_MS. Over budget, it first dims
+ * the Secondary tone (Theme::setSecondaryDimmed), which keeps the live
+ * readouts as they are, then caps the panel brightness at what fits. Under
+ * budget, the brightness steps back up to the user's level, and the
+ * secondary tone comes back once the saving measured when it was dimmed
+ * fits under the budget again.
+ *
+ * Chains in front of the display driver's flush. Begin it after TearSync so
+ * the sampling doesn't delay a paced transfer. "power" prints the estimate.
+ */
+class PowerEstimator
+{
+public:
+    // Sample every STEP-th pixel along x and y
+    static constexpr uint8_t STEP = 4;
+
+    // Panel model
+    static constexpr float BASE_MW = 20.0f;   // Panel on, all black
+    static constexpr float WHITE_MW = 350.0f; // Full white at brightness 255, on top of BASE_MW
+
+    struct Stats
+    {
+        uint32_t frames = 0;      // Frames sampled (last flush of a refresh)
+        uint32_t samples = 0;     // Pixels sampled
+        uint64_t sampleUs = 0;    // Time spent sampling
+        uint32_t dims = 0;        // Secondary tone dimmed for the budget
+        uint32_t caps = 0;        // Brightness capped below the user's level
+        double energyMj = 0.0;    // Estimated panel energy since reset
+    };
+
+private:
+    // Singleton instance
+    static PowerEstimator *instance;
+
+    // Private constructor for singleton
+    PowerEstimator() = default;
+
+    // Budget control
+    static constexpr uint32_t CONTROL_MS = 500;
+    static constexpr uint8_t MIN_LEVEL = 40;         // Brightness is never capped below this
+    static constexpr uint8_t RAISE_STEP = 16;        // Brightness comes back at most this much per check
+    static constexpr uint32_t RESTORE_PERCENT = 90;  // Undim when the estimate with the saving fits this much of the budget
+
+    // Channel shares of white power, of 256
+    static constexpr uint16_t WEIGHT_R = 74;
+    static constexpr uint16_t WEIGHT_G = 62;
+    static constexpr uint16_t WEIGHT_B = 120;
+
+    LilyGo_Display *board = nullptr;
+    void (*originalFlush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = nullptr;
+
+    // Sampled pixel per map cell, and the emission of those shown
+    lv_color_t *map = nullptr;
+    uint16_t mapWidth = 0;
+    uint16_t mapHeight = 0;
+    uint32_t total = 0;
+
+    // Cells the panel shows (map coordinates, inclusive) and its color mode
+    lv_area_t shownCells;
+    bool eightColor = false;
+
+    // sRGB channel value to linear light, 0-255
+    uint8_t linear[256];
+
+    uint8_t userLevel = 255;  // Brightness asked for
+    uint8_t level = 255;      // Brightness on the panel
+
+    static volatile uint32_t requestedBudget; // UINT32_MAX = nothing pending
+    static volatile bool resetRequested;
+    uint32_t budgetMw = 0;                    // 0 = no budget
+    bool dimmed = false;
+    bool measureSaving = false; // Take the dimming saving at the next check
+    float beforeDimMw = 0.0f;
+    float dimSavingMw = 0.0f;
+
+    uint32_t lastControl = 0;
+    Stats stats;
+
+    static void flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    void sample(const lv_area_t *area, const lv_color_t *pixels);
+
+    /**
+     * Light one pixel emits as shown, 0-255.
+     */
+    uint8_t emission(lv_color_t color) const;
+    bool isShown(int32_t cellX, int32_t cellY) const;
+    void recount();
+
+    void setLevel(uint8_t next);
+    void setDimmed(bool on);
+    void control();
+
+public:
+    // Get singleton instance
+    static PowerEstimator &getInstance();
+
+    // Delete copy constructor and assignment
+    PowerEstimator(const PowerEstimator &) = delete;
+    PowerEstimator &operator=(const PowerEstimator &) = delete;
+
+    /**
+     * Allocate the emission map and hook the default display's flush.
+     * Call after the LVGL display is registered and after TearSync.
+     * @param panel  display whose brightness is set
+     * @return false if there is no display or no memory for the map
+     */
+    bool begin(LilyGo_Display *panel);
+
+    bool isRunning() const { return map != nullptr; }
+
+    /**
+     * Set the brightness the user wants. The panel gets it, or less while
+     * the budget caps it.
+     */
+    void setBrightness(uint8_t brightness);
+    uint8_t getLevel() const { return level; }
+
+    /**
+     * Tell the estimator what the panel shows: only `area` (nullptr = all of
+     * it), in 8 colors or in full color. Display task only.
+     */
+    void setView(const lv_area_t *area, bool eightColors);
+
+    /**
+     * Emitted light of the whole screen, 0 (black) to 1 (full white).
+     */
+    float getEmission() const;
+
+    /**
+     * Estimated panel power at a brightness, and at the current one.
+     */
+    float estimateMw(uint8_t brightness) const;
+    float estimateMw() const { return estimateMw(level); }
+
+    /**
+     * Ask for a power budget in mW (0 = none) from any task. Applied on the
+     * display task by update().
+     */
+    static void requestBudget(uint32_t milliwatts);
+    uint32_t getBudget() const { return budgetMw; }
+
+    /**
+     * True while the budget holds brightness or the secondary tone down.
+     */
+    bool isLimiting() const { return dimmed || level < userLevel; }
+
+    /**
+     * Apply budget and reset requests and, every CONTROL_MS, fit the panel to the
+     * budget. Display task, outside the LVGL refresh.
+     */
+    void update();
+
+    const Stats &getStats() const { return stats; }
+
+    void print();
+
+    /**
+     * Clear the stats from any task; applied by update().
+     */
+    static void requestReset();
+};
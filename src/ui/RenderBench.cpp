@@ -0,0 +1,213 @@
+#include "RenderBench.h"
+#include "FrameProfiler.h"
+#include "FrameScheduler.h"
+#include "PageManager.h"
+#include "TearSync.h"
+#include <lvgl.h>
+
+#if __has_include(<xtensa_perfmon_access.h>)
+#include <xtensa_perfmon_access.h>
+#include <xtensa/xt_perf_consts.h>
+#define BENCH_PERFMON 1
+#else
+#define BENCH_PERFMON 0
+#endif
+
+namespace RenderBench
+{
+#ifdef HUD_FAST_MEM
+    static const char *const BUILD_NAME = "fastmem";
+#else
+    static const char *const BUILD_NAME = "default";
+#endif
+
+    // Performance counters used (the cycle count comes from CCOUNT)
+    static constexpr int COUNTER_STALLS = 0;
+    static constexpr int COUNTER_INSNS = 1;
+
+    /**
+     * Counter readings at one point in time, or the difference between two.
+     */
+    struct Sample
+    {
+        uint32_t cycles = 0;
+        uint32_t stalls = 0;
+        uint32_t insns = 0;
+
+        Sample operator-(const Sample &other) const
+        {
+            Sample d;
+            d.cycles = cycles - other.cycles;
+            d.stalls = stalls - other.stalls;
+            d.insns = insns - other.insns;
+            return d;
+        }
+
+        Sample &operator+=(const Sample &other)
+        {
+            cycles += other.cycles;
+            stalls += other.stalls;
+            insns += other.insns;
+            return *this;
+        }
+    };
+
+    /**
+     * Per-frame differences summed over the run.
+     */
+    struct Totals
+    {
+        uint64_t cycles = 0;
+        uint64_t stalls = 0;
+        uint64_t insns = 0;
+        uint32_t maxCycles = 0;
+
+        void add(const Sample &frame)
+        {
+            cycles += frame.cycles;
+            stalls += frame.stalls;
+            insns += frame.insns;
+            if (frame.cycles > maxCycles)
+            {
+                maxCycles = frame.cycles;
+            }
+        }
+    };
+
+    static volatile uint16_t pendingFrames = 0;
+
+    static void (*originalFlush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = nullptr;
+    static Sample flushed; // Flush time in the current frame
+
+    static Sample read()
+    {
+        Sample s;
+        s.cycles = ESP.getCycleCount();
+#if BENCH_PERFMON
+        s.stalls = xtensa_perfmon_value(COUNTER_STALLS);
+        s.insns = xtensa_perfmon_value(COUNTER_INSNS);
+#endif
+        return s;
+    }
+
+    static void startCounters()
+    {
+#if BENCH_PERFMON
+        // Fetch stalls: waiting on the instruction bus, where flash cache misses land
+        xtensa_perfmon_init(COUNTER_STALLS, XTPERF_CNT_I_STALL,
+                            XTPERF_MASK_I_STALL_CACHE_MISS | XTPERF_MASK_I_STALL_IRAM_BUSY, 0, -1);
+        xtensa_perfmon_init(COUNTER_INSNS, XTPERF_CNT_INSN, XTPERF_MASK_INSN_ALL, 0, -1);
+        xtensa_perfmon_reset(COUNTER_STALLS);
+        xtensa_perfmon_reset(COUNTER_INSNS);
+        xtensa_perfmon_start();
+#endif
+    }
+
+    static void stopCounters()
+    {
+#if BENCH_PERFMON
+        xtensa_perfmon_stop();
+#endif
+    }
+
+    static void flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+    {
+        Sample before = read();
+        originalFlush(drv, area, color_p);
+        flushed += read() - before;
+    }
+
+    static void printRow(const char *name, const Totals &t, uint16_t frames)
+    {
+        uint32_t mhz = getCpuFrequencyMhz();
+        uint32_t avg = t.cycles / frames;
+        Serial.printf("[Bench] %-5s %8lu cycles/frame (%lu us), max %lu",
+                      name, (unsigned long)avg, (unsigned long)(avg / mhz), (unsigned long)t.maxCycles);
+#if BENCH_PERFMON
+        Serial.printf(", %lu fetch stall cycles/frame (%.1f%%), CPI %.2f",
+                      (unsigned long)(t.stalls / frames), t.cycles ? 100.0f * t.stalls / t.cycles : 0.0f,
+                      t.insns ? (float)t.cycles / t.insns : 0.0f);
+#endif
+        Serial.println();
+    }
+
+    static void run(uint16_t frames)
+    {
+        lv_disp_t *disp = lv_disp_get_default();
+        if (disp == nullptr)
+        {
+            return;
+        }
+
+        PageManager &pages = PageManager::getInstance();
+        int returnTo = pages.getCurrentPageIndex();
+        pages.goToPage(0, false);
+
+        // Measure drawing and the bare QSPI transfer, nothing else
+        TearSync &sync = TearSync::getInstance();
+        bool paced = sync.isEnabled();
+        sync.setEnabled(false);
+#if FRAME_PROFILER
+        FrameProfiler &profiler = FrameProfiler::getInstance();
+        bool profiling = profiler.isEnabled();
+        profiler.setEnabled(false);
+#endif
+
+        // One untimed frame so the page and glyph caches are warm
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+
+        originalFlush = disp->driver->flush_cb;
+        disp->driver->flush_cb = flushHook;
+        Totals drawTotals;
+        Totals flushTotals;
+        Totals frameTotals;
+
+        startCounters();
+        for (uint16_t i = 0; i < frames; i++)
+        {
+            lv_obj_invalidate(lv_scr_act());
+            flushed = Sample();
+            Sample before = read();
+            lv_refr_now(disp);
+            Sample frame = read() - before;
+
+            frameTotals.add(frame);
+            flushTotals.add(flushed);
+            drawTotals.add(frame - flushed);
+        }
+        stopCounters();
+
+        disp->driver->flush_cb = originalFlush;
+        sync.setEnabled(paced);
+#if FRAME_PROFILER
+        profiler.setEnabled(profiling);
+#endif
+        pages.goToPage(returnTo, false);
+
+        Serial.printf("[Bench] %s build, %u full redraws of the speed page at %lu MHz\n",
+                      BUILD_NAME, frames, (unsigned long)getCpuFrequencyMhz());
+        printRow("draw", drawTotals, frames);
+        printRow("flush", flushTotals, frames);
+        printRow("frame", frameTotals, frames);
+#if !BENCH_PERFMON
+        Serial.println("[Bench] perfmon not available, fetch stalls not counted");
+#endif
+    }
+
+    void request(uint16_t frames)
+    {
+        pendingFrames = frames ? frames : DEFAULT_FRAMES;
+        FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+    }
+
+    void runPending()
+    {
+        uint16_t frames = pendingFrames;
+        if (frames)
+        {
+            pendingFrames = 0;
+            run(frames);
+        }
+    }
+}
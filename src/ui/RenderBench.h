@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * On-device render benchmark for comparing code placements.
+ *
+ * Redraws the whole speed page a fixed number of times with lv_refr_now()
+ * and reports, per frame, CPU cycles and instruction fetch stall cycles for
+ * drawing and for the panel flush separately. Run it ("bench" on serial) on
+ * the default build and on the T-Display-AMOLED-fastmem build, which keeps
+ * the hot LVGL and flush code in IRAM, to see what the placement buys.
+ *
+ * The ESP32-S3 flash cache has no miss counter, so cache misses are
+ * measured by their cost: the core's instruction stall cycles (Xtensa
+ * performance counters), which are where a missed fetch from flash shows
+ * up. Without the perfmon component only cycles are reported.
+ */
+namespace RenderBench
+{
+    // Frames rendered when no count is given
+    constexpr uint16_t DEFAULT_FRAMES = 60;
+
+    /**
+     * Ask for a run from any task; it runs on the next display task pass.
+     */
+    void request(uint16_t frames = DEFAULT_FRAMES);
+
+    /**
+     * Run a requested benchmark. Display task only.
+     */
+    void runPending();
+}
@@ -0,0 +1,183 @@
+#include "RenderGovernor.h"
+#include "FrameScheduler.h"
+#include "PageManager.h"
+#include "Theme.h"
+
+// Singleton instance
+RenderGovernor *RenderGovernor::instance = nullptr;
+
+volatile int8_t RenderGovernor::requested = -1;
+
+const char *const RenderGovernor::LEVEL_NAMES[(int)Quality::Count] = {
+    "full", "aliased text", "slow secondary", "no animations", "freeze secondary"};
+
+RenderGovernor &RenderGovernor::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new RenderGovernor();
+    }
+    return *instance;
+}
+
+void RenderGovernor::begin()
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == nullptr || disp->driver->draw_ctx == nullptr)
+    {
+        Serial.println("RenderGovernor: No display registered");
+        return;
+    }
+
+    // Snapshots (static layers, swipe covers) use their own draw context and keep full quality
+    originalLetter = disp->driver->draw_ctx->draw_letter;
+    disp->driver->draw_ctx->draw_letter = letterHook;
+    levelSince = millis();
+}
+
+void RenderGovernor::letterHook(lv_draw_ctx_t *ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos,
+                                uint32_t letter)
+{
+    if (!instance->atLeast(Quality::AliasedText) || dsc->font == Theme::font(Theme::Text::ValueLarge))
+    {
+        instance->originalLetter(ctx, dsc, pos, letter);
+        return;
+    }
+
+    // LVGL rounds every blend mask to opaque or transparent while this is off
+    lv_disp_drv_t *driver = _lv_refr_get_disp_refreshing()->driver;
+    uint32_t antialiasing = driver->antialiasing;
+    driver->antialiasing = 0;
+    instance->originalLetter(ctx, dsc, pos, letter);
+    driver->antialiasing = antialiasing;
+}
+
+const char *RenderGovernor::levelName(Quality quality)
+{
+    return quality < Quality::Count ? LEVEL_NAMES[(int)quality] : "?";
+}
+
+void RenderGovernor::setLevel(Quality next, uint32_t frameUs, uint32_t budgetUs)
+{
+    uint32_t now = millis();
+    levelStats[(int)level].timeMs += now - levelSince;
+    levelSince = now;
+
+    Change &change = history[changes % HISTORY];
+    change.atMs = now;
+    change.from = level;
+    change.to = next;
+    change.frameUs = frameUs;
+    change.budgetUs = budgetUs;
+    changes++;
+
+    if (next > level)
+    {
+        Serial.printf("RenderGovernor: Quality %s -> %s, %u of %u frames over %lu us (last %lu us)\n",
+                      levelName(level), levelName(next), __builtin_popcount(window), WINDOW,
+                      (unsigned long)budgetUs, (unsigned long)frameUs);
+    }
+    else if (!enabled)
+    {
+        Serial.printf("RenderGovernor: Quality %s -> %s, governor off\n", levelName(level), levelName(next));
+    }
+    else
+    {
+        Serial.printf("RenderGovernor: Quality %s -> %s, %lu frames under %lu%% of the budget\n", levelName(level),
+                      levelName(next), (unsigned long)calmFrames, (unsigned long)RECOVER_PERCENT);
+    }
+
+    level = next;
+    levelStats[(int)level].entries++;
+    window = 0;
+    calmFrames = 0;
+
+    // Frozen or slowed pages pick up their new rate on the next pass
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+void RenderGovernor::addFrame(uint32_t frameUs, uint32_t budgetUs)
+{
+    bool over = frameUs > budgetUs;
+    LevelStats &stats = levelStats[(int)level];
+    stats.frames++;
+    if (over)
+    {
+        stats.overruns++;
+        PageManager &pages = PageManager::getInstance();
+        if (pages.getPage(pages.getCurrentPageIndex())->isCritical())
+        {
+            stats.criticalOverruns++;
+        }
+    }
+
+    if (!enabled)
+    {
+        return;
+    }
+
+    window = (window << 1) | over;
+    calmFrames = frameUs * 100 < budgetUs * RECOVER_PERCENT ? calmFrames + 1 : 0;
+    uint32_t atLevel = millis() - levelSince;
+
+    if (__builtin_popcount(window) >= OVERRUN_LIMIT && atLevel >= STEP_HOLD_MS &&
+        level < Quality::FreezeSecondary)
+    {
+        setLevel((Quality)((int)level + 1), frameUs, budgetUs);
+    }
+    else if (calmFrames >= RECOVER_FRAMES && atLevel >= RECOVER_HOLD_MS && level > Quality::Full)
+    {
+        setLevel((Quality)((int)level - 1), frameUs, budgetUs);
+    }
+}
+
+void RenderGovernor::request(bool on)
+{
+    requested = on;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+void RenderGovernor::applyRequested()
+{
+    int8_t pending = requested;
+    if (pending < 0)
+    {
+        return;
+    }
+    requested = -1;
+    if ((bool)pending == enabled)
+    {
+        return;
+    }
+
+    enabled = pending;
+    Serial.printf("RenderGovernor: Governor %s\n", enabled ? "on" : "off");
+    if (!enabled && level != Quality::Full)
+    {
+        setLevel(Quality::Full, 0, 0);
+    }
+}
+
+void RenderGovernor::print()
+{
+    uint32_t atLevel = millis() - levelSince;
+    Serial.printf("[Governor] %s, quality %s, %lu changes\n", enabled ? "on" : "off", levelName(level),
+                  (unsigned long)changes);
+    Serial.println("[Governor] level             entries   time s   frames  over  over on speed");
+    for (int i = 0; i < (int)Quality::Count; i++)
+    {
+        const LevelStats &s = levelStats[i];
+        uint64_t timeMs = s.timeMs + (i == (int)level ? atLevel : 0);
+        Serial.printf("[Governor] %-16s  %7lu  %7lu  %7lu  %4lu  %13lu\n", LEVEL_NAMES[i], (unsigned long)s.entries,
+                      (unsigned long)(timeMs / 1000), (unsigned long)s.frames, (unsigned long)s.overruns,
+                      (unsigned long)s.criticalOverruns);
+    }
+
+    uint32_t shown = changes < HISTORY ? changes : HISTORY;
+    for (uint32_t i = changes - shown; i < changes; i++)
+    {
+        const Change &c = history[i % HISTORY];
+        Serial.printf("[Governor] %8lu ms  %s -> %s  frame %lu us / budget %lu us\n", (unsigned long)c.atMs,
+                      levelName(c.from), levelName(c.to), (unsigned long)c.frameUs, (unsigned long)c.budgetUs);
+    }
+}
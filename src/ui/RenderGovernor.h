@@ -0,0 +1,159 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * Quality levels the governor steps through, cheapest last.
+ * Each level keeps everything the levels before it switched off.
+ */
+enum class Quality : uint8_t
+{
+    Full,            // Everything on
+    AliasedText,     // Labels other than the speed readout drawn without anti-aliasing
+    SlowSecondary,   // Rate-limited pages update SLOW_FACTOR times less often
+    NoAnimations,    // Speed roll and page scrolls jump straight to their end
+    FreezeSecondary, // Pages other than the speed page stop updating, no page builds
+    Count
+};
+
+/**
+ * RenderGovernor sheds rendering work when the display task keeps missing
+ * its frame budget.
+ *
+ * FrameScheduler reports the busy time of every iteration that rendered a
+ * frame, against the budget of the activity state it ran in (its refresh
+ * cap: 33 ms riding, 16 ms swiping, 100 ms parked). When OVERRUN_LIMIT of
+ * the last WINDOW frames ran over, the quality drops one level; another
+ * step needs STEP_HOLD_MS at the current one. Quality comes back one level
+ * at a time after RECOVER_FRAMES frames in a row under RECOVER_PERCENT of
+ * the budget and RECOVER_HOLD_MS since the last change, so a level is not
+ * given up the moment the load that caused it lets go.
+ *
+ * The speed page is never throttled: its updates, font and roll target
+ * stay as they are at every level, and frames over budget while it is
+ * visible are counted separately. Every change is logged on serial and kept
+ * in a short history; "gov" prints the history and per-level figures,
+ * "gov off" holds full quality.
+ */
+class RenderGovernor
+{
+public:
+    // Rate-limited pages update this many times less often from SlowSecondary on
+    static constexpr uint32_t SLOW_FACTOR = 4;
+
+    /**
+     * One level change, kept for the serial report.
+     */
+    struct Change
+    {
+        uint32_t atMs = 0;
+        Quality from = Quality::Full;
+        Quality to = Quality::Full;
+        uint32_t frameUs = 0;  // Frame that triggered it
+        uint32_t budgetUs = 0;
+    };
+
+    /**
+     * Figures for the time spent at one level.
+     */
+    struct LevelStats
+    {
+        uint32_t entries = 0;
+        uint32_t frames = 0;
+        uint32_t overruns = 0;         // Frames over budget
+        uint32_t criticalOverruns = 0; // Of those, with the speed page visible
+        uint64_t timeMs = 0;
+    };
+
+private:
+    // Singleton instance
+    static RenderGovernor *instance;
+
+    // Private constructor for singleton
+    RenderGovernor() = default;
+
+    static const char *const LEVEL_NAMES[(int)Quality::Count];
+
+    // Degrade when this many of the last WINDOW frames ran over budget
+    static constexpr uint8_t WINDOW = 8;
+    static constexpr uint8_t OVERRUN_LIMIT = 3;
+    static constexpr uint32_t STEP_HOLD_MS = 500;
+
+    // Recover after this many frames in a row under RECOVER_PERCENT of the budget
+    static constexpr uint32_t RECOVER_FRAMES = 90;
+    static constexpr uint32_t RECOVER_PERCENT = 70;
+    static constexpr uint32_t RECOVER_HOLD_MS = 3000;
+
+    static constexpr int HISTORY = 16;
+
+    bool enabled = true;
+    static volatile int8_t requested; // -1 = nothing pending
+
+    Quality level = Quality::Full;
+    uint8_t window = 0;      // Last WINDOW frames, bit set = over budget
+    uint32_t calmFrames = 0; // Frames in a row under the recovery threshold
+    uint32_t levelSince = 0; // millis() of the last change
+
+    LevelStats levelStats[(int)Quality::Count];
+    Change history[HISTORY];
+    uint32_t changes = 0;
+
+    // LVGL's letter drawing, chained to
+    void (*originalLetter)(lv_draw_ctx_t *, const lv_draw_label_dsc_t *, const lv_point_t *, uint32_t) = nullptr;
+
+    static void letterHook(lv_draw_ctx_t *ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, uint32_t letter);
+    void setLevel(Quality next, uint32_t frameUs, uint32_t budgetUs);
+
+public:
+    // Get singleton instance
+    static RenderGovernor &getInstance();
+
+    // Delete copy constructor and assignment
+    RenderGovernor(const RenderGovernor &) = delete;
+    RenderGovernor &operator=(const RenderGovernor &) = delete;
+
+    /**
+     * Hook the default display's letter drawing. Call from the display task
+     * after the LVGL display is registered.
+     */
+    void begin();
+
+    /**
+     * Account one rendered frame. Display task only.
+     * @param frameUs  busy time of the display task iteration that rendered it
+     * @param budgetUs frame period of the current activity state
+     */
+    void addFrame(uint32_t frameUs, uint32_t budgetUs);
+
+    Quality getLevel() const { return level; }
+
+    /**
+     * True if the given degradation is in effect.
+     */
+    bool atLeast(Quality quality) const { return level >= quality; }
+
+    /**
+     * Update interval of a rate-limited page at the current level
+     * (0 = every pass, never stretched).
+     */
+    uint32_t scaleInterval(uint32_t intervalMs) const
+    {
+        return intervalMs > 0 && atLeast(Quality::SlowSecondary) ? intervalMs * SLOW_FACTOR : intervalMs;
+    }
+
+    static const char *levelName(Quality quality);
+
+    /**
+     * Ask for the governor on or off from any task; applied by
+     * applyRequested() on the display task.
+     */
+    static void request(bool on);
+    void applyRequested();
+
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Print the current level, time and overruns per level and the recent changes.
+     */
+    void print();
+};
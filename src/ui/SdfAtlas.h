@@ -0,0 +1,50 @@
+/**
+ * @file      SdfAtlas.h
+ * @brief     Layout of the signed-distance-field numeral atlas
+ *
+ * The atlas is generated at build time by tools/fonts/sdf_atlas.py from the
+ * 200 px Roboto Black master and compiled in as SdfNumerals.c. Each byte is
+ * a distance to the glyph outline: 128 on the edge, 255 at `spread` atlas
+ * pixels inside, 0 at `spread` pixels outside. Glyph metrics are those of
+ * the master font, in master pixels; each atlas cell holds the glyph's box
+ * plus `spread` pixels of margin, at 1/`downscale` of the master size.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t unicode;
+    uint16_t adv_w;      /* Advance in 1/16 master px */
+    uint16_t box_w;      /* Glyph box in master px */
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint16_t x;          /* Cell in the atlas, atlas px; 0 x 0 for blank glyphs */
+    uint16_t y;
+    uint8_t w;
+    uint8_t h;
+} sdf_glyph_t;
+
+typedef struct {
+    uint16_t source_px;  /* Size of the master font */
+    uint16_t line_height;
+    int16_t base_line;
+    uint8_t downscale;   /* Master px per atlas px */
+    uint8_t spread;      /* Distance range either side of the edge, atlas px */
+    uint16_t width;
+    uint16_t height;
+    uint16_t glyph_count;
+    const sdf_glyph_t *glyphs;   /* Sorted by unicode */
+    const uint8_t *bitmap;       /* width x height, row major */
+} sdf_atlas_t;
+
+extern const sdf_atlas_t sdf_numerals;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
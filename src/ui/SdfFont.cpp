@@ -0,0 +1,380 @@
+#include "SdfFont.h"
+#include "Assets.h"
+#include <esp_timer.h>
+
+#ifdef HUD_SDF_NUMERALS
+#include "SdfAtlas.h"
+#include <esp_heap_caps.h>
+#include <math.h>
+
+lv_font_t RobotoBlack_60;
+lv_font_t RobotoBlack_200;
+
+namespace SdfFont
+{
+    // Sizes create() can hand out at once
+    static constexpr int MAX_FACES = 4;
+
+    /**
+     * Per-size state, hung off lv_font_t::dsc.
+     */
+    struct Face
+    {
+        uint16_t px;
+        float scale; // Output px per master px
+    };
+
+    /**
+     * One rasterized glyph. Slots with a null bitmap are free.
+     */
+    struct Slot
+    {
+        const Face *face;
+        uint32_t letter;
+        uint8_t *bitmap;
+        uint32_t bytes;
+        uint32_t lastUse;
+    };
+
+    static Face faces[MAX_FACES];
+    static int faceCount = 0;
+    static Slot slots[CACHE_SLOTS];
+    static uint32_t useClock = 0;
+    static Stats stats;
+    static bool started = false;
+
+    static const sdf_glyph_t *findGlyph(uint32_t letter)
+    {
+        const sdf_atlas_t &atlas = sdf_numerals;
+        int lo = 0;
+        int hi = atlas.glyph_count - 1;
+        while (lo <= hi)
+        {
+            int mid = (lo + hi) / 2;
+            uint32_t unicode = atlas.glyphs[mid].unicode;
+            if (unicode == letter)
+            {
+                return &atlas.glyphs[mid];
+            }
+            if (unicode < letter)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Glyph box at the face's size: the master box scaled and grown to whole pixels.
+     */
+    static void scaleGlyph(const Face &face, const sdf_glyph_t *g, lv_font_glyph_dsc_t *dsc)
+    {
+        dsc->adv_w = ((uint32_t)lroundf(g->adv_w * face.scale) + 8) >> 4;
+        dsc->bpp = 8;
+        dsc->is_placeholder = 0;
+        if (g->w == 0)
+        {
+            dsc->box_w = dsc->box_h = 0;
+            dsc->ofs_x = dsc->ofs_y = 0;
+            return;
+        }
+        int x0 = floorf(g->ofs_x * face.scale);
+        int y0 = floorf(g->ofs_y * face.scale);
+        dsc->ofs_x = x0;
+        dsc->ofs_y = y0;
+        dsc->box_w = (int)ceilf((g->ofs_x + g->box_w) * face.scale) - x0;
+        dsc->box_h = (int)ceilf((g->ofs_y + g->box_h) * face.scale) - y0;
+    }
+
+    /**
+     * Rasterize one glyph into out (box_w x box_h bytes of 8 bpp coverage).
+     */
+    static void rasterize(const Face &face, const sdf_glyph_t *g, const lv_font_glyph_dsc_t &dsc, uint8_t *out)
+    {
+        const sdf_atlas_t &atlas = sdf_numerals;
+        const float k = face.scale;
+        const float toAtlas = 1.0f / (k * atlas.downscale); // Atlas px per output px
+
+        // Edge distance in output px is (v - 128) / 127 * spread * downscale * k; in 8.8 fixed
+        // point, alpha = 128 + (v88 - 128 * 256) * gain >> 16
+        const int32_t gain = (int32_t)(255.0f * atlas.spread * atlas.downscale * k / 127.0f * 256.0f);
+
+        // Output pixel centres in atlas coordinates, 16.16 fixed point
+        const int32_t step = (int32_t)(toAtlas * 65536.0f);
+        const float boxTop = g->ofs_y + g->box_h; // Master px above the baseline
+        const float left = (dsc.ofs_x + 0.5f) / k - g->ofs_x; // First pixel centre, master px into the box
+        const int32_t x0 = (int32_t)((left / atlas.downscale + atlas.spread - 0.5f) * 65536.0f);
+        const int32_t maxX = (g->w - 1) << 16;
+        const int32_t maxY = (g->h - 1) << 16;
+        const uint8_t *cell = atlas.bitmap + g->y * atlas.width + g->x;
+
+        for (int py = 0; py < dsc.box_h; py++)
+        {
+            float srcY = (dsc.ofs_y + dsc.box_h - py - 0.5f) / k;
+            int32_t ay = (int32_t)(((boxTop - srcY) / atlas.downscale + atlas.spread - 0.5f) * 65536.0f);
+            ay = ay < 0 ? 0 : (ay > maxY ? maxY : ay);
+            const uint8_t *row0 = cell + (ay >> 16) * atlas.width;
+            const uint8_t *row1 = (ay >> 16) < g->h - 1 ? row0 + atlas.width : row0;
+            int32_t fy = (ay >> 8) & 0xff;
+
+            int32_t ax = x0;
+            for (int px = 0; px < dsc.box_w; px++, ax += step)
+            {
+                int32_t cx = ax < 0 ? 0 : (ax > maxX ? maxX : ax);
+                int32_t ix = cx >> 16;
+                int32_t ix1 = ix < g->w - 1 ? ix + 1 : ix;
+                int32_t fx = (cx >> 8) & 0xff;
+
+                int32_t top = row0[ix] * (256 - fx) + row0[ix1] * fx;
+                int32_t bottom = row1[ix] * (256 - fx) + row1[ix1] * fx;
+                int32_t v88 = (top * (256 - fy) + bottom * fy) >> 8;
+
+                int32_t alpha = 128 + (((v88 - 128 * 256) * gain) >> 16);
+                *out++ = alpha < 0 ? 0 : (alpha > 255 ? 255 : alpha);
+            }
+        }
+    }
+
+    static void evict(Slot &slot)
+    {
+        stats.bytes -= slot.bytes;
+        stats.entries--;
+        stats.evictions++;
+        heap_caps_free(slot.bitmap);
+        slot.bitmap = nullptr;
+        slot.bytes = 0;
+    }
+
+    /**
+     * Free the least recently used glyphs until a slot and `bytes` are available.
+     */
+    static Slot *makeRoom(uint32_t bytes)
+    {
+        while (true)
+        {
+            Slot *empty = nullptr;
+            Slot *oldest = nullptr;
+            for (Slot &slot : slots)
+            {
+                if (slot.bitmap == nullptr)
+                {
+                    empty = &slot;
+                }
+                else if (oldest == nullptr || slot.lastUse < oldest->lastUse)
+                {
+                    oldest = &slot;
+                }
+            }
+            if (empty != nullptr && stats.bytes + bytes <= CACHE_BUDGET)
+            {
+                return empty;
+            }
+            if (oldest == nullptr)
+            {
+                return nullptr;
+            }
+            evict(*oldest);
+        }
+    }
+
+    static bool getGlyphDsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc, uint32_t letter, uint32_t letterNext)
+    {
+        LV_UNUSED(letterNext);
+        const sdf_glyph_t *g = findGlyph(letter);
+        if (g == nullptr)
+        {
+            return false;
+        }
+        scaleGlyph(*(const Face *)font->dsc, g, dsc);
+        return true;
+    }
+
+    static const uint8_t *getGlyphBitmap(const lv_font_t *font, uint32_t letter)
+    {
+        const Face *face = (const Face *)font->dsc;
+        uint32_t now = ++useClock;
+        for (Slot &slot : slots)
+        {
+            if (slot.bitmap != nullptr && slot.face == face && slot.letter == letter)
+            {
+                slot.lastUse = now;
+                stats.hits++;
+                return slot.bitmap;
+            }
+        }
+
+        const sdf_glyph_t *g = findGlyph(letter);
+        if (g == nullptr || g->w == 0)
+        {
+            return nullptr;
+        }
+        lv_font_glyph_dsc_t dsc;
+        scaleGlyph(*face, g, &dsc);
+        uint32_t bytes = dsc.box_w * dsc.box_h;
+
+        // The bitmap LVGL is drawing from is returned before the next lookup, so evicting here is safe
+        Slot *slot = makeRoom(bytes);
+        if (slot == nullptr)
+        {
+            return nullptr;
+        }
+        slot->bitmap = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (slot->bitmap == nullptr)
+        {
+            slot->bitmap = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+            if (slot->bitmap == nullptr)
+            {
+                return nullptr;
+            }
+        }
+
+        int64_t start = esp_timer_get_time();
+        rasterize(*face, g, dsc, slot->bitmap);
+        stats.rasterUs += esp_timer_get_time() - start;
+        stats.rasterPixels += bytes;
+        stats.misses++;
+
+        slot->face = face;
+        slot->letter = letter;
+        slot->bytes = bytes;
+        slot->lastUse = now;
+        stats.bytes += bytes;
+        stats.entries++;
+        return slot->bitmap;
+    }
+
+    void create(lv_font_t *font, uint16_t px)
+    {
+        Face *face = nullptr;
+        for (int i = 0; i < faceCount; i++)
+        {
+            if (faces[i].px == px)
+            {
+                face = &faces[i];
+            }
+        }
+        if (face == nullptr)
+        {
+            if (faceCount == MAX_FACES)
+            {
+                Serial.printf("SdfFont: No room for a %u px face\n", px);
+                *font = lv_font_montserrat_48;
+                return;
+            }
+            face = &faces[faceCount++];
+            face->px = px;
+            face->scale = (float)px / sdf_numerals.source_px;
+        }
+
+        const sdf_atlas_t &atlas = sdf_numerals;
+        memset(font, 0, sizeof(lv_font_t));
+        font->get_glyph_dsc = getGlyphDsc;
+        font->get_glyph_bitmap = getGlyphBitmap;
+        font->line_height = (lv_coord_t)ceilf(atlas.line_height * face->scale);
+        font->base_line = (lv_coord_t)floorf(atlas.base_line * face->scale);
+        font->subpx = LV_FONT_SUBPX_NONE;
+        font->dsc = face;
+    }
+
+    void begin()
+    {
+        if (started)
+        {
+            return;
+        }
+        started = true;
+
+        create(&RobotoBlack_200, 200);
+        create(&RobotoBlack_60, 60);
+        Serial.printf("SdfFont: %u glyphs, %ux%u atlas, %u px and %u px faces\n", sdf_numerals.glyph_count,
+                      sdf_numerals.width, sdf_numerals.height, 200, 60);
+    }
+
+    const Stats &getStats()
+    {
+        return stats;
+    }
+
+    // ============================================================================
+    // REPORT
+    // ============================================================================
+    static void printColdDigits(uint16_t px)
+    {
+        Face face = {px, (float)px / sdf_numerals.source_px};
+        uint32_t total = 0;
+        uint32_t worst = 0;
+        uint32_t pixels = 0;
+        for (uint32_t letter = '0'; letter <= '9'; letter++)
+        {
+            const sdf_glyph_t *g = findGlyph(letter);
+            if (g == nullptr)
+            {
+                continue;
+            }
+            lv_font_glyph_dsc_t dsc;
+            scaleGlyph(face, g, &dsc);
+            uint8_t *scratch = (uint8_t *)heap_caps_malloc(dsc.box_w * dsc.box_h, MALLOC_CAP_8BIT);
+            if (scratch == nullptr)
+            {
+                continue;
+            }
+
+            uint32_t start = micros();
+            rasterize(face, g, dsc, scratch);
+            uint32_t elapsed = micros() - start;
+            heap_caps_free(scratch);
+
+            total += elapsed;
+            pixels += dsc.box_w * dsc.box_h;
+            if (elapsed > worst)
+            {
+                worst = elapsed;
+            }
+        }
+        Serial.printf("[SDF] %3u px: 10 digits rasterized in %lu us (worst %lu us, %lu px)\n", px,
+                      (unsigned long)total, (unsigned long)worst, (unsigned long)pixels);
+    }
+
+    void print()
+    {
+        const sdf_atlas_t &atlas = sdf_numerals;
+        uint32_t lookups = stats.hits + stats.misses;
+        uint32_t permille = lookups ? (uint64_t)stats.hits * 1000 / lookups : 0;
+        Serial.printf("[SDF] Atlas %ux%u, %u glyphs, 1/%u scale, spread %u px, %lu bytes\n", atlas.width,
+                      atlas.height, atlas.glyph_count, atlas.downscale, atlas.spread,
+                      (unsigned long)(atlas.width * atlas.height + atlas.glyph_count * sizeof(sdf_glyph_t)));
+        Serial.printf("[SDF] Cache %u/%u glyphs, %lu/%lu bytes, %lu hits, %lu misses (%lu.%lu%% hit), %lu evictions\n",
+                      stats.entries, CACHE_SLOTS, (unsigned long)stats.bytes, (unsigned long)CACHE_BUDGET,
+                      (unsigned long)stats.hits, (unsigned long)stats.misses,
+                      (unsigned long)(permille / 10), (unsigned long)(permille % 10), (unsigned long)stats.evictions);
+        if (stats.misses > 0)
+        {
+            Serial.printf("[SDF] Rasterized %lu px in %lu us (%lu us/glyph)\n", (unsigned long)stats.rasterPixels,
+                          (unsigned long)stats.rasterUs, (unsigned long)(stats.rasterUs / stats.misses));
+        }
+        for (int i = 0; i < faceCount; i++)
+        {
+            printColdDigits(faces[i].px);
+        }
+    }
+}
+
+#else
+
+namespace SdfFont
+{
+    void begin()
+    {
+    }
+
+    void print()
+    {
+        Serial.println("[SDF] Numerals drawn from bitmap fonts (build with HUD_SDF_NUMERALS for the atlas)");
+    }
+}
+
+#endif
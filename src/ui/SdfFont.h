@@ -0,0 +1,57 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * Numeral fonts rendered from a signed distance field.
+ *
+ * Built with HUD_SDF_NUMERALS (env T-Display-AMOLED-sdf), RobotoBlack_200
+ * and RobotoBlack_60 are not compiled in as bitmaps. One distance-field
+ * atlas (SdfAtlas.h, generated by tools/fonts/sdf_atlas.py) holds the
+ * digits and the few symbols the pages draw in them, and create() turns it
+ * into an lv_font_t of any pixel size with its own get_glyph_dsc and
+ * get_glyph_bitmap.
+ *
+ * A glyph is rasterized on its first use at a size: each output pixel
+ * samples the atlas bilinearly and maps the distance to 8 bpp coverage.
+ * The result stays in an LRU cache of CACHE_SLOTS glyphs and CACHE_BUDGET
+ * bytes in PSRAM, shared by every size, so a steady page draws from the
+ * cache. "sdf" on serial prints the cache hit rate and rasterize times.
+ *
+ * Without HUD_SDF_NUMERALS begin() does nothing.
+ */
+namespace SdfFont
+{
+    constexpr uint8_t CACHE_SLOTS = 32;
+    constexpr uint32_t CACHE_BUDGET = 192 * 1024;
+
+    struct Stats
+    {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        uint32_t rasterUs = 0;     // Total time spent rasterizing
+        uint32_t rasterPixels = 0; // Total pixels rasterized
+        uint32_t bytes = 0;        // Cache bytes in use
+        uint8_t entries = 0;       // Cached glyphs
+    };
+
+    /**
+     * Fill in RobotoBlack_60 and RobotoBlack_200 as distance-field fonts.
+     * Call once after lv_init(), before anything uses the fonts.
+     */
+    void begin();
+
+    /**
+     * Make `font` a distance-field font of the atlas at `px` pixels.
+     */
+    void create(lv_font_t *font, uint16_t px);
+
+    const Stats &getStats();
+
+    /**
+     * Print the cache counters and cold rasterize times of the digits at the
+     * page sizes.
+     */
+    void print();
+}
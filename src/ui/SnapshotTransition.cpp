@@ -0,0 +1,127 @@
+#include "SnapshotTransition.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+bool SnapshotTransition::allocateBuffers(uint32_t size)
+{
+    if (bufferSize >= size)
+    {
+        return true;
+    }
+
+    for (uint8_t *&buffer : buffers)
+    {
+        heap_caps_free(buffer);
+        buffer = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (buffer == nullptr)
+        {
+            Serial.printf("SnapshotTransition: Cannot allocate %lu byte PSRAM buffer, swipes stay live\n",
+                          (unsigned long)size);
+            for (uint8_t *&other : buffers)
+            {
+                heap_caps_free(other);
+                other = nullptr;
+            }
+            bufferSize = 0;
+            return false;
+        }
+    }
+
+    bufferSize = size;
+    Serial.printf("SnapshotTransition: %d x %lu byte snapshot buffers in PSRAM\n", MAX_TILES, (unsigned long)size);
+    return true;
+}
+
+bool SnapshotTransition::cover(Cover &slot, lv_obj_t *tile, uint8_t *buffer)
+{
+    if (lv_snapshot_take_to_buf(tile, LV_IMG_CF_TRUE_COLOR, &slot.dsc, buffer, bufferSize) != LV_RES_OK)
+    {
+        return false;
+    }
+
+    // Hide the live widgets, remembering which ones we hid
+    uint32_t children = lv_obj_get_child_cnt(tile);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(tile, i);
+        if (!lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN))
+        {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_USER_1);
+        }
+    }
+
+    // Floating, so it stays put on tiles that scroll vertically
+    slot.image = lv_img_create(tile);
+    lv_obj_add_flag(slot.image, LV_OBJ_FLAG_FLOATING);
+    lv_obj_clear_flag(slot.image, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_img_set_src(slot.image, &slot.dsc);
+    lv_obj_set_pos(slot.image, 0, 0);
+    slot.tile = tile;
+    return true;
+}
+
+void SnapshotTransition::uncover(Cover &slot)
+{
+    lv_obj_del(slot.image);
+    slot.image = nullptr;
+
+    uint32_t children = lv_obj_get_child_cnt(slot.tile);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(slot.tile, i);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_USER_1))
+        {
+            lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_USER_1);
+        }
+    }
+    slot.tile = nullptr;
+}
+
+bool SnapshotTransition::begin(lv_obj_t *const *tiles, int count)
+{
+    if (!enabled || isActive() || count <= 0)
+    {
+        return false;
+    }
+
+    int64_t start = esp_timer_get_time();
+    if (!allocateBuffers(lv_snapshot_buf_size_needed(tiles[0], LV_IMG_CF_TRUE_COLOR)))
+    {
+        stats.fallbacks++;
+        return false;
+    }
+
+    for (int i = 0; i < count && coverCount < MAX_TILES; i++)
+    {
+        if (cover(covers[coverCount], tiles[i], buffers[coverCount]))
+        {
+            coverCount++;
+        }
+    }
+
+    uint32_t elapsed = esp_timer_get_time() - start;
+    if (coverCount == 0)
+    {
+        stats.fallbacks++;
+        return false;
+    }
+
+    stats.transitions++;
+    stats.tiles += coverCount;
+    stats.snapshotUs += elapsed;
+    if (elapsed > stats.snapshotMaxUs)
+    {
+        stats.snapshotMaxUs = elapsed;
+    }
+    return true;
+}
+
+void SnapshotTransition::end()
+{
+    for (int i = 0; i < coverCount; i++)
+    {
+        uncover(covers[i]);
+    }
+    coverCount = 0;
+}
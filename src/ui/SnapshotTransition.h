@@ -0,0 +1,72 @@
+#pragma once
+#include <lvgl.h>
+
+/**
+ * Bitmap stand-ins for tiles while the tileview is moving.
+ *
+ * At swipe start each given tile is rendered once into a PSRAM buffer with
+ * lv_snapshot, its live children are hidden and a floating image showing
+ * the snapshot is put on top. The swipe then only moves bitmaps instead of
+ * re-rendering the pages (and the 200 px speed font) every frame. When the
+ * swipe ends the images are deleted and the live widgets come back.
+ *
+ * Pages keep updating underneath; their changes show once the swipe ends.
+ * Buffers are allocated on the first swipe and reused afterwards.
+ */
+class SnapshotTransition
+{
+public:
+    // Tiles that can be covered at once (visible page and its neighbours)
+    static constexpr int MAX_TILES = 3;
+
+    struct Stats
+    {
+        uint32_t transitions = 0;  // Swipes that ran on snapshots
+        uint32_t fallbacks = 0;    // Swipes left live (no buffer or snapshot failed)
+        uint32_t tiles = 0;        // Tiles snapshotted in total
+        uint64_t snapshotUs = 0;   // Time spent taking snapshots
+        uint32_t snapshotMaxUs = 0; // Longest swipe start
+    };
+
+private:
+    struct Cover
+    {
+        lv_obj_t *tile = nullptr;
+        lv_obj_t *image = nullptr;
+        lv_img_dsc_t dsc;
+    };
+
+    uint8_t *buffers[MAX_TILES] = {};
+    uint32_t bufferSize = 0;
+    Cover covers[MAX_TILES];
+    int coverCount = 0;
+    bool enabled = true;
+    Stats stats;
+
+    bool allocateBuffers(uint32_t size);
+    bool cover(Cover &slot, lv_obj_t *tile, uint8_t *buffer);
+    void uncover(Cover &slot);
+
+public:
+    /**
+     * Snapshot and cover the given tiles (at most MAX_TILES, nearest first).
+     * Does nothing if disabled or already active.
+     * @return true if the tiles are now covered
+     */
+    bool begin(lv_obj_t *const *tiles, int count);
+
+    /**
+     * Remove the covers and show the live widgets again.
+     */
+    void end();
+
+    bool isActive() const { return coverCount > 0; }
+
+    /**
+     * Switch between snapshot and live swipes (A/B comparison).
+     */
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    const Stats &getStats() const { return stats; }
+};
@@ -0,0 +1,180 @@
+#include "StaticLayer.h"
+#include "FrameScheduler.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+// LV_OBJ_FLAG_USER_1 is taken by SnapshotTransition, USER_2 marks static widgets
+static constexpr lv_obj_flag_t BAKED = LV_OBJ_FLAG_USER_3;    // Static widget hidden behind the layer
+static constexpr lv_obj_flag_t SET_ASIDE = LV_OBJ_FLAG_USER_4; // Hidden while the layer is rendered
+
+bool StaticLayer::enabled = true;
+uint32_t StaticLayer::epoch = 1;
+volatile int8_t StaticLayer::requested = -1;
+
+bool StaticLayer::bake(lv_obj_t *tile)
+{
+    int64_t start = esp_timer_get_time();
+
+    // The layer is the tile's first screen, so render it scrolled to the top
+    lv_obj_update_layout(tile);
+    lv_coord_t scrollY = lv_obj_get_scroll_y(tile);
+    lv_scrollbar_mode_t scrollbar = lv_obj_get_scrollbar_mode(tile);
+    lv_obj_scroll_to_y(tile, 0, LV_ANIM_OFF);
+    lv_obj_set_scrollbar_mode(tile, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_update_layout(tile);
+
+    lv_area_t screen;
+    lv_obj_get_coords(tile, &screen);
+
+    // Leave only the static widgets that fit on the first screen
+    uint32_t objects = 0;
+    uint32_t children = lv_obj_get_child_cnt(tile);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(tile, i);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN))
+        {
+            continue;
+        }
+        lv_area_t coords;
+        lv_obj_get_coords(child, &coords);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_USER_2) && _lv_area_is_in(&coords, &screen, 0))
+        {
+            objects++;
+        }
+        else
+        {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN | SET_ASIDE);
+        }
+    }
+
+    bool ok = false;
+    if (objects > 0)
+    {
+        uint32_t size = lv_snapshot_buf_size_needed(tile, LV_IMG_CF_TRUE_COLOR);
+        if (bufferSize < size)
+        {
+            heap_caps_free(buffer);
+            buffer = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            bufferSize = buffer != nullptr ? size : 0;
+            if (buffer == nullptr)
+            {
+                Serial.printf("StaticLayer: Cannot allocate %lu byte PSRAM buffer, widgets stay live\n",
+                              (unsigned long)size);
+            }
+        }
+        ok = buffer != nullptr &&
+             lv_snapshot_take_to_buf(tile, LV_IMG_CF_TRUE_COLOR, &dsc, buffer, bufferSize) == LV_RES_OK;
+    }
+
+    // Dynamic widgets back; the baked ones give way to the layer
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(tile, i);
+        if (lv_obj_has_flag(child, SET_ASIDE))
+        {
+            lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN | SET_ASIDE);
+        }
+        else if (ok && lv_obj_has_flag(child, LV_OBJ_FLAG_USER_2) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN))
+        {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN | BAKED);
+        }
+    }
+
+    if (ok)
+    {
+        // Not floating: the layer scrolls with the content it was taken from
+        image = lv_img_create(tile);
+        lv_obj_clear_flag(image, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_img_set_src(image, &dsc);
+        lv_obj_set_pos(image, 0, 0);
+        lv_obj_move_background(image);
+
+        stats.bakes++;
+        stats.bakeUs = esp_timer_get_time() - start;
+        stats.objects = objects;
+    }
+    stats.bytes = bufferSize;
+
+    lv_obj_set_scrollbar_mode(tile, scrollbar);
+    lv_obj_scroll_to_y(tile, scrollY, LV_ANIM_OFF);
+    return ok;
+}
+
+void StaticLayer::unbake(lv_obj_t *tile)
+{
+    if (image == nullptr)
+    {
+        return;
+    }
+
+    lv_obj_del(image);
+    image = nullptr;
+    stats.objects = 0;
+
+    uint32_t children = lv_obj_get_child_cnt(tile);
+    for (uint32_t i = 0; i < children; i++)
+    {
+        lv_obj_t *child = lv_obj_get_child(tile, i);
+        if (lv_obj_has_flag(child, BAKED))
+        {
+            lv_obj_clear_flag(child, LV_OBJ_FLAG_HIDDEN | BAKED);
+        }
+    }
+}
+
+void StaticLayer::refresh(lv_obj_t *tile)
+{
+    if (!enabled)
+    {
+        unbake(tile);
+        bakedEpoch = 0;
+        return;
+    }
+    if (bakedEpoch == epoch)
+    {
+        return;
+    }
+
+    // Pages without static widgets just record that they are up to date
+    unbake(tile);
+    bake(tile);
+    bakedEpoch = epoch;
+}
+
+void StaticLayer::release()
+{
+    // The image goes with the tile's other children
+    image = nullptr;
+    bakedEpoch = 0;
+    heap_caps_free(buffer);
+    buffer = nullptr;
+    bufferSize = 0;
+    stats.bytes = 0;
+    stats.objects = 0;
+}
+
+void StaticLayer::request(bool on)
+{
+    requested = on;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+bool StaticLayer::applyRequested()
+{
+    int8_t pending = requested;
+    if (pending < 0)
+    {
+        return false;
+    }
+    requested = -1;
+    if ((bool)pending == enabled)
+    {
+        return false;
+    }
+
+    enabled = pending;
+    Serial.printf("StaticLayer: Static layers %s\n", enabled ? "on" : "off");
+    return true;
+}
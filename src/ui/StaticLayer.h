@@ -0,0 +1,85 @@
+#pragma once
+#include <lvgl.h>
+
+/**
+ * Pre-rendered background for the parts of a page that never change.
+ *
+ * Pages mark their fixed widgets (unit labels, headings, divider lines)
+ * with Page::markStatic(). After create() those widgets are rendered once,
+ * with the tile's background and nothing else, into an RGB565 buffer in
+ * PSRAM. The widgets are then hidden and an image of the buffer sits at
+ * the back of the tile, so every redraw blits the baked pixels and draws
+ * only the dynamic widgets over them instead of re-rendering the static
+ * glyphs and lines.
+ *
+ * The layer covers the tile's first screen; static widgets further down a
+ * scrolling tile stay live. A palette or font switch invalidates every
+ * layer and visible pages re-bake on their next update. The "layers off"
+ * serial command puts the live widgets back for A/B comparison.
+ */
+class StaticLayer
+{
+public:
+    struct Stats
+    {
+        uint32_t bakes = 0;   // Times the layer was rendered
+        uint32_t bakeUs = 0;  // Time the last bake took
+        uint32_t bytes = 0;   // PSRAM held by the layer
+        uint32_t objects = 0; // Widgets folded into the layer
+    };
+
+private:
+    lv_obj_t *image = nullptr;
+    lv_img_dsc_t dsc;
+    uint8_t *buffer = nullptr;
+    uint32_t bufferSize = 0;
+    uint32_t bakedEpoch = 0;
+    Stats stats;
+
+    static bool enabled;
+    static uint32_t epoch;
+    static volatile int8_t requested; // -1 = nothing pending
+
+    bool bake(lv_obj_t *tile);
+    void unbake(lv_obj_t *tile);
+
+public:
+    /**
+     * Flag a direct child of a tile as static.
+     */
+    static void markStatic(lv_obj_t *obj) { lv_obj_add_flag(obj, LV_OBJ_FLAG_USER_2); }
+
+    /**
+     * Bring the layer in line with the tile: bake it if it is missing or
+     * stale, or take it down if layers are switched off. Call from the
+     * display task after create() and while the tile is not covered by a
+     * swipe snapshot.
+     */
+    void refresh(lv_obj_t *tile);
+
+    /**
+     * Free the buffer. Call before the tile's children are deleted.
+     */
+    void release();
+
+    bool isBaked() const { return image != nullptr; }
+    const Stats &getStats() const { return stats; }
+
+    /**
+     * Mark every layer stale (styles or fonts changed).
+     */
+    static void invalidateAll() { epoch++; }
+
+    /**
+     * Ask for layers on or off from any task; applied by applyRequested().
+     */
+    static void request(bool on);
+
+    /**
+     * Apply a pending request. Call from the display task.
+     * @return true if the setting changed
+     */
+    static bool applyRequested();
+
+    static bool isEnabled() { return enabled; }
+};
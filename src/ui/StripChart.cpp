@@ -0,0 +1,337 @@
+#include "StripChart.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+void StripChart::setSeries(uint8_t index, float low, float high, Theme::Tone tone)
+{
+    if (index >= MAX_SERIES)
+    {
+        return;
+    }
+    Series &s = series[index];
+    s.low = (int16_t)lroundf(low * 10.0f);
+    s.high = (int16_t)lroundf(high * 10.0f);
+    s.tone = tone;
+    s.used = s.high > s.low;
+    drawnAll = false;
+}
+
+void StripChart::setGrid(float step, uint32_t everyMs)
+{
+    gridStep = (int16_t)lroundf(step * 10.0f);
+    gridColumns = everyMs / columnMs;
+    drawnAll = false;
+}
+
+// ============================================================================
+// MODEL
+// ============================================================================
+bool StripChart::allocate()
+{
+    // Read every column draw, so internal RAM
+    ring = (Column *)heap_caps_malloc(width * sizeof(Column), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring == nullptr)
+    {
+        Serial.println("StripChart: No memory for the sample ring");
+        return false;
+    }
+
+    for (uint16_t i = 0; i < width; i++)
+    {
+        for (uint8_t s = 0; s < MAX_SERIES; s++)
+        {
+            ring[i].low[s] = EMPTY_LOW;
+            ring[i].high[s] = EMPTY_HIGH;
+        }
+    }
+    for (uint8_t s = 0; s < MAX_SERIES; s++)
+    {
+        lastValue[s] = 0;
+        lastSampleMs[s] = 0;
+    }
+    return true;
+}
+
+void StripChart::openColumn(uint32_t start)
+{
+    head = head + 1 < width ? head + 1 : 0;
+    headColumn++;
+    headStartMs = start;
+
+    // A series sampled recently carries on from its last value
+    Column &column = ring[head];
+    for (uint8_t s = 0; s < MAX_SERIES; s++)
+    {
+        bool holding = lastSampleMs[s] != 0 && start - lastSampleMs[s] <= HOLD_MS;
+        column.low[s] = holding ? lastValue[s] : EMPTY_LOW;
+        column.high[s] = holding ? lastValue[s] : EMPTY_HIGH;
+    }
+}
+
+void StripChart::advance(uint32_t now)
+{
+    if (!started)
+    {
+        if (ring == nullptr && !allocate())
+        {
+            return;
+        }
+        headStartMs = now;
+        started = true;
+        return;
+    }
+
+    uint32_t due = (now - headStartMs) / columnMs;
+    if (due == 0)
+    {
+        return;
+    }
+
+    // After a long stall only the last window's worth can be seen; skip the rest
+    if (due > width)
+    {
+        uint32_t skip = due - width;
+        head = (head + skip) % width;
+        headColumn += skip;
+        headStartMs += skip * columnMs;
+        due = width;
+    }
+    for (uint32_t i = 0; i < due; i++)
+    {
+        openColumn(headStartMs + columnMs);
+    }
+}
+
+void StripChart::add(uint8_t index, float value)
+{
+    if (!started || index >= MAX_SERIES)
+    {
+        return;
+    }
+
+    float tenths = value * 10.0f;
+    int16_t v = tenths > 32000.0f ? 32000 : tenths < -32000.0f ? -32000 : (int16_t)lroundf(tenths);
+    Column &column = ring[head];
+    if (v < column.low[index])
+    {
+        column.low[index] = v;
+        headDirty = true;
+    }
+    if (v > column.high[index])
+    {
+        column.high[index] = v;
+        headDirty = true;
+    }
+    lastValue[index] = v;
+    lastSampleMs[index] = millis();
+}
+
+uint32_t StripChart::msToNextColumn(uint32_t now) const
+{
+    uint32_t elapsed = now - headStartMs;
+    return started && elapsed < columnMs ? columnMs - elapsed : columnMs;
+}
+
+// ============================================================================
+// VIEW
+// ============================================================================
+bool StripChart::create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y)
+{
+    if (ring == nullptr && !allocate())
+    {
+        return false;
+    }
+    if (pixels == nullptr)
+    {
+        size_t bytes = (size_t)width * height * sizeof(lv_color_t);
+        pixels = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (pixels == nullptr)
+        {
+            Serial.printf("StripChart: Cannot allocate %u byte PSRAM buffer\n", (unsigned)bytes);
+            return false;
+        }
+        dsc.header.always_zero = 0;
+        dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+        dsc.header.w = width;
+        dsc.header.h = height;
+        dsc.data_size = bytes;
+        dsc.data = (const uint8_t *)pixels;
+    }
+
+    // Clips the two images to one window's width
+    box = lv_obj_create(parent);
+    lv_obj_remove_style_all(box);
+    lv_obj_clear_flag(box, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_scrollbar_mode(box, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_size(box, width, height);
+    lv_obj_set_pos(box, x, y);
+
+    for (lv_obj_t *&image : images)
+    {
+        image = lv_img_create(box);
+        lv_obj_clear_flag(image, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_img_set_src(image, &dsc);
+    }
+
+    // The buffer may be from before a release; draw it from the model
+    drawnAll = false;
+    sync();
+    return true;
+}
+
+void StripChart::release()
+{
+    // Deleted with the parent's other children; the buffer is kept
+    box = nullptr;
+    images[0] = images[1] = nullptr;
+    drawnAll = false;
+}
+
+int32_t StripChart::row(uint8_t index, int32_t tenths) const
+{
+    const Series &s = series[index];
+    int32_t r = (height - 1) - (tenths - s.low) * (height - 1) / (s.high - s.low);
+    return r < 0 ? 0 : r >= height ? height - 1 : r;
+}
+
+void StripChart::drawColumn(int32_t column)
+{
+    // Ring slot of the column, the slot before it unless that is the oldest
+    uint32_t age = headColumn - column;
+    uint16_t slot = (head + width - age % width) % width;
+    const Column &current = ring[slot];
+    const Column *previous = age + 1 < width ? &ring[(slot + width - 1) % width] : nullptr;
+
+    lv_color_t *px = pixels + slot;
+    lv_color_t black = lv_color_black();
+    for (int32_t y = 0; y < height; y++)
+    {
+        px[y * width] = black;
+    }
+
+    // Dotted grid: time lines scroll with the data, value lines stay put
+    if (gridColumns != 0 && ((column % (int32_t)gridColumns) + gridColumns) % gridColumns == 0)
+    {
+        for (int32_t y = 0; y < height; y += GRID_DOT)
+        {
+            px[y * width] = gridColor;
+        }
+    }
+    if (gridStep > 0 && series[0].used && ((column % GRID_DOT) + GRID_DOT) % GRID_DOT == 0)
+    {
+        int32_t first = (series[0].low + gridStep - 1) / gridStep * gridStep;
+        for (int32_t v = first; v <= series[0].high; v += gridStep)
+        {
+            px[row(0, v) * width] = gridColor;
+        }
+    }
+
+    // Later series on top
+    for (uint8_t s = 0; s < MAX_SERIES; s++)
+    {
+        if (!series[s].used || current.low[s] > current.high[s])
+        {
+            continue;
+        }
+
+        // Reach the previous column's range so the trace has no breaks
+        int32_t low = current.low[s];
+        int32_t high = current.high[s];
+        if (previous != nullptr && previous->low[s] <= previous->high[s])
+        {
+            low = LV_MIN(low, previous->high[s]);
+            high = LV_MAX(high, previous->low[s]);
+        }
+
+        int32_t top = row(s, high);
+        int32_t bottom = LV_MIN(row(s, low) + 1, height - 1); // 2 px for a flat trace
+        for (int32_t y = top; y <= bottom; y++)
+        {
+            px[y * width] = colors[s];
+        }
+    }
+}
+
+void StripChart::pickColors()
+{
+    for (uint8_t s = 0; s < MAX_SERIES; s++)
+    {
+        colors[s] = Theme::color(series[s].tone);
+    }
+    gridColor = lv_color_mix(Theme::color(Theme::Tone::Secondary), lv_color_black(), GRID_OPA);
+}
+
+bool StripChart::colorsChanged() const
+{
+    for (uint8_t s = 0; s < MAX_SERIES; s++)
+    {
+        if (series[s].used && Theme::color(series[s].tone).full != colors[s].full)
+        {
+            return true;
+        }
+    }
+    return lv_color_mix(Theme::color(Theme::Tone::Secondary), lv_color_black(), GRID_OPA).full != gridColor.full;
+}
+
+void StripChart::placeImages()
+{
+    // Slot `head` at the right edge; the second image shows the slots after it
+    lv_coord_t x = width - 1 - head;
+    lv_obj_set_x(images[0], x);
+    lv_obj_set_x(images[1], x - width);
+}
+
+void StripChart::sync()
+{
+    if (box == nullptr || !started)
+    {
+        return;
+    }
+
+    bool scrolled = headColumn != drawnColumn;
+    if (drawnAll && !scrolled && !headDirty)
+    {
+        return;
+    }
+    int64_t start = esp_timer_get_time();
+
+    if (!drawnAll || headColumn - drawnColumn >= width || colorsChanged())
+    {
+        pickColors();
+        for (uint32_t age = width; age-- > 0;)
+        {
+            drawColumn((int32_t)(headColumn - age));
+        }
+        placeImages();
+        lv_obj_invalidate(box);
+        drawnAll = true;
+        stats.fullRenders++;
+    }
+    else
+    {
+        // The column last drawn may have had samples since, then any opened after it
+        for (uint32_t column = drawnColumn; column != headColumn + 1; column++)
+        {
+            drawColumn((int32_t)column);
+            stats.columns++;
+        }
+
+        if (scrolled)
+        {
+            // Moving the images invalidates the whole box
+            placeImages();
+        }
+        else
+        {
+            lv_area_t newest;
+            lv_obj_get_coords(box, &newest);
+            newest.x1 = newest.x2;
+            lv_obj_invalidate_area(box, &newest);
+        }
+    }
+
+    drawnColumn = headColumn;
+    headDirty = false;
+    stats.syncs++;
+    stats.drawUs += esp_timer_get_time() - start;
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "Theme.h"
+
+/**
+ * Rolling strip chart that scrolls by moving its view, not its pixels.
+ *
+ * lv_chart in shift mode re-renders every point of every series on each
+ * update, so the cost grows with the window. Here the model is a ring of
+ * WIDTH columns, each holding the min/max of the samples that fell into
+ * its slice of the window: add() folds a sample into the newest column,
+ * so downsampling happens on insertion and a column never changes once
+ * the next one opens. The pixels live in an RGB565 buffer in PSRAM laid
+ * out the same way, column i of the ring in column i of the buffer. New
+ * columns are drawn into the buffer one at a time, and the buffer is shown
+ * by two images side by side in a clipping box, so moving both one pixel
+ * to the left scrolls the chart: the oldest column wraps out of view and
+ * the newest appears on the right. Per update the chart draws only the
+ * columns that changed (the newest, plus any that opened since), whatever
+ * the window length; the panel still gets the whole box once per scroll.
+ *
+ * A series that stops being sampled holds its last value for HOLD_MS, so
+ * a slow sensor draws a line rather than dots, then leaves a gap. Each
+ * column is drawn down to its neighbour's range, so steps join up.
+ *
+ * The model (add(), advance()) doesn't touch LVGL and can be fed from a
+ * page's backgroundUpdate(); sync() brings the view up to date from the
+ * display task. A palette change redraws the buffer from the model.
+ */
+class StripChart
+{
+public:
+    static constexpr uint8_t MAX_SERIES = 2;
+
+    struct Stats
+    {
+        uint32_t syncs = 0;       // sync() calls that drew something
+        uint32_t columns = 0;     // Columns drawn incrementally
+        uint32_t fullRenders = 0; // Whole buffer redrawn
+        uint64_t drawUs = 0;      // Time spent drawing into the buffer
+    };
+
+private:
+    /**
+     * Value range of one series, in tenths, and its color.
+     */
+    struct Series
+    {
+        int16_t low = 0;
+        int16_t high = 1;
+        Theme::Tone tone = Theme::Tone::Primary;
+        bool used = false;
+    };
+
+    /**
+     * Downsampled samples of one column, in tenths. low > high = no data.
+     */
+    struct Column
+    {
+        int16_t low[MAX_SERIES];
+        int16_t high[MAX_SERIES];
+    };
+
+    static constexpr int16_t EMPTY_LOW = INT16_MAX;
+    static constexpr int16_t EMPTY_HIGH = INT16_MIN;
+    static constexpr uint32_t HOLD_MS = 2000;
+    static constexpr uint8_t GRID_DOT = 4;         // Grid lines are dotted every this many pixels
+    static constexpr lv_opa_t GRID_OPA = LV_OPA_40; // Of the Secondary tone
+
+    const uint16_t width;
+    const uint16_t height;
+    const uint32_t columnMs;
+
+    Series series[MAX_SERIES];
+    int16_t gridStep = 0;        // Horizontal grid spacing in series 0 tenths, 0 = none
+    uint32_t gridColumns = 0;    // Vertical grid every this many columns, 0 = none
+
+    // Model
+    Column *ring = nullptr;
+    uint16_t head = 0;           // Ring slot of the newest column
+    uint32_t headColumn = 0;     // Columns opened since the start
+    uint32_t headStartMs = 0;    // millis() the newest column opened
+    bool started = false;
+    bool headDirty = false;      // Newest column changed since sync()
+    int16_t lastValue[MAX_SERIES];
+    uint32_t lastSampleMs[MAX_SERIES];
+
+    // View
+    lv_color_t *pixels = nullptr;
+    lv_img_dsc_t dsc;
+    lv_obj_t *box = nullptr;
+    lv_obj_t *images[2] = {nullptr, nullptr};
+    uint32_t drawnColumn = 0;    // Oldest column that may have changed since it was drawn
+    bool drawnAll = false;       // Buffer matches the model up to drawnColumn
+    lv_color_t colors[MAX_SERIES];
+    lv_color_t gridColor;
+    Stats stats;
+
+    bool allocate();
+    void openColumn(uint32_t start);
+    int32_t row(uint8_t index, int32_t tenths) const;
+    void drawColumn(int32_t column);
+    void pickColors();
+    bool colorsChanged() const;
+    void placeImages();
+
+public:
+    /**
+     * @param width     columns, one per pixel
+     * @param height    rows
+     * @param windowMs  time the full width covers
+     */
+    StripChart(uint16_t width, uint16_t height, uint32_t windowMs)
+        : width(width), height(height), columnMs(windowMs / width)
+    {
+    }
+
+    /**
+     * Set a series' value range (bottom to top of the chart) and tone.
+     */
+    void setSeries(uint8_t index, float low, float high, Theme::Tone tone);
+
+    /**
+     * Dotted grid: a line every `step` of series 0, and a vertical one
+     * every `everyMs` of time. 0 leaves either out.
+     */
+    void setGrid(float step, uint32_t everyMs);
+
+    /**
+     * Open the columns that are due, so the chart scrolls with time even
+     * without samples. No LVGL calls.
+     */
+    void advance(uint32_t now);
+
+    /**
+     * Fold a sample into the newest column. No LVGL calls.
+     */
+    void add(uint8_t index, float value);
+
+    /**
+     * Create the chart box on `parent` at (x, y), behind anything created
+     * after it.
+     * @return false if there is no memory for the ring or the pixels
+     */
+    bool create(lv_obj_t *parent, lv_coord_t x, lv_coord_t y);
+
+    /**
+     * Forget the LVGL objects. Call before the parent is cleaned.
+     */
+    void release();
+
+    /**
+     * Draw what changed since the last call and scroll the view. Display
+     * task, while the chart is created.
+     */
+    void sync();
+
+    /**
+     * Time until the next column opens, to schedule the next sync.
+     */
+    uint32_t msToNextColumn(uint32_t now) const;
+
+    uint32_t getColumnMs() const { return columnMs; }
+    const Stats &getStats() const { return stats; }
+};
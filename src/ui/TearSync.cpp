@@ -0,0 +1,290 @@
+#include "TearSync.h"
+#include <esp_timer.h>
+
+// Singleton instance
+TearSync *TearSync::instance = nullptr;
+
+volatile int64_t TearSync::lastEdgeUs = 0;
+volatile uint32_t TearSync::periodUs = 0;
+volatile uint32_t TearSync::edges = 0;
+portMUX_TYPE TearSync::edgeLock = portMUX_INITIALIZER_UNLOCKED;
+
+TearSync &TearSync::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new TearSync();
+    }
+    return *instance;
+}
+
+bool TearSync::begin(int pin, uint16_t lines, bool linesAreColumns)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (pin < 0 || lines == 0 || disp == nullptr)
+    {
+        Serial.println("TearSync: No TE pin or display, flushes stay unpaced");
+        return false;
+    }
+
+    tePin = pin;
+    scanLines = lines;
+    scanLinesAreColumns = linesAreColumns;
+
+    pinMode(tePin, INPUT);
+    attachInterrupt(digitalPinToInterrupt(tePin), edgeIsr, RISING);
+
+    // Chain in front of the panel flush
+    originalFlush = disp->driver->flush_cb;
+    disp->driver->flush_cb = flushHook;
+
+    statsStart = millis();
+    Serial.printf("TearSync: Listening to TE on GPIO%d, %u scan lines along %s\n",
+                  tePin, scanLines, scanLinesAreColumns ? "x" : "y");
+    return true;
+}
+
+// ============================================================================
+// TE INTERRUPT
+// ============================================================================
+void IRAM_ATTR TearSync::edgeIsr()
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&edgeLock);
+    uint32_t delta = now - lastEdgeUs;
+    uint32_t period = periodUs;
+
+    // A missed pulse shows up as a double interval; don't average it in
+    bool plausible = delta >= MIN_PERIOD_US && delta <= MAX_PERIOD_US &&
+                     (period == 0 || delta < period + period / 2);
+    if (plausible)
+    {
+        periodUs = period == 0 ? delta : period + ((int32_t)(delta - period)) / 8;
+        edges = edges + 1;
+    }
+    lastEdgeUs = now;
+    portEXIT_CRITICAL_ISR(&edgeLock);
+}
+
+bool TearSync::hasSignal() const
+{
+    portENTER_CRITICAL(&edgeLock);
+    int64_t edge = lastEdgeUs;
+    uint32_t period = periodUs;
+    uint32_t count = edges;
+    portEXIT_CRITICAL(&edgeLock);
+
+    return count >= MIN_EDGES && esp_timer_get_time() - edge < 4 * (int64_t)period;
+}
+
+float TearSync::getPanelHz() const
+{
+    return hasSignal() ? 1000000.0f / periodUs : 0.0f;
+}
+
+float TearSync::getRefreshHz() const
+{
+    uint32_t elapsed = millis() - statsStart;
+    return elapsed ? stats.frames * 1000.0f / elapsed : 0.0f;
+}
+
+// ============================================================================
+// SCAN MODEL
+// ============================================================================
+bool TearSync::crossesScan(float startUs, float transferUs, float firstUs, float lastUs, float period) const
+{
+    float margin = MARGIN_US;
+
+    // The current scan and its neighbours either side are the only ones
+    // a transfer shorter than a period can meet
+    for (int k = -1; k <= 1; k++)
+    {
+        float first = firstUs + k * period;
+        float last = lastUs + k * period;
+
+        if (scanLinesAreColumns)
+        {
+            // Whole area in flight until the end: the scan must stay out of it
+            if (startUs < last + margin && startUs + transferUs > first - margin)
+            {
+                return true;
+            }
+            continue;
+        }
+
+        // Write sweeps the area; a reversed scan meets its last line first
+        float writeFirst = scanReversed ? startUs + transferUs : startUs;
+        float writeLast = scanReversed ? startUs : startUs + transferUs;
+        float atFirst = writeFirst - first;
+        float atLast = writeLast - last;
+
+        // Safe when the write is ahead of the scan at both ends, or behind it at both
+        bool ahead = atFirst < -margin && atLast < -margin;
+        bool behind = atFirst > margin && atLast > margin;
+        if (!ahead && !behind)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t TearSync::safeStart(int64_t now, const lv_area_t *area, uint32_t transferUs)
+{
+    portENTER_CRITICAL(&edgeLock);
+    int64_t edge = lastEdgeUs;
+    float period = periodUs;
+    portEXIT_CRITICAL(&edgeLock);
+
+    if (transferUs >= period)
+    {
+        return -1;
+    }
+
+    // Scan lines of the area, in scan order
+    int first = scanLinesAreColumns ? area->x1 : area->y1;
+    int last = scanLinesAreColumns ? area->x2 : area->y2;
+    if (scanReversed)
+    {
+        int flipped = scanLines - 1 - last;
+        last = scanLines - 1 - first;
+        first = flipped;
+    }
+
+    // Phases (time since the TE pulse) at which the scan reaches the area
+    float lineUs = period / scanLines;
+    float firstUs = first * lineUs;
+    float lastUs = (last + 1) * lineUs;
+    float phase = fmodf((float)(now - edge), period);
+
+    if (!crossesScan(phase, transferUs, firstUs, lastUs, period))
+    {
+        return now;
+    }
+
+    // Try starting with the scan at the top, just past the area's first
+    // line (write chases the scan) or just past its last line
+    const float candidates[] = {0.0f, firstUs + MARGIN_US + 1, lastUs + MARGIN_US + 1};
+    float bestDelay = -1.0f;
+    for (float candidate : candidates)
+    {
+        float delay = fmodf(candidate - phase + 2 * period, period);
+        if ((bestDelay < 0 || delay < bestDelay) &&
+            !crossesScan(fmodf(phase + delay, period), transferUs, firstUs, lastUs, period))
+        {
+            bestDelay = delay;
+        }
+    }
+    return bestDelay < 0 ? -1 : now + (int64_t)bestDelay;
+}
+
+void TearSync::waitUntil(int64_t timeUs)
+{
+    // Sleep off whole ticks, spin the rest for microsecond accuracy
+    while (timeUs - esp_timer_get_time() > 2000)
+    {
+        vTaskDelay(1);
+    }
+    while (esp_timer_get_time() < timeUs)
+    {
+    }
+}
+
+// ============================================================================
+// FLUSH HOOK
+// ============================================================================
+void TearSync::flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    TearSync &self = *instance;
+    self.applyRequested();
+
+    // lv_disp_flush_ready() clears this, read it before flushing
+    bool lastOfFrame = lv_disp_flush_is_last(drv);
+    // RGB565 on the wire, whatever depth LVGL renders at
+    uint32_t bytes = lv_area_get_size(area) * sizeof(uint16_t);
+    uint32_t transferUs = SETUP_US + bytes / self.bytesPerUs;
+    int64_t now = esp_timer_get_time();
+
+    if (!self.hasSignal())
+    {
+        self.stats.fallbacks++;
+    }
+    else
+    {
+        int64_t start = self.safeStart(now, area, transferUs);
+        if (start < 0 || (!self.enabled && start > now))
+        {
+            // Unpaced flushes are still checked, so "te off" shows what pacing saves
+            self.stats.tearRisks++;
+        }
+        else if (self.enabled && start > now)
+        {
+            self.waitUntil(start);
+            self.stats.deferred++;
+            self.stats.waitUs += esp_timer_get_time() - now;
+        }
+
+        if (self.enabled)
+        {
+            self.stats.flushes++;
+        }
+        else
+        {
+            self.stats.fallbacks++;
+        }
+    }
+
+    int64_t transferStart = esp_timer_get_time();
+    self.originalFlush(drv, area, color_p);
+    int64_t end = esp_timer_get_time();
+
+    // Learn the throughput from transfers big enough to swamp the setup cost
+    uint32_t elapsed = end - transferStart;
+    if (bytes >= MIN_LEARN_BYTES && elapsed > 2 * SETUP_US)
+    {
+        float measured = (float)bytes / (elapsed - SETUP_US);
+        self.bytesPerUs += (measured - self.bytesPerUs) / 8;
+    }
+
+    self.frameAccumUs += end - now;
+    if (lastOfFrame)
+    {
+        self.stats.frames++;
+        self.stats.frameUs.add(self.frameAccumUs);
+        self.frameAccumUs = 0;
+    }
+}
+
+void TearSync::printStats()
+{
+    const Histogram &h = stats.frameUs;
+
+    Serial.printf("[TearSync] Panel %.1f Hz, %.1f frames/s pushed, pacing %s, scan %s\n",
+                  getPanelHz(), getRefreshHz(), enabled ? "on" : "off", scanReversed ? "reversed" : "normal");
+    Serial.printf("[TearSync] %lu paced flushes, %lu deferred (avg wait %lu us), %lu tear risks, %lu unpaced, QSPI %.1f B/us\n",
+                  (unsigned long)stats.flushes, (unsigned long)stats.deferred,
+                  (unsigned long)(stats.deferred ? stats.waitUs / stats.deferred : 0),
+                  (unsigned long)stats.tearRisks, (unsigned long)stats.fallbacks, bytesPerUs);
+    Serial.printf("[TearSync] Frame n=%lu avg=%lu p50=%lu p95=%lu max=%lu us\n",
+                  (unsigned long)h.count, (unsigned long)h.average(), (unsigned long)h.percentile(50),
+                  (unsigned long)h.percentile(95), (unsigned long)h.maxUs);
+}
+
+void TearSync::applyRequested()
+{
+    int8_t reversed = reversedRequested;
+    if (reversed >= 0)
+    {
+        reversedRequested = -1;
+        scanReversed = reversed;
+    }
+
+    if (resetRequested)
+    {
+        resetRequested = false;
+        stats = Stats();
+        frameAccumUs = 0;
+        statsStart = millis();
+    }
+}
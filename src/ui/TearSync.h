@@ -0,0 +1,160 @@
+#pragma once
+#include <Arduino.h>
+#include <lvgl.h>
+#include "FrameProfiler.h"
+
+/**
+ * Flush pacing against the panel's tearing effect (TE) output.
+ *
+ * The panel pulses TE once per refresh, at the start of vertical blanking.
+ * An interrupt timestamps every pulse, which gives the scan period and the
+ * phase of the scan line at any moment. Before each flush the transfer time
+ * is estimated from the byte count and the measured QSPI throughput, and the
+ * transfer is started only when the scan line won't cross the area while
+ * it is written. If starting now would tear, the flush waits for the
+ * earliest safe start in the next scan; if no start is safe (the area is
+ * too big to fit between scans) it goes out immediately and is counted as a
+ * tear risk.
+ *
+ * Which way the write crosses the scan depends on the rotation: in portrait
+ * the panel rows are LVGL rows and the write follows the scan; in landscape
+ * the scan lines are LVGL columns, so every line of the area is in flight
+ * until the last row of the transfer and the scan must stay out of the area
+ * for the whole transfer.
+ *
+ * Chains in front of the display driver's flush callback like FrameProfiler,
+ * so the vendor helper is left alone. Without TE pulses it passes flushes
+ * straight through.
+ */
+class TearSync
+{
+public:
+    struct Stats
+    {
+        uint32_t flushes = 0;   // Flushes paced against TE
+        uint32_t deferred = 0;  // Flushes that waited for a safe start
+        uint32_t tearRisks = 0; // Flushes started with the scan line crossing them
+        uint32_t fallbacks = 0; // Flushes passed through (no TE signal or disabled)
+        uint32_t frames = 0;    // Completed frames (last flush of a refresh)
+        uint64_t waitUs = 0;    // Time spent waiting for a safe start
+        Histogram frameUs;      // Wait + transfer per frame
+    };
+
+private:
+    // Singleton instance
+    static TearSync *instance;
+
+    // Private constructor for singleton
+    TearSync() = default;
+
+    // Keep this far from the scan line either side, covers estimate error
+    static constexpr uint32_t MARGIN_US = 300;
+    // Fixed cost of a flush (address window commands, CS toggling)
+    static constexpr uint32_t SETUP_US = 40;
+    // Flushes smaller than this don't update the throughput estimate
+    static constexpr uint32_t MIN_LEARN_BYTES = 4096;
+    // Accepted TE intervals; anything else is a glitch or a missed pulse
+    static constexpr uint32_t MIN_PERIOD_US = 5000;
+    static constexpr uint32_t MAX_PERIOD_US = 50000;
+    // Pulses needed before the period estimate is trusted
+    static constexpr uint32_t MIN_EDGES = 8;
+
+    int tePin = -1;
+    uint16_t scanLines = 0;
+    bool scanLinesAreColumns = false;
+    bool scanReversed = false;
+    bool enabled = true;
+
+    // Set from other tasks, applied by the next flush
+    volatile bool resetRequested = false;
+    volatile int8_t reversedRequested = -1; // -1 = nothing pending
+
+    // Written by the TE interrupt
+    static volatile int64_t lastEdgeUs;
+    static volatile uint32_t periodUs;
+    static volatile uint32_t edges;
+    static portMUX_TYPE edgeLock;
+
+    // Learned QSPI throughput
+    float bytesPerUs = 20.0f;
+
+    void (*originalFlush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = nullptr;
+
+    Stats stats;
+    uint32_t frameAccumUs = 0;
+    uint32_t statsStart = 0;
+
+    static void IRAM_ATTR edgeIsr();
+    static void flushHook(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+    /**
+     * Whether a transfer starting at scan phase `startUs` and lasting
+     * `transferUs` crosses the scan line, for an area whose first and last
+     * scan lines are passed at phases `firstUs` and `lastUs`.
+     */
+    bool crossesScan(float startUs, float transferUs, float firstUs, float lastUs, float period) const;
+
+    /**
+     * Earliest safe start time for an area, or -1 if no start avoids the scan.
+     */
+    int64_t safeStart(int64_t now, const lv_area_t *area, uint32_t transferUs);
+
+    void waitUntil(int64_t timeUs);
+    void applyRequested();
+
+public:
+    // Get singleton instance
+    static TearSync &getInstance();
+
+    // Delete copy constructor and assignment
+    TearSync(const TearSync &) = delete;
+    TearSync &operator=(const TearSync &) = delete;
+
+    /**
+     * Listen to TE and hook the default display's flush.
+     * Call after the LVGL display is registered.
+     * @param pin                 TE input pin
+     * @param lines               Scan lines of the panel (its native height)
+     * @param linesAreColumns     True when the panel is rotated so its scan
+     *                            lines are LVGL columns
+     * @return false if there is no TE pin or display
+     */
+    bool begin(int pin, uint16_t lines, bool linesAreColumns);
+
+    /**
+     * Switch pacing on and off (A/B comparison). Off passes flushes straight through.
+     */
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Flip the scan direction, for panels mounted the other way round.
+     * Safe from any task; takes effect from the next flush.
+     */
+    void requestScanReversed(bool reversed) { reversedRequested = reversed; }
+    bool isScanReversed() const { return scanReversed; }
+
+    /**
+     * True once enough TE pulses arrived to trust the period.
+     */
+    bool hasSignal() const;
+
+    /**
+     * Panel refresh rate from the TE period, in Hz (0 without a signal).
+     */
+    float getPanelHz() const;
+
+    /**
+     * Frames actually pushed per second since the last reset.
+     */
+    float getRefreshHz() const;
+
+    const Stats &getStats() const { return stats; }
+
+    void printStats();
+
+    /**
+     * Clear the stats from any task; done at the next flush.
+     */
+    void requestReset() { resetRequested = true; }
+};
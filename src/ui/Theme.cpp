@@ -0,0 +1,235 @@
+#include "Theme.h"
+#include "FontResidency.h"
+#include "FrameScheduler.h"
+#include "SdfFont.h"
+#include "StaticLayer.h"
+#include <Arduino.h>
+
+namespace
+{
+    constexpr int TEXT_COUNT = (int)Theme::Text::Count;
+    constexpr int TONE_COUNT = (int)Theme::Tone::Count;
+
+    const lv_font_t *const TEXT_FONTS[TEXT_COUNT] = {
+        &lv_font_montserrat_22,
+        &lv_font_montserrat_28,
+        &lv_font_montserrat_34,
+        &lv_font_montserrat_48,
+        &RobotoBlack_60,
+        &RobotoBlack_200,
+    };
+
+    // Tone colors per mode, as 0xRRGGBB
+    const uint32_t PALETTES[(int)Theme::Mode::Count][TONE_COUNT] = {
+        // Day: white values on black, the original palette
+        {0xFFFFFF, 0xAAAAAA, 0xFFEB3B, 0x4CAF50, 0xFFEB3B, 0xFF9800, 0xAA4336},
+        // Night: dimmer, warm colors that don't wreck night vision
+        {0xC8642D, 0x6E3C23, 0xA08C28, 0x3C7832, 0xA08C28, 0xA05A14, 0x8C2D23},
+    };
+
+    const char *const MODE_NAMES[(int)Theme::Mode::Count] = {"day", "night"};
+
+    // Styles stay empty (no property storage) until something uses them
+    lv_style_t textStyles[TEXT_COUNT][TONE_COUNT];
+    lv_style_t toneStyles[TONE_COUNT];
+
+    Theme::Mode mode = Theme::Mode::Day;
+    volatile Theme::Mode requestedMode = Theme::Mode::Count; // Count = nothing pending
+    bool secondaryDimmed = false;
+    bool ready = false;
+
+    lv_color_t paletteColor(int tone)
+    {
+        lv_color_t c = lv_color_hex(PALETTES[(int)mode][tone]);
+        if (secondaryDimmed && tone == (int)Theme::Tone::Secondary)
+        {
+            c = lv_color_mix(c, lv_color_black(), Theme::SECONDARY_DIM);
+        }
+        return c;
+    }
+
+    void applyPalette()
+    {
+        for (int tone = 0; tone < TONE_COUNT; tone++)
+        {
+            lv_color_t c = paletteColor(tone);
+            for (int text = 0; text < TEXT_COUNT; text++)
+            {
+                if (!lv_style_is_empty(&textStyles[text][tone]))
+                {
+                    lv_style_set_text_color(&textStyles[text][tone], c);
+                }
+            }
+            if (!lv_style_is_empty(&toneStyles[tone]))
+            {
+                lv_style_set_text_color(&toneStyles[tone], c);
+                lv_style_set_line_color(&toneStyles[tone], c);
+                lv_style_set_arc_color(&toneStyles[tone], c);
+                lv_style_set_img_recolor(&toneStyles[tone], c);
+                lv_style_set_bg_color(&toneStyles[tone], c);
+            }
+        }
+    }
+}
+
+namespace Theme
+{
+    void init()
+    {
+        if (ready)
+        {
+            return;
+        }
+
+        for (auto &row : textStyles)
+        {
+            for (lv_style_t &style : row)
+            {
+                lv_style_init(&style);
+            }
+        }
+        for (lv_style_t &style : toneStyles)
+        {
+            lv_style_init(&style);
+        }
+        Assets::begin();
+        SdfFont::begin();
+        FontResidency::begin();
+        ready = true;
+    }
+
+    void setMode(Mode newMode)
+    {
+        if (newMode >= Mode::Count || newMode == mode)
+        {
+            return;
+        }
+
+        mode = newMode;
+        applyPalette();
+
+        // Every object picks up the new colors in the same refresh
+        lv_obj_report_style_change(nullptr);
+        StaticLayer::invalidateAll();
+        Serial.printf("Theme: Switched to %s palette\n", MODE_NAMES[(int)mode]);
+    }
+
+    void setSecondaryDimmed(bool dimmed)
+    {
+        if (dimmed == secondaryDimmed)
+        {
+            return;
+        }
+
+        secondaryDimmed = dimmed;
+        applyPalette();
+        lv_obj_report_style_change(nullptr);
+        StaticLayer::invalidateAll();
+        Serial.printf("Theme: Secondary tone %s\n", dimmed ? "dimmed" : "restored");
+    }
+
+    bool isSecondaryDimmed()
+    {
+        return secondaryDimmed;
+    }
+
+    void refreshFonts()
+    {
+        for (int text = 0; text < TEXT_COUNT; text++)
+        {
+            const lv_font_t *font = FontResidency::resolve(TEXT_FONTS[text]);
+            for (lv_style_t &s : textStyles[text])
+            {
+                if (!lv_style_is_empty(&s))
+                {
+                    lv_style_set_text_font(&s, font);
+                }
+            }
+        }
+        lv_obj_report_style_change(nullptr);
+        StaticLayer::invalidateAll();
+    }
+
+    Mode getMode()
+    {
+        return mode;
+    }
+
+    const char *modeName(Mode which)
+    {
+        return which < Mode::Count ? MODE_NAMES[(int)which] : "?";
+    }
+
+    void requestMode(Mode newMode)
+    {
+        requestedMode = newMode;
+        FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+    }
+
+    void applyRequestedMode()
+    {
+        Mode pending = requestedMode;
+        if (pending != Mode::Count)
+        {
+            requestedMode = Mode::Count;
+            setMode(pending);
+        }
+    }
+
+    lv_style_t *style(Text text, Tone tone)
+    {
+        lv_style_t *s = &textStyles[(int)text][(int)tone];
+        if (lv_style_is_empty(s))
+        {
+            lv_style_set_text_font(s, FontResidency::resolve(TEXT_FONTS[(int)text]));
+            lv_style_set_text_color(s, paletteColor((int)tone));
+        }
+        return s;
+    }
+
+    lv_style_t *style(Tone tone)
+    {
+        lv_style_t *s = &toneStyles[(int)tone];
+        if (lv_style_is_empty(s))
+        {
+            lv_style_set_text_color(s, paletteColor((int)tone));
+            lv_style_set_line_color(s, paletteColor((int)tone));
+            lv_style_set_arc_color(s, paletteColor((int)tone));
+            lv_style_set_img_recolor(s, paletteColor((int)tone));
+            lv_style_set_bg_color(s, paletteColor((int)tone));
+        }
+        return s;
+    }
+
+    const lv_font_t *font(Text text)
+    {
+        return FontResidency::resolve(TEXT_FONTS[(int)text]);
+    }
+
+    lv_color_t color(Tone tone)
+    {
+        return paletteColor((int)tone);
+    }
+
+    bool setTone(lv_obj_t *obj, Tone tone)
+    {
+        const lv_style_t *first = &textStyles[0][0];
+        for (uint32_t i = 0; i < obj->style_cnt; i++)
+        {
+            lv_style_t *current = obj->styles[i].style;
+            if (current < first || current >= first + TEXT_COUNT * TONE_COUNT)
+            {
+                continue;
+            }
+
+            int index = current - first;
+            if (index % TONE_COUNT != (int)tone)
+            {
+                lv_obj_remove_style(obj, current, 0);
+                lv_obj_add_style(obj, style((Text)(index / TONE_COUNT), tone), 0);
+            }
+            return true;
+        }
+        return false;
+    }
+}
@@ -1,26 +1,130 @@
 #pragma once
+#include "Assets.h"
 #include <lvgl.h>
 
 /**
- * Shared color theme for the display.
- * Include this header in any page that needs access to the color palette.
+ * Shared theme for the display.
+ *
+ * Pages don't set fonts and colors on their objects one by one - each label
+ * gets one shared style for its text role and tone (font + color) from the
+ * table here, attached by reference. Its local style is then left holding
+ * only its position, and switching between the day and night palettes only
+ * rewrites the shared styles and refreshes once.
+ *
+ * Include this header in any page that needs access to the styles.
  */
 namespace Theme
 {
-    // Initialize all theme colors - call once at startup
-    inline void init()
+    /**
+     * Text roles, each one font.
+     */
+    enum class Text : uint8_t
     {
-        // Colors are initialized on first use via the getter functions
+        Body,        // Montserrat 22 - info rows
+        Caption,     // Montserrat 28 - status line, section headers
+        Title,       // Montserrat 34 - page title, small units
+        Units,       // Montserrat 48 - main speed units
+        ValueMedium, // Roboto Black 60 - clock, secondary readouts
+        ValueLarge,  // Roboto Black 200 - main speed
+        Count
+    };
+
+    /**
+     * Tones: text and line color, looked up in the active palette.
+     */
+    enum class Tone : uint8_t
+    {
+        Primary,   // Live values
+        Secondary, // Labels, units, dividers
+        Accent,    // Debug header
+        Good,
+        Fair,
+        Poor,
+        Bad,
+        Count
+    };
+
+    enum class Mode : uint8_t
+    {
+        Day,
+        Night,
+        Count
+    };
+
+    /**
+     * Build the style tables. Call once after lv_init(), before any page is created.
+     */
+    void init();
+
+    /**
+     * Switch palette. Every object using a theme style repaints on the next refresh.
+     * Display task only - other tasks use requestMode().
+     */
+    void setMode(Mode mode);
+    Mode getMode();
+    const char *modeName(Mode mode);
+
+    /**
+     * Dim the Secondary tone (labels, units, dividers) to SECONDARY_DIM of its
+     * palette color, on top of either palette. PowerEstimator uses this before
+     * it takes panel brightness down. Display task only.
+     */
+    constexpr uint8_t SECONDARY_DIM = 128; // Of 255
+    void setSecondaryDimmed(bool dimmed);
+    bool isSecondaryDimmed();
+
+    /**
+     * Put the fonts FontResidency currently resolves to back into the text
+     * styles, after it switches between flash and RAM copies. Display task only.
+     */
+    void refreshFonts();
+
+    /**
+     * Ask for a palette switch from any task. Applied by applyRequestedMode()
+     * on the display task.
+     */
+    void requestMode(Mode mode);
+    void applyRequestedMode();
+
+    /**
+     * Shared style for a text role in a tone (labels), or for a tone alone
+     * (lines, arcs and A8 images, which take the tone as their recolor).
+     * Filled in on first use.
+     */
+    lv_style_t *style(Text text, Tone tone);
+    lv_style_t *style(Tone tone);
+
+    /**
+     * Font a text role currently draws with (the RAM copy if FontResidency uses one).
+     */
+    const lv_font_t *font(Text text);
+
+    /**
+     * Color of a tone in the active palette, for drawing outside the styles.
+     */
+    lv_color_t color(Tone tone);
+
+    /**
+     * Attach a label's text style to its main part.
+     */
+    inline void apply(lv_obj_t *obj, Text text, Tone tone)
+    {
+        lv_obj_add_style(obj, style(text, tone), 0);
+    }
+
+    /**
+     * Attach a tone-only style (lines and other non-text objects). It
+     * also sets the background color, seen only where bg_opa is set.
+     */
+    inline void apply(lv_obj_t *obj, Tone tone)
+    {
+        lv_obj_add_style(obj, style(tone), 0);
     }
 
-    // Color getters - these return consistent colors across all pages
-    inline lv_color_t white() { return lv_color_white(); }
-    inline lv_color_t black() { return lv_color_black(); }
-    inline lv_color_t grey() { return lv_color_make(0xAA, 0xAA, 0xAA); }
-    inline lv_color_t darkGrey() { return lv_color_make(0x5C, 0x5C, 0x5C); }
-    inline lv_color_t veryDarkGrey() { return lv_color_make(0x32, 0x32, 0x32); }
-    inline lv_color_t green() { return lv_color_make(0x4C, 0xAF, 0x50); }
-    inline lv_color_t yellow() { return lv_color_make(0xFF, 0xEB, 0x3B); }
-    inline lv_color_t orange() { return lv_color_make(0xFF, 0x98, 0x00); }
-    inline lv_color_t red() { return lv_color_make(0xAA, 0x43, 0x36); }
+    /**
+     * Change the tone of a label set up with apply(obj, text, tone),
+     * keeping its text role.
+     * @return false if the label has no theme text style
+     */
+    bool setTone(lv_obj_t *obj, Tone tone);
 }
@@ -8,6 +8,7 @@
  */
 #include <Arduino.h>
 #include "LV_Helper.h"
+#include "panel_lut.h"
 
 #if LVGL_VERSION_MAJOR == 8
 
@@ -25,12 +26,22 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
 {
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
+#if LV_COLOR_DEPTH == 8
+    // RGB332 from LVGL, expanded to RGB565 as it goes out
+    static_cast<LilyGo_Display *>(disp_drv->user_data)->pushColors(area->x1, area->y1, w, h, (const uint8_t *)color_p, panel_lut_get());
+#else
     static_cast<LilyGo_Display *>(disp_drv->user_data)->pushColors(area->x1, area->y1, w, h, (uint16_t *)color_p);
+#endif
     lv_disp_flush_ready(disp_drv);
 }
 
 static void disp_flushDMA(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
+#if LV_COLOR_DEPTH == 8
+    // The indexed push already overlaps the expansion with DMA
+    disp_flush(disp_drv, area, color_p);
+    return;
+#endif
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
     static_cast<LilyGo_Display *>(disp_drv->user_data)->setAddrWindow(area->x1, area->y1, area->x2, area->y2);
@@ -124,6 +135,9 @@ static void lv_rounder_cb(lv_disp_drv_t *disp_drv, lv_area_t *area)
 void beginLvglHelperDMA(LilyGo_Display &board, bool debug)
 {
     lv_init();
+#if LV_COLOR_DEPTH == 8
+    panel_lut_init();
+#endif
 
 #if LV_USE_LOG
     if (debug)
@@ -179,6 +193,9 @@ void beginLvglHelper(LilyGo_Display &board, bool debug)
 {
 
     lv_init();
+#if LV_COLOR_DEPTH == 8
+    panel_lut_init();
+#endif
 
 #if LV_USE_LOG
     if (debug)
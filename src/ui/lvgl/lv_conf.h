@@ -23,11 +23,22 @@
    COLOR SETTINGS
  *====================*/
 
-/*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)*/
+/*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)
+ *The T-Display-AMOLED-rgb332 environment sets HUD_COLOR_DEPTH=8; the flush
+ *expands to RGB565 for the panel (see panel_lut.h)*/
+#ifdef HUD_COLOR_DEPTH
+#define LV_COLOR_DEPTH HUD_COLOR_DEPTH
+#else
 #define LV_COLOR_DEPTH 16
+#endif
 
-/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface (e.g. SPI)*/
+/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface (e.g. SPI)
+ *(8-bit builds get the swapped order from panel_lut instead)*/
+#if LV_COLOR_DEPTH == 16
 #define LV_COLOR_16_SWAP 1
+#else
+#define LV_COLOR_16_SWAP 0
+#endif
 
 /*Enable features to draw on transparent background.
  *It's required if opa, and transform_* style properties are used.
@@ -60,10 +71,11 @@
 #endif
 
 #else       /*LV_MEM_CUSTOM*/
-#define LV_MEM_CUSTOM_INCLUDE <esp32-hal-psram.h>   /*Header for the dynamic memory function*/
-#define LV_MEM_CUSTOM_ALLOC   ps_malloc
-#define LV_MEM_CUSTOM_FREE    free
-#define LV_MEM_CUSTOM_REALLOC ps_realloc
+/*Small blocks from internal SRAM pools, large ones from PSRAM (see tiered_alloc.h)*/
+#define LV_MEM_CUSTOM_INCLUDE "tiered_alloc.h"   /*Header for the dynamic memory function*/
+#define LV_MEM_CUSTOM_ALLOC   tiered_alloc
+#define LV_MEM_CUSTOM_FREE    tiered_free
+#define LV_MEM_CUSTOM_REALLOC tiered_realloc
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -331,8 +343,14 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*Compiler prefix for a big array declaration in RAM*/
 #define LV_ATTRIBUTE_LARGE_RAM_ARRAY
 
-/*Place performance critical functions into a faster memory (e.g RAM)*/
+/*Place performance critical functions into a faster memory (e.g RAM)
+ *The T-Display-AMOLED-fastmem environment defines HUD_FAST_MEM to put them in IRAM*/
+#ifdef HUD_FAST_MEM
+#include <esp_attr.h>
+#define LV_ATTRIBUTE_FAST_MEM IRAM_ATTR
+#else
 #define LV_ATTRIBUTE_FAST_MEM
+#endif
 
 /*Prefix variables that are used in GPU accelerated operations, often these need to be placed in RAM sections that are DMA accessible*/
 #define LV_ATTRIBUTE_DMA
@@ -396,7 +414,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
 /*Enables/disables support for compressed fonts.*/
-#define LV_USE_FONT_COMPRESSED 0
+#define LV_USE_FONT_COMPRESSED 1
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -677,7 +695,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
  *----------*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
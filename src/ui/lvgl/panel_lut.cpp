@@ -0,0 +1,34 @@
+/**
+ * @file      panel_lut.cpp
+ * @brief     RGB332 to RGB565 expansion table for 8-bit LVGL builds
+ *
+ * Each channel is scaled to the full RGB565 range with rounding, so white
+ * stays 0xFFFF and the anti-aliasing ramps keep their end points. The table
+ * is 512 bytes in internal DRAM.
+ */
+#include "panel_lut.h"
+
+static uint16_t lut[256];
+
+void panel_lut_init(void)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        // lv_color8_t: red in the top 3 bits, then 3 of green, 2 of blue
+        uint16_t c = panel_lut_rgb565((uint8_t)i);
+        lut[i] = (uint16_t)((c >> 8) | (c << 8));
+    }
+}
+
+const uint16_t *panel_lut_get(void)
+{
+    return lut;
+}
+
+uint16_t panel_lut_rgb565(uint8_t index)
+{
+    uint32_t r = ((index >> 5) * 31 + 3) / 7;
+    uint32_t g = (((index >> 2) & 7) * 63 + 3) / 7;
+    uint32_t b = ((index & 3) * 31 + 1) / 3;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
@@ -0,0 +1,33 @@
+/**
+ * @file      panel_lut.h
+ * @brief     RGB332 to RGB565 expansion table for 8-bit LVGL builds
+ *
+ * With HUD_COLOR_DEPTH=8 LVGL renders and blends in RGB332, one byte per
+ * pixel, which halves the draw buffer and the bytes every blend touches.
+ * The panel still takes RGB565: the flush looks each pixel up in this
+ * table while it sends or rotates it (LilyGo_AMOLED::pushColors).
+ *
+ * Entries are in the panel's byte order, the same order LV_COLOR_16_SWAP
+ * gives the 16-bit build. The table is usable in either build so the
+ * headless renderer can show what the panel would.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fill the table. Call once before the first flush */
+void panel_lut_init(void);
+
+/* 256 RGB565 entries, indexed by lv_color8_t.full */
+const uint16_t *panel_lut_get(void);
+
+/* The entry for one RGB332 index as plain (unswapped) RGB565 */
+uint16_t panel_lut_rgb565(uint8_t index);
+
+#ifdef __cplusplus
+}
+#endif
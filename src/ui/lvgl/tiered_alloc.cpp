@@ -0,0 +1,297 @@
+/**
+ * @file      tiered_alloc.cpp
+ * @brief     Tiered SRAM/PSRAM allocator for LVGL
+ *
+ * All calls come from LVGL, which only runs on the display task, so the
+ * pools are not locked.
+ */
+#include "tiered_alloc.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <lv_conf.h>
+
+namespace
+{
+    struct Pool
+    {
+        uint16_t size;
+        uint16_t blocks;
+        uint8_t *base;
+        uint16_t *requested; // Requested size per block, for fragmentation stats
+        void *freeList;
+        tiered_class_stats_t stats;
+    };
+
+    // Pool storage lives in .bss, which is internal SRAM
+#define TIERED_ALLOC_CLASS(size, count)                                \
+    uint8_t poolData##size[(size) * (count)] __attribute__((aligned(16))); \
+    uint16_t poolRequested##size[count];
+    TIERED_ALLOC_CLASSES
+#undef TIERED_ALLOC_CLASS
+
+    Pool pools[TIERED_ALLOC_CLASS_COUNT] = {
+#define TIERED_ALLOC_CLASS(size, count) {size, count, poolData##size, poolRequested##size, nullptr, {}},
+        TIERED_ALLOC_CLASSES
+#undef TIERED_ALLOC_CLASS
+    };
+
+    bool poolsReady = false;
+    tiered_placement_t placement = TIERED_ALLOC_DEFAULT_PLACEMENT;
+    tiered_stats_t heapStats = {};
+
+    const char *const PLACEMENT_NAMES[TIERED_PLACEMENT_COUNT] = {"tiered", "psram", "internal"};
+
+    void initPools()
+    {
+        for (Pool &pool : pools)
+        {
+            // Thread every block onto the free list
+            pool.freeList = nullptr;
+            for (int i = pool.blocks - 1; i >= 0; i--)
+            {
+                void *block = pool.base + (size_t)i * pool.size;
+                *(void **)block = pool.freeList;
+                pool.freeList = block;
+            }
+            pool.stats.block_size = pool.size;
+            pool.stats.blocks = pool.blocks;
+        }
+        poolsReady = true;
+    }
+
+    Pool *findPool(const void *ptr)
+    {
+        const uint8_t *p = (const uint8_t *)ptr;
+        for (Pool &pool : pools)
+        {
+            if (p >= pool.base && p < pool.base + (size_t)pool.size * pool.blocks)
+            {
+                return &pool;
+            }
+        }
+        return nullptr;
+    }
+
+    void *poolAlloc(size_t size)
+    {
+        for (Pool &pool : pools)
+        {
+            if (size > pool.size)
+            {
+                continue;
+            }
+            if (pool.freeList == nullptr)
+            {
+                pool.stats.misses++;
+                return nullptr;
+            }
+
+            void *block = pool.freeList;
+            pool.freeList = *(void **)block;
+
+            pool.requested[((uint8_t *)block - pool.base) / pool.size] = size;
+            pool.stats.hits++;
+            pool.stats.in_use++;
+            pool.stats.requested_in_use += size;
+            if (pool.stats.in_use > pool.stats.peak)
+            {
+                pool.stats.peak = pool.stats.in_use;
+            }
+            return block;
+        }
+        return nullptr;
+    }
+
+    void poolFree(Pool &pool, void *block)
+    {
+        pool.stats.in_use--;
+        pool.stats.requested_in_use -= pool.requested[((uint8_t *)block - pool.base) / pool.size];
+        *(void **)block = pool.freeList;
+        pool.freeList = block;
+    }
+
+    void account(void *ptr, int sign)
+    {
+        uint32_t bytes = heap_caps_get_allocated_size(ptr);
+        if (esp_ptr_external_ram(ptr))
+        {
+            heapStats.psram_allocs += sign;
+            heapStats.psram_bytes += sign * (int32_t)bytes;
+        }
+        else
+        {
+            heapStats.internal_allocs += sign;
+            heapStats.internal_bytes += sign * (int32_t)bytes;
+        }
+    }
+
+    void *heapAlloc(size_t size, bool internal)
+    {
+        void *ptr;
+        if (internal)
+        {
+            ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            if (ptr == nullptr)
+            {
+                ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            }
+        }
+        else
+        {
+            ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (ptr == nullptr)
+            {
+                ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+            }
+        }
+
+        if (ptr == nullptr)
+        {
+            heapStats.failures++;
+            return nullptr;
+        }
+        account(ptr, 1);
+        return ptr;
+    }
+
+    bool internalHasRoomFor(size_t size)
+    {
+        return heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) > size + TIERED_ALLOC_INTERNAL_RESERVE;
+    }
+}
+
+extern "C" void *tiered_alloc(size_t size)
+{
+    if (!poolsReady)
+    {
+        initPools();
+    }
+
+    switch (placement)
+    {
+    case TIERED_PLACEMENT_PSRAM:
+        return heapAlloc(size, false);
+
+    case TIERED_PLACEMENT_INTERNAL:
+        return heapAlloc(size, true);
+
+    default:
+        break;
+    }
+
+    // Hot, small allocations: size-class pools in SRAM
+    void *ptr = poolAlloc(size);
+    if (ptr != nullptr)
+    {
+        return ptr;
+    }
+
+    // Layer and glyph buffers: internal heap while it has headroom
+    if (size <= LV_LAYER_SIMPLE_BUF_SIZE && internalHasRoomFor(size))
+    {
+        return heapAlloc(size, true);
+    }
+
+    // Everything else (and pool overflow once SRAM is tight) goes to PSRAM
+    return heapAlloc(size, false);
+}
+
+extern "C" void tiered_free(void *ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    Pool *pool = findPool(ptr);
+    if (pool != nullptr)
+    {
+        poolFree(*pool, ptr);
+        return;
+    }
+
+    account(ptr, -1);
+    heap_caps_free(ptr);
+}
+
+extern "C" void *tiered_realloc(void *ptr, size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return tiered_alloc(size);
+    }
+    if (size == 0)
+    {
+        tiered_free(ptr);
+        return nullptr;
+    }
+
+    size_t oldSize;
+    Pool *pool = findPool(ptr);
+    if (pool != nullptr)
+    {
+        // Still fits the block - just update the bookkeeping
+        if (size <= pool->size)
+        {
+            uint16_t &requested = pool->requested[((uint8_t *)ptr - pool->base) / pool->size];
+            pool->stats.requested_in_use += size - requested;
+            requested = size;
+            return ptr;
+        }
+        oldSize = pool->size;
+    }
+    else
+    {
+        oldSize = heap_caps_get_allocated_size(ptr);
+    }
+
+    // Move: this also re-tiers a buffer that grew past its class
+    void *moved = tiered_alloc(size);
+    if (moved == nullptr)
+    {
+        return nullptr;
+    }
+    memcpy(moved, ptr, oldSize < size ? oldSize : size);
+    tiered_free(ptr);
+    return moved;
+}
+
+extern "C" void tiered_set_placement(tiered_placement_t newPlacement)
+{
+    if (newPlacement < TIERED_PLACEMENT_COUNT)
+    {
+        placement = newPlacement;
+    }
+}
+
+extern "C" tiered_placement_t tiered_get_placement(void)
+{
+    return placement;
+}
+
+extern "C" const char *tiered_placement_name(tiered_placement_t which)
+{
+    return which < TIERED_PLACEMENT_COUNT ? PLACEMENT_NAMES[which] : "?";
+}
+
+extern "C" void tiered_get_stats(tiered_stats_t *out)
+{
+    *out = heapStats;
+    for (int i = 0; i < TIERED_ALLOC_CLASS_COUNT; i++)
+    {
+        out->classes[i] = pools[i].stats;
+        out->classes[i].block_size = pools[i].size;
+        out->classes[i].blocks = pools[i].blocks;
+    }
+}
+
+extern "C" void tiered_reset_counters(void)
+{
+    heapStats.failures = 0;
+    for (Pool &pool : pools)
+    {
+        pool.stats.hits = 0;
+        pool.stats.misses = 0;
+        pool.stats.peak = pool.stats.in_use;
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file      tiered_alloc.h
+ * @brief     Tiered SRAM/PSRAM allocator for LVGL (LV_MEM_CUSTOM backend)
+ *
+ * Small allocations (objects, styles, label text) are served from fixed
+ * size-class pools in internal SRAM. Mid-size ones up to
+ * LV_LAYER_SIMPLE_BUF_SIZE (layer and glyph decompression buffers) go to
+ * the internal heap while enough of it stays free for the rest of the
+ * firmware, and everything larger goes to PSRAM.
+ *
+ * Included from lv_conf.h, so this header must stay valid C.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size classes for the internal SRAM pools: block size and block count */
+#define TIERED_ALLOC_CLASSES                                                \
+    TIERED_ALLOC_CLASS(16, 256)                                             \
+    TIERED_ALLOC_CLASS(32, 384)                                             \
+    TIERED_ALLOC_CLASS(64, 192)                                             \
+    TIERED_ALLOC_CLASS(128, 96)                                             \
+    TIERED_ALLOC_CLASS(256, 32)                                             \
+    TIERED_ALLOC_CLASS(512, 16)                                             \
+    TIERED_ALLOC_CLASS(1024, 8)
+
+#define TIERED_ALLOC_CLASS_COUNT 7
+
+/* Keep at least this much internal heap free when placing mid-size buffers */
+#ifndef TIERED_ALLOC_INTERNAL_RESERVE
+#define TIERED_ALLOC_INTERNAL_RESERVE (48U * 1024U)
+#endif
+
+/* Where new allocations are placed */
+typedef enum {
+    TIERED_PLACEMENT_TIERED = 0, /* Pools, then internal heap, then PSRAM by size */
+    TIERED_PLACEMENT_PSRAM,      /* Everything in PSRAM (the old ps_malloc setup) */
+    TIERED_PLACEMENT_INTERNAL,   /* Everything in internal SRAM, PSRAM only as fallback */
+    TIERED_PLACEMENT_COUNT
+} tiered_placement_t;
+
+#ifndef TIERED_ALLOC_DEFAULT_PLACEMENT
+#define TIERED_ALLOC_DEFAULT_PLACEMENT TIERED_PLACEMENT_TIERED
+#endif
+
+typedef struct {
+    uint16_t block_size;
+    uint16_t blocks;
+    uint32_t hits;             /* Served from this pool */
+    uint32_t misses;           /* Pool full, fell through to the heap */
+    uint32_t in_use;           /* Blocks currently handed out */
+    uint32_t peak;             /* Most blocks ever in use at once */
+    uint32_t requested_in_use; /* Bytes actually asked for by the blocks in use */
+} tiered_class_stats_t;
+
+typedef struct {
+    tiered_class_stats_t classes[TIERED_ALLOC_CLASS_COUNT];
+    uint32_t internal_allocs; /* Live internal heap allocations */
+    uint32_t internal_bytes;
+    uint32_t psram_allocs;    /* Live PSRAM allocations */
+    uint32_t psram_bytes;
+    uint32_t failures;        /* Requests nothing could satisfy */
+} tiered_stats_t;
+
+void *tiered_alloc(size_t size);
+void tiered_free(void *ptr);
+void *tiered_realloc(void *ptr, size_t size);
+
+/* Change placement for new allocations; existing blocks stay where they are */
+void tiered_set_placement(tiered_placement_t placement);
+tiered_placement_t tiered_get_placement(void);
+const char *tiered_placement_name(tiered_placement_t placement);
+
+void tiered_get_stats(tiered_stats_t *out);
+void tiered_reset_counters(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,168 @@
+#include "GForcePage.h"
+#include "../FrameScheduler.h"
+
+volatile bool GForcePage::peakResetRequested = false;
+
+void GForcePage::create()
+{
+    createReadouts();
+
+    // Plot after the static captions, clear of them
+    circle.create(tile, PLOT_X, PLOT_Y);
+
+    bindLabels();
+}
+
+void GForcePage::createReadouts()
+{
+    // Combined acceleration at the top, units static
+    totalLabel = lv_label_create(tile);
+    Theme::apply(totalLabel, Theme::Text::ValueMedium, Theme::Tone::Primary);
+    lv_obj_align(totalLabel, LV_ALIGN_TOP_LEFT, PANEL_X, 0);
+    lv_label_set_text(totalLabel, "--");
+
+    lv_obj_t *units = lv_label_create(tile);
+    Theme::apply(units, Theme::Text::Title, Theme::Tone::Secondary);
+    lv_obj_align(units, LV_ALIGN_TOP_LEFT, PANEL_X + 150, 20);
+    lv_label_set_text(units, "g");
+    markStatic(units);
+
+    // Peaks heading in the markers' tone, then one row per direction
+    lv_obj_t *heading = lv_label_create(tile);
+    Theme::apply(heading, Theme::Text::Body, Theme::Tone::Poor);
+    lv_obj_align(heading, LV_ALIGN_TOP_LEFT, PANEL_X, PEAKS_Y);
+    lv_label_set_text(heading, "Peak g");
+    markStatic(heading);
+
+    static const char *const names[] = {"Left", "Right", "Accel", "Brake"};
+    for (int i = 0; i < 4; i++)
+    {
+        lv_coord_t y = PEAKS_Y + (i + 1) * ROW_HEIGHT;
+
+        lv_obj_t *name = lv_label_create(tile);
+        Theme::apply(name, Theme::Text::Body, Theme::Tone::Secondary);
+        lv_obj_align(name, LV_ALIGN_TOP_LEFT, PANEL_X, y);
+        lv_label_set_text(name, names[i]);
+        markStatic(name);
+
+        peakLabels[i] = lv_label_create(tile);
+        Theme::apply(peakLabels[i], Theme::Text::Body, Theme::Tone::Primary);
+        lv_obj_align(peakLabels[i], LV_ALIGN_TOP_LEFT, PANEL_X + 110, y);
+        lv_label_set_text(peakLabels[i], "0.00");
+    }
+}
+
+void GForcePage::onRelease()
+{
+    totalText.unbind();
+    for (BoundLabel<int32_t> &peak : peakText)
+    {
+        peak.unbind();
+    }
+    circle.release();
+}
+
+void GForcePage::requestPeakReset()
+{
+    peakResetRequested = true;
+    FrameScheduler::getInstance().wake(FrameScheduler::WAKE_PAGE);
+}
+
+void GForcePage::backgroundUpdate()
+{
+    // Each ride gets its own peaks
+    Activity activity = FrameScheduler::getInstance().getActivity();
+    if (peakResetRequested || (wasParked && activity == Activity::Riding))
+    {
+        peakResetRequested = false;
+        circle.resetPeaks();
+    }
+    if (activity != Activity::Swipe)
+    {
+        wasParked = activity == Activity::Parked;
+    }
+
+    // One sample per GPS estimate, at the fix rate
+    uint32_t count = gps.getMotionCount();
+    if (count == lastMotionCount)
+    {
+        return;
+    }
+    lastMotionCount = count;
+
+    if (gps.hasMotion())
+    {
+        circle.add(gps.getLateralG(), gps.getLongitudinalG(), millis());
+    }
+}
+
+void GForcePage::update()
+{
+    // Only update when page is active for efficiency
+    if (!isPageActive)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+    circle.sync(now);
+
+    if (gps.hasMotion())
+    {
+        float total = sqrtf(gps.getLateralG() * gps.getLateralG() + gps.getLongitudinalG() * gps.getLongitudinalG());
+        totalText.set((int32_t)lroundf(total * 100.0f));
+    }
+    else
+    {
+        totalText.set(-1);
+    }
+
+    const FrictionCircle::Peaks &peaks = circle.getPeaks();
+    const float values[4] = {peaks.left, peaks.right, peaks.accel, peaks.brake};
+    for (int i = 0; i < 4; i++)
+    {
+        peakText[i].set((int32_t)lroundf(values[i] * 100.0f));
+    }
+
+    // Keep passes coming while the trail fades out
+    uint32_t fade = circle.msToNextFade(now);
+    if (fade != 0)
+    {
+        FrameScheduler::getInstance().requestUpdate(fade);
+    }
+}
+
+// ============================================================================
+// LABEL BINDINGS
+// ============================================================================
+void GForcePage::bindLabels()
+{
+    // Hundredths of g as "0.00", "--" without an estimate (-1)
+    auto format = [](const int32_t &hundredths, LabelText &out) {
+        if (hundredths < 0)
+        {
+            out.set("--");
+        }
+        else
+        {
+            out.format("%ld.%02ld", (long)(hundredths / 100), (long)(hundredths % 100));
+        }
+    };
+
+    totalText.bind(totalLabel, format);
+    for (int i = 0; i < 4; i++)
+    {
+        peakText[i].bind(peakLabels[i], format);
+    }
+}
+
+void GForcePage::printStats()
+{
+    const FrictionCircle::Stats &s = circle.getStats();
+    uint32_t syncs = s.syncs ? s.syncs : 1;
+    Serial.printf("[GForce] %lu syncs: %lu segments drawn, %lu faded, %lu erased, %lu full renders\n",
+                  (unsigned long)s.syncs, (unsigned long)s.drawn, (unsigned long)s.faded, (unsigned long)s.erased,
+                  (unsigned long)s.fullRenders);
+    Serial.printf("[GForce] %.0f us per sync drawing, trail %u points in %u shades\n", (double)s.drawUs / syncs,
+                  FrictionCircle::TRAIL_POINTS, FrictionCircle::BANDS);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "../Page.h"
+#include "../Theme.h"
+#include "../Binding.h"
+#include "../FrictionCircle.h"
+#include "../../sensors/GPS.h"
+
+// External GPS instance from main.cpp
+extern GPS gps;
+
+/**
+ * Friction circle page: lateral against longitudinal acceleration, with a
+ * fading trail of the last few seconds and markers at the peaks.
+ *
+ * There is no IMU on the board, so the acceleration is the GPS estimate
+ * (GPS::getLateralG() and getLongitudinalG()), one sample per fix. Samples
+ * go into the FrictionCircle from backgroundUpdate(), so the trail and the
+ * peaks are current when the page is swiped to; a frame draws only the new
+ * head and the segments fading or erased at the tail. The readouts show the
+ * combined acceleration and the peak each way. The peaks start over when a
+ * ride starts after being parked, or on "gforce reset". "page gforce"
+ * prints the plot's draw figures.
+ */
+class GForcePage : public Page
+{
+private:
+    // Plot geometry
+    static constexpr lv_coord_t PLOT_X = 12;
+    static constexpr lv_coord_t PLOT_Y = 4;
+    static constexpr uint16_t PLOT_SIZE = 232;
+    static constexpr float RANGE_G = 1.2f;
+    static constexpr float RING_G = 0.5f;
+    static constexpr uint32_t TRAIL_MS = 3000;
+
+    // Readout column, right of the plot
+    static constexpr lv_coord_t PANEL_X = 290;
+    static constexpr lv_coord_t PEAKS_Y = 76;
+    static constexpr lv_coord_t ROW_HEIGHT = 32;
+
+    // UI Elements
+    lv_obj_t *totalLabel = nullptr;
+    lv_obj_t *peakLabels[4] = {nullptr, nullptr, nullptr, nullptr}; // Left, right, accel, brake
+    FrictionCircle circle{PLOT_SIZE, RANGE_G, RING_G, TRAIL_MS};
+
+    // Label bindings - only call into LVGL when the shown text changes
+    BoundLabel<int32_t> totalText;    // Hundredths of g, -1 = no estimate
+    BoundLabel<int32_t> peakText[4];  // Hundredths of g
+
+    // Page state
+    uint32_t lastMotionCount = 0;
+    bool wasParked = true;
+    bool isPageActive = false;
+    static volatile bool peakResetRequested;
+
+    void createReadouts();
+    void bindLabels();
+
+public:
+    GForcePage() : Page("GForce") {}
+
+    void create() override;
+    void onRelease() override;
+    void update() override;
+    void backgroundUpdate() override;
+    void onEnter() override { isPageActive = true; }
+    void onExit() override { isPageActive = false; }
+    void printStats() override;
+
+    /**
+     * Start the peaks over from any task; applied on the display task.
+     */
+    static void requestPeakReset();
+};
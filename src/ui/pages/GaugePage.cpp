@@ -0,0 +1,249 @@
+#include "GaugePage.h"
+#include "../FrameProfiler.h"
+#include "../FrameScheduler.h"
+#include "../RenderGovernor.h"
+#include <esp_timer.h>
+
+void GaugePage::create()
+{
+    // Dial centred on the tile, a little low so the numerals clear the top
+    lv_coord_t centreX = LV_HOR_RES / 2;
+    lv_coord_t centreY = LV_VER_RES / 2 + CENTRE_DY;
+    createDial(centreX, centreY);
+
+    // Units inside the dial, above the hub
+    speedUnits = lv_label_create(tile);
+    Theme::apply(speedUnits, Theme::Text::Caption, Theme::Tone::Secondary);
+    lv_obj_align(speedUnits, LV_ALIGN_CENTER, 0, CENTRE_DY - 44);
+    lv_label_set_text(speedUnits, "mph");
+    markStatic(speedUnits);
+
+    // Digital readout in the gap at the bottom of the sweep
+    speedLabel = lv_label_create(tile);
+    Theme::apply(speedLabel, Theme::Text::ValueMedium, Theme::Tone::Primary);
+    lv_obj_align(speedLabel, LV_ALIGN_CENTER, 0, CENTRE_DY + 72);
+    lv_label_set_text(speedLabel, "--");
+
+    // Needle last, over everything
+    needle.create(tile, centreX, centreY, Theme::Tone::Accent);
+    needle.setPosition(needleMph / MAX_MPH);
+
+    bindLabels();
+}
+
+void GaugePage::createDial(lv_coord_t centreX, lv_coord_t centreY)
+{
+    // Outer arc over the sweep; the indicator and knob are not used
+    lv_obj_t *arc = lv_arc_create(tile);
+    lv_obj_remove_style_all(arc);
+    lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(arc, RADIUS * 2, RADIUS * 2);
+    lv_obj_set_pos(arc, centreX - RADIUS, centreY - RADIUS);
+    lv_arc_set_bg_angles(arc, START_ANGLE, START_ANGLE + SWEEP_ANGLE);
+    Theme::apply(arc, Theme::Tone::Secondary);
+    lv_obj_set_style_arc_width(arc, ARC_WIDTH, 0);
+    lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_INDICATOR);
+    markStatic(arc);
+
+    // Ticks every TICK_MPH from the arc inwards, longer and brighter on the numerals
+    for (int i = 0; i < TICK_COUNT; i++)
+    {
+        int32_t mph = i * TICK_MPH;
+        bool major = mph % LABEL_MPH == 0;
+        float angle = (START_ANGLE + (float)SWEEP_ANGLE * mph / MAX_MPH) * (float)M_PI / 180.0f;
+        float dirX = cosf(angle);
+        float dirY = sinf(angle);
+        lv_coord_t inner = RADIUS - (major ? MAJOR_TICK : MINOR_TICK);
+
+        lv_coord_t x1 = centreX + (lv_coord_t)lroundf(dirX * RADIUS);
+        lv_coord_t y1 = centreY + (lv_coord_t)lroundf(dirY * RADIUS);
+        lv_coord_t x2 = centreX + (lv_coord_t)lroundf(dirX * inner);
+        lv_coord_t y2 = centreY + (lv_coord_t)lroundf(dirY * inner);
+        lv_coord_t left = LV_MIN(x1, x2);
+        lv_coord_t top = LV_MIN(y1, y2);
+
+        // Points from the line's own corner
+        tickPoints[i][0] = {(lv_coord_t)(x1 - left), (lv_coord_t)(y1 - top)};
+        tickPoints[i][1] = {(lv_coord_t)(x2 - left), (lv_coord_t)(y2 - top)};
+
+        lv_obj_t *tick = lv_line_create(tile);
+        lv_line_set_points(tick, tickPoints[i], 2);
+        Theme::apply(tick, major ? Theme::Tone::Primary : Theme::Tone::Secondary);
+        lv_obj_set_style_line_width(tick, major ? 4 : 2, 0);
+        lv_obj_set_pos(tick, left, top);
+        markStatic(tick);
+    }
+
+    // Numerals inside the major ticks
+    for (int i = 0; i < LABEL_COUNT; i++)
+    {
+        int32_t mph = i * LABEL_MPH;
+        float angle = (START_ANGLE + (float)SWEEP_ANGLE * mph / MAX_MPH) * (float)M_PI / 180.0f;
+
+        lv_obj_t *numeral = lv_label_create(tile);
+        Theme::apply(numeral, Theme::Text::Body, Theme::Tone::Secondary);
+        lv_label_set_text_fmt(numeral, "%ld", (long)mph);
+        lv_obj_align(numeral, LV_ALIGN_CENTER, (lv_coord_t)lroundf(cosf(angle) * LABEL_RADIUS),
+                     CENTRE_DY + (lv_coord_t)lroundf(sinf(angle) * LABEL_RADIUS));
+        markStatic(numeral);
+    }
+}
+
+void GaugePage::onRelease()
+{
+    speedText.unbind();
+    needle.release();
+}
+
+void GaugePage::onEnter()
+{
+    isPageActive = true;
+
+    // Show the current speed straight away instead of sweeping up from a stale one
+    lastStep = 0;
+}
+
+void GaugePage::update()
+{
+    // Only update when page is active for efficiency
+    if (!isPageActive)
+    {
+        return;
+    }
+
+    // Rests on zero without a fix
+    bool fix = gps.hasFix() && gps.isConnected();
+    float speed = fix ? gps.getSpeedMph() : 0.0f;
+    speedText.set(fix ? (int32_t)(speed + 0.5f) : -1);
+
+    float target = speed > MAX_MPH ? MAX_MPH : speed;
+    stepNeedle(target);
+    needle.setPosition(needleMph / MAX_MPH);
+
+    bool moving = needleMph != target;
+    sampleSweep(moving);
+
+    // Keep the display task on 60 fps until the needle settles
+    if (moving)
+    {
+        FrameScheduler::getInstance().requestUpdate(FRAME_MS);
+    }
+}
+
+// ============================================================================
+// LABEL BINDINGS
+// ============================================================================
+void GaugePage::bindLabels()
+{
+    // Whole mph, "--" when there is no fix (-1)
+    speedText.bind(speedLabel, [](const int32_t &speed, LabelText &out) {
+        if (speed < 0)
+        {
+            out.set("--");
+        }
+        else
+        {
+            out.format("%ld", (long)speed);
+        }
+    });
+}
+
+// ============================================================================
+// NEEDLE
+// Critically damped spring towards the target: no overshoot, and GPS steps
+// a few times a second turn into a smooth sweep
+// ============================================================================
+void GaugePage::stepNeedle(float targetMph)
+{
+    uint32_t now = millis();
+
+    // First update on the page, or the governor has animations off - jump
+    if (lastStep == 0 || RenderGovernor::getInstance().atLeast(Quality::NoAnimations))
+    {
+        needleMph = targetMph;
+        needleVelocity = 0.0f;
+        lastStep = now;
+        return;
+    }
+
+    float dt = (now - lastStep) / 1000.0f;
+    lastStep = now;
+
+    // Exact step of the spring for any dt, so a late frame doesn't overshoot
+    float omega = 2.0f / SMOOTH_S;
+    float x = omega * dt;
+    float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+    float offset = needleMph - targetMph;
+    float pull = (needleVelocity + omega * offset) * dt;
+    needleVelocity = (needleVelocity - omega * pull) * decay;
+    needleMph = targetMph + (offset + pull) * decay;
+
+    if (fabsf(needleMph - targetMph) < SETTLED_MPH)
+    {
+        needleMph = targetMph;
+        needleVelocity = 0.0f;
+    }
+}
+
+// ============================================================================
+// SWEEP MEASUREMENT
+// Frame work and wall time while the needle moves: the 60 fps claim and the
+// core 1 share it costs
+// ============================================================================
+void GaugePage::sampleSweep(bool moving)
+{
+#if FRAME_PROFILER
+    FrameProfiler &profiler = FrameProfiler::getInstance();
+    uint32_t frames = profiler.getFrameCount();
+    int64_t now = esp_timer_get_time();
+
+    if (sweeping)
+    {
+        // One frame per display pass at most: the last one is the new one
+        if (frames != lastFrameCount)
+        {
+            sweepStats.frames += frames - lastFrameCount;
+            sweepStats.busyUs += profiler.getLastFrameUs(Stage::Update) + profiler.getLastFrameUs(Stage::Layout) +
+                                 profiler.getLastFrameUs(Stage::Draw) + profiler.getLastFrameUs(Stage::Flush);
+        }
+        if (!moving)
+        {
+            sweepStats.totalUs += now - sweepStart;
+            sweeping = false;
+        }
+    }
+    else if (moving)
+    {
+        sweeping = true;
+        sweepStart = now;
+        sweepStats.sweeps++;
+    }
+    lastFrameCount = frames;
+#else
+    (void)moving;
+#endif
+}
+
+void GaugePage::printStats()
+{
+    const NeedleGauge::Stats &n = needle.getStats();
+    Serial.printf("[Gauge] %u needle sprites, %lu B PSRAM, largest %ux%u, built in %lu us, %lu moves\n",
+                  NeedleGauge::STEPS, (unsigned long)n.bytes, n.maxWidth, n.maxHeight, (unsigned long)n.buildUs,
+                  (unsigned long)n.moves);
+
+#if FRAME_PROFILER
+    if (sweepStats.totalUs == 0)
+    {
+        Serial.println("[Gauge] No sweeps measured yet");
+        return;
+    }
+
+    float seconds = sweepStats.totalUs / 1000000.0f;
+    float frames = sweepStats.frames ? sweepStats.frames : 1;
+    Serial.printf("[Gauge] %lu sweeps over %.1f s: %.1f fps, core 1 load %.1f%%, %.0f us per frame\n",
+                  (unsigned long)sweepStats.sweeps, seconds, sweepStats.frames / seconds,
+                  100.0f * sweepStats.busyUs / sweepStats.totalUs, sweepStats.busyUs / frames);
+#else
+    Serial.println("[Gauge] (sweep figures need FRAME_PROFILER)");
+#endif
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "../Page.h"
+#include "../Theme.h"
+#include "../Binding.h"
+#include "../NeedleGauge.h"
+#include "../../sensors/GPS.h"
+
+// External GPS instance from main.cpp
+extern GPS gps;
+
+/**
+ * Analog speedometer page, for riders who prefer a sweep to digits.
+ *
+ * The dial face (arc, ticks, numerals) is static and baked into the page's
+ * StaticLayer, so it is drawn once; the needle is a NeedleGauge, so a frame
+ * is the needle's old box restored from the layer plus the new sprite. The
+ * needle follows GPS speed through a critically damped spring and asks for
+ * 60 fps while it moves. "page gauge" prints the sprite figures and the frame
+ * rate and core 1 load measured while the needle was sweeping.
+ */
+class GaugePage : public Page
+{
+public:
+    /**
+     * Figures for the frames rendered while the needle was moving.
+     */
+    struct SweepStats
+    {
+        uint32_t sweeps = 0;
+        uint32_t frames = 0;
+        uint64_t busyUs = 0; // Update, layout, draw and flush of those frames
+        uint64_t totalUs = 0;
+    };
+
+private:
+    // Dial, in LVGL degrees (0 = 3 o'clock, clockwise)
+    static constexpr uint16_t START_ANGLE = 135;
+    static constexpr uint16_t SWEEP_ANGLE = 270;
+    static constexpr int32_t MAX_MPH = 140;
+    static constexpr int32_t TICK_MPH = 10;
+    static constexpr int32_t LABEL_MPH = 20;
+    static constexpr int TICK_COUNT = MAX_MPH / TICK_MPH + 1;
+    static constexpr int LABEL_COUNT = MAX_MPH / LABEL_MPH + 1;
+
+    // Dial geometry, from the tile centre
+    static constexpr lv_coord_t CENTRE_DY = 4;
+    static constexpr lv_coord_t RADIUS = 112;
+    static constexpr lv_coord_t ARC_WIDTH = 3;
+    static constexpr lv_coord_t MAJOR_TICK = 16;
+    static constexpr lv_coord_t MINOR_TICK = 8;
+    static constexpr lv_coord_t LABEL_RADIUS = RADIUS - 36;
+
+    // Needle
+    static constexpr lv_coord_t NEEDLE_LENGTH = RADIUS - 14;
+    static constexpr float SMOOTH_S = 0.25f;    // Spring settle time
+    static constexpr float SETTLED_MPH = 0.05f; // Snap to the target inside this
+    static constexpr uint32_t FRAME_MS = 16;    // 60 fps while the needle moves
+
+    // UI Elements
+    lv_obj_t *speedLabel = nullptr;
+    lv_obj_t *speedUnits = nullptr;
+    NeedleGauge needle{START_ANGLE, SWEEP_ANGLE, NEEDLE_LENGTH};
+
+    // lv_line keeps a pointer to its points
+    lv_point_t tickPoints[TICK_COUNT][2];
+
+    // Label bindings - only call into LVGL when the shown text changes
+    BoundLabel<int32_t> speedText; // Whole mph, -1 = no fix
+
+    // Needle state
+    float needleMph = 0.0f;
+    float needleVelocity = 0.0f; // mph per second
+    uint32_t lastStep = 0;       // millis() of the last spring step, 0 = jump to the target
+    bool isPageActive = false;
+
+    // Sweep measurement
+    bool sweeping = false;
+    int64_t sweepStart = 0;
+    uint32_t lastFrameCount = 0;
+    SweepStats sweepStats;
+
+    void createDial(lv_coord_t centreX, lv_coord_t centreY);
+    void bindLabels();
+    void stepNeedle(float targetMph);
+    void sampleSweep(bool moving);
+
+public:
+    GaugePage() : Page("Gauge") {}
+
+    void create() override;
+    void onRelease() override;
+    void update() override;
+    void onEnter() override;
+    void onExit() override { isPageActive = false; }
+    bool isCritical() const override { return true; }
+    uint32_t getFrameIntervalMs() const override { return FRAME_MS; }
+
+    const SweepStats &getSweepStats() const { return sweepStats; }
+    void printStats() override;
+};
@@ -0,0 +1,101 @@
+#include "HistoryPage.h"
+#include "../FrameScheduler.h"
+
+HistoryPage::HistoryPage() : Page("History")
+{
+    chart.setSeries(SPEED, 0.0f, MAX_MPH, Theme::Tone::Primary);
+    chart.setSeries(LEAN, -MAX_LEAN_DEG, MAX_LEAN_DEG, Theme::Tone::Accent);
+    chart.setGrid(GRID_MPH, GRID_MS);
+}
+
+void HistoryPage::create()
+{
+    createScale();
+
+    // Chart last: its box is live and must not sit under a static widget
+    chart.create(tile, CHART_X, CHART_Y);
+}
+
+void HistoryPage::createScale()
+{
+    // Legend over the chart, in the series' tones
+    lv_obj_t *speedKey = lv_label_create(tile);
+    Theme::apply(speedKey, Theme::Text::Body, Theme::Tone::Primary);
+    lv_obj_align(speedKey, LV_ALIGN_TOP_LEFT, CHART_X, 2);
+    lv_label_set_text(speedKey, "Speed (mph)");
+    markStatic(speedKey);
+
+    lv_obj_t *leanKey = lv_label_create(tile);
+    Theme::apply(leanKey, Theme::Text::Body, Theme::Tone::Accent);
+    lv_obj_align(leanKey, LV_ALIGN_TOP_RIGHT, CHART_X + CHART_WIDTH - LV_HOR_RES, 2);
+    lv_label_set_text(leanKey, "Lean (deg)");
+    markStatic(leanKey);
+
+    // Speed scale on the left, level with the grid lines
+    for (int32_t mph = 0; mph <= (int32_t)MAX_MPH; mph += LABEL_MPH)
+    {
+        lv_coord_t y = CHART_Y + (CHART_HEIGHT - 1) - mph * (CHART_HEIGHT - 1) / (int32_t)MAX_MPH;
+        lv_obj_t *label = lv_label_create(tile);
+        Theme::apply(label, Theme::Text::Body, Theme::Tone::Secondary);
+        lv_label_set_text_fmt(label, "%ld", (long)mph);
+        lv_obj_align(label, LV_ALIGN_TOP_RIGHT, CHART_X - 6 - LV_HOR_RES, y - 11);
+        markStatic(label);
+    }
+
+    // Time along the bottom, newest on the right
+    static const char *const times[] = {"-60 s", "-30 s", "now"};
+    static const lv_align_t aligns[] = {LV_ALIGN_TOP_LEFT, LV_ALIGN_TOP_MID, LV_ALIGN_TOP_RIGHT};
+    lv_coord_t rightMargin = LV_HOR_RES - CHART_X - CHART_WIDTH;
+    lv_coord_t offsets[] = {CHART_X, (lv_coord_t)((CHART_X - rightMargin) / 2), (lv_coord_t)-rightMargin};
+    for (int i = 0; i < 3; i++)
+    {
+        lv_obj_t *label = lv_label_create(tile);
+        Theme::apply(label, Theme::Text::Body, Theme::Tone::Secondary);
+        lv_label_set_text(label, times[i]);
+        lv_obj_align(label, aligns[i], offsets[i], CHART_Y + CHART_HEIGHT + 2);
+        markStatic(label);
+    }
+}
+
+void HistoryPage::onRelease()
+{
+    chart.release();
+}
+
+void HistoryPage::backgroundUpdate()
+{
+    // The chart keeps scrolling without samples, leaving gaps
+    chart.advance(millis());
+
+    if (gps.hasFix() && gps.isConnected())
+    {
+        chart.add(SPEED, gps.getSpeedMph());
+    }
+    if (gps.hasMotion())
+    {
+        chart.add(LEAN, gps.getLeanDeg());
+    }
+}
+
+void HistoryPage::update()
+{
+    // Only update when page is active for efficiency
+    if (!isPageActive)
+    {
+        return;
+    }
+
+    chart.sync();
+
+    // Next pass when the next column opens, to scroll on time
+    FrameScheduler::getInstance().requestUpdate(chart.msToNextColumn(millis()));
+}
+
+void HistoryPage::printStats()
+{
+    const StripChart::Stats &s = chart.getStats();
+    uint32_t draws = s.syncs ? s.syncs : 1;
+    Serial.printf("[History] %u ms columns, %lu syncs, %lu columns drawn, %lu full renders, %.0f us per sync\n",
+                  (unsigned)chart.getColumnMs(), (unsigned long)s.syncs, (unsigned long)s.columns,
+                  (unsigned long)s.fullRenders, (double)s.drawUs / draws);
+}
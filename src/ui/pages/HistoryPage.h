@@ -0,0 +1,60 @@
+#pragma once
+#include "../Page.h"
+#include "../Theme.h"
+#include "../StripChart.h"
+#include "../../sensors/GPS.h"
+
+// External GPS instance from main.cpp
+extern GPS gps;
+
+/**
+ * Last minute of speed and lean on one rolling strip chart.
+ *
+ * Samples go into the chart's model from backgroundUpdate(), so the history
+ * is there when the page is swiped to. The chart scrolls one column per
+ * COLUMN_MS and only draws the columns that changed; update() asks for the
+ * next pass at the next column. Lean is the GPS estimate (see
+ * GPS::getLeanDeg()), drawn on its own scale, zero on the 60 mph line.
+ * "page history" prints the chart's draw figures.
+ */
+class HistoryPage : public Page
+{
+private:
+    // Chart geometry, room for the scale on the left and time along the bottom
+    static constexpr lv_coord_t CHART_X = 48;
+    static constexpr lv_coord_t CHART_Y = 36;
+    static constexpr uint16_t CHART_WIDTH = 480;
+    static constexpr uint16_t CHART_HEIGHT = 176;
+    static constexpr uint32_t WINDOW_MS = 60000;
+
+    // Scales
+    static constexpr float MAX_MPH = 120.0f;
+    static constexpr float MAX_LEAN_DEG = 60.0f;
+    static constexpr float GRID_MPH = 20.0f;
+    static constexpr int32_t LABEL_MPH = 40;
+    static constexpr uint32_t GRID_MS = 10000;
+
+    enum Series : uint8_t
+    {
+        SPEED,
+        LEAN
+    };
+
+    StripChart chart{CHART_WIDTH, CHART_HEIGHT, WINDOW_MS};
+
+    // Page state
+    bool isPageActive = false;
+
+    void createScale();
+
+public:
+    HistoryPage();
+
+    void create() override;
+    void onRelease() override;
+    void update() override;
+    void backgroundUpdate() override;
+    void onEnter() override { isPageActive = true; }
+    void onExit() override { isPageActive = false; }
+    void printStats() override;
+};
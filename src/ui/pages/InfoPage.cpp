@@ -1,4 +1,6 @@
 #include "InfoPage.h"
+#include "../FrameProfiler.h"
+#include "../PowerEstimator.h"
 #include <Arduino.h>
 
 void InfoPage::create()
@@ -10,29 +12,27 @@ void InfoPage::create()
 
     // Page title
     lv_obj_t *infoTitle = lv_label_create(tile);
-    lv_obj_set_style_text_font(infoTitle, &lv_font_montserrat_34, 0);
-    lv_obj_set_style_text_color(infoTitle, Theme::white(), 0);
+    Theme::apply(infoTitle, Theme::Text::Title, Theme::Tone::Primary);
     lv_label_set_text(infoTitle, "INFO");
     lv_obj_align(infoTitle, LV_ALIGN_TOP_MID, 0, 20);
+    markStatic(infoTitle);
 
     // WiFi Status section header
     lv_obj_t *wifiHeader = lv_label_create(tile);
-    lv_obj_set_style_text_font(wifiHeader, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(wifiHeader, Theme::grey(), 0);
+    Theme::apply(wifiHeader, Theme::Text::Caption, Theme::Tone::Secondary);
     lv_label_set_text(wifiHeader, "WiFi Status: ");
     lv_obj_align(wifiHeader, LV_ALIGN_TOP_LEFT, 10, 70);
+    markStatic(wifiHeader);
 
     // WiFi status value
     wifiStatusLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(wifiStatusLabel, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(wifiStatusLabel, Theme::red(), 0);
+    Theme::apply(wifiStatusLabel, Theme::Text::Caption, Theme::Tone::Bad);
     lv_label_set_text(wifiStatusLabel, "Disconnected");
     lv_obj_align(wifiStatusLabel, LV_ALIGN_TOP_LEFT, 190, 70);
 
     // SSID label
     wifiSSIDLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(wifiSSIDLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(wifiSSIDLabel, Theme::grey(), 0);
+    Theme::apply(wifiSSIDLabel, Theme::Text::Body, Theme::Tone::Secondary);
     lv_obj_set_width(wifiSSIDLabel, 430);
     lv_label_set_long_mode(wifiSSIDLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
     lv_label_set_text(wifiSSIDLabel, "SSID: ---");
@@ -40,8 +40,7 @@ void InfoPage::create()
 
     // IP address label
     wifiIPLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(wifiIPLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(wifiIPLabel, Theme::grey(), 0);
+    Theme::apply(wifiIPLabel, Theme::Text::Body, Theme::Tone::Secondary);
     lv_obj_set_width(wifiIPLabel, 430);
     lv_label_set_long_mode(wifiIPLabel, LV_LABEL_LONG_SCROLL_CIRCULAR);
     lv_label_set_text(wifiIPLabel, "IP: 0.0.0.0");
@@ -49,320 +48,342 @@ void InfoPage::create()
 
     // Module Status section header
     lv_obj_t *moduleHeader = lv_label_create(tile);
-    lv_obj_set_style_text_font(moduleHeader, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(moduleHeader, Theme::grey(), 0);
+    Theme::apply(moduleHeader, Theme::Text::Caption, Theme::Tone::Secondary);
     lv_label_set_text(moduleHeader, "Module Status:");
     lv_obj_align(moduleHeader, LV_ALIGN_TOP_LEFT, 10, 200);
+    markStatic(moduleHeader);
 
     // GPS status
     moduleGPSLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(moduleGPSLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(moduleGPSLabel, Theme::red(), 0);
+    Theme::apply(moduleGPSLabel, Theme::Text::Body, Theme::Tone::Bad);
     lv_label_set_text(moduleGPSLabel, "GPS: Not detected");
     lv_obj_align(moduleGPSLabel, LV_ALIGN_TOP_LEFT, 10, 240);
 
     // Magnetometer status
     moduleMagnetometerLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(moduleMagnetometerLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(moduleMagnetometerLabel, Theme::red(), 0);
-    lv_label_set_text(moduleMagnetometerLabel, "Magnetometer: Not detected");
+    Theme::apply(moduleMagnetometerLabel, Theme::Text::Body, Theme::Tone::Secondary);
+    lv_label_set_text(moduleMagnetometerLabel, "Magnetometer: N/A"); // TODO: Update when magnetometer sensor is added
     lv_obj_align(moduleMagnetometerLabel, LV_ALIGN_TOP_LEFT, 10, 270);
 
     // IMU status
     moduleIMULabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(moduleIMULabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(moduleIMULabel, Theme::red(), 0);
-    lv_label_set_text(moduleIMULabel, "IMU: Not detected");
+    Theme::apply(moduleIMULabel, Theme::Text::Body, Theme::Tone::Secondary);
+    lv_label_set_text(moduleIMULabel, "IMU: N/A"); // TODO: Update when IMU sensor is added
     lv_obj_align(moduleIMULabel, LV_ALIGN_TOP_LEFT, 10, 300);
 
     // Battery Status section header
     lv_obj_t *batteryHeader = lv_label_create(tile);
-    lv_obj_set_style_text_font(batteryHeader, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(batteryHeader, Theme::grey(), 0);
+    Theme::apply(batteryHeader, Theme::Text::Caption, Theme::Tone::Secondary);
     lv_label_set_text(batteryHeader, "Battery Status:");
     lv_obj_align(batteryHeader, LV_ALIGN_TOP_LEFT, 10, 340);
+    markStatic(batteryHeader);
 
     // Battery voltage
     batteryVoltageLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(batteryVoltageLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(batteryVoltageLabel, Theme::white(), 0);
+    Theme::apply(batteryVoltageLabel, Theme::Text::Body, Theme::Tone::Primary);
     lv_label_set_text(batteryVoltageLabel, "Voltage: --.-V");
     lv_obj_align(batteryVoltageLabel, LV_ALIGN_TOP_LEFT, 10, 380);
 
     // Battery status (charging/discharging)
     batteryStatusLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(batteryStatusLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(batteryStatusLabel, Theme::white(), 0);
+    Theme::apply(batteryStatusLabel, Theme::Text::Body, Theme::Tone::Primary);
     lv_label_set_text(batteryStatusLabel, "Status: Unknown");
     lv_obj_align(batteryStatusLabel, LV_ALIGN_TOP_LEFT, 10, 410);
 
     // Battery percentage estimate
     batteryPercentLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(batteryPercentLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(batteryPercentLabel, Theme::white(), 0);
+    Theme::apply(batteryPercentLabel, Theme::Text::Body, Theme::Tone::Primary);
     lv_label_set_text(batteryPercentLabel, "Charge: --%");
     lv_obj_align(batteryPercentLabel, LV_ALIGN_TOP_LEFT, 10, 440);
     // Charging current (when charging)
     batteryCurrentLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(batteryCurrentLabel, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(batteryCurrentLabel, Theme::white(), 0);
+    Theme::apply(batteryCurrentLabel, Theme::Text::Body, Theme::Tone::Primary);
     lv_label_set_text(batteryCurrentLabel, "Current: --- mA");
     lv_obj_align(batteryCurrentLabel, LV_ALIGN_TOP_LEFT, 10, 470);
+
+    // Estimated panel power from the lit pixels
+    panelPowerLabel = lv_label_create(tile);
+    Theme::apply(panelPowerLabel, Theme::Text::Body, Theme::Tone::Primary);
+    lv_label_set_text(panelPowerLabel, "Panel: --- mW");
+    lv_obj_align(panelPowerLabel, LV_ALIGN_TOP_LEFT, 10, 500);
+
     // Debug section header (moved down)
     lv_obj_t *debugHeader = lv_label_create(tile);
-    lv_obj_set_style_text_font(debugHeader, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(debugHeader, Theme::yellow(), 0);
+    Theme::apply(debugHeader, Theme::Text::Caption, Theme::Tone::Accent);
     lv_label_set_text(debugHeader, "Debug:");
-    lv_obj_align(debugHeader, LV_ALIGN_TOP_LEFT, 10, 530);
+    lv_obj_align(debugHeader, LV_ALIGN_TOP_LEFT, 10, 560);
+    markStatic(debugHeader);
 
     // Frame counter (moved down)
     debugFrameCounter = lv_label_create(tile);
-    lv_obj_set_style_text_font(debugFrameCounter, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(debugFrameCounter, Theme::grey(), 0);
+    Theme::apply(debugFrameCounter, Theme::Text::Body, Theme::Tone::Secondary);
     lv_label_set_text(debugFrameCounter, "Frames: 0");
-    lv_obj_align(debugFrameCounter, LV_ALIGN_TOP_LEFT, 10, 570);
+    lv_obj_align(debugFrameCounter, LV_ALIGN_TOP_LEFT, 10, 600);
 
     // FPS display (moved down)
     debugFPS = lv_label_create(tile);
-    lv_obj_set_style_text_font(debugFPS, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(debugFPS, Theme::grey(), 0);
+    Theme::apply(debugFPS, Theme::Text::Body, Theme::Tone::Secondary);
     lv_label_set_text(debugFPS, "FPS: 0.0");
-    lv_obj_align(debugFPS, LV_ALIGN_TOP_LEFT, 10, 600);
+    lv_obj_align(debugFPS, LV_ALIGN_TOP_LEFT, 10, 630);
+
+    // Per-stage p95 times from the frame profiler
+    debugStages = lv_label_create(tile);
+    Theme::apply(debugStages, Theme::Text::Body, Theme::Tone::Secondary);
+    lv_label_set_text(debugStages, "p95 U/L/D/F: --");
+    lv_obj_align(debugStages, LV_ALIGN_TOP_LEFT, 10, 660);
 
     // Uptime display (moved down)
     debugUptime = lv_label_create(tile);
-    lv_obj_set_style_text_font(debugUptime, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(debugUptime, Theme::grey(), 0);
+    Theme::apply(debugUptime, Theme::Text::Body, Theme::Tone::Secondary);
     lv_label_set_text(debugUptime, "Uptime: 0s");
-    lv_obj_align(debugUptime, LV_ALIGN_TOP_LEFT, 10, 630);
+    lv_obj_align(debugUptime, LV_ALIGN_TOP_LEFT, 10, 690);
+
+    bindLabels();
 }
 
-void InfoPage::update()
+// ============================================================================
+// LABEL BINDINGS
+// Formatters run only when the bound value changes
+// ============================================================================
+void InfoPage::bindLabels()
 {
-    // Increment frame counter
-    frameCount++;
-    framesThisSecond++;
-
-    // Calculate FPS every second
-    uint32_t now = millis();
-    if (now - lastFPSUpdate >= 1000)
-    {
-        currentFPS = framesThisSecond * 1000.0f / (now - lastFPSUpdate);
-        framesThisSecond = 0;
-        lastFPSUpdate = now;
-    }
-
-    // Update GPS module status
-    if (moduleGPSLabel)
-    {
-        if (gps.isConnected())
+    gpsModuleText.bind(moduleGPSLabel, [](const GPSModuleInfo &info, LabelText &out) {
+        if (!info.connected)
+        {
+            out.set("GPS: Not detected");
+            out.setTone(Theme::Tone::Bad);
+        }
+        else if (info.status == GPSStatus::NoFix)
         {
-            GPSStatus status = gps.getStatus();
-            if (status == GPSStatus::NoFix)
-            {
-                lv_label_set_text(moduleGPSLabel, "GPS: Connected (No Fix)");
-                lv_obj_set_style_text_color(moduleGPSLabel, Theme::yellow(), 0);
-            }
-            else
-            {
-                // Has fix - show satellite count
-                lv_label_set_text_fmt(moduleGPSLabel, "GPS: %ld sats (%s)",
-                                      gps.getSatelliteCount(), gps.getStatusString());
-                lv_obj_set_style_text_color(moduleGPSLabel, Theme::green(), 0);
-            }
+            out.set("GPS: Connected (No Fix)");
+            out.setTone(Theme::Tone::Fair);
         }
         else
         {
-            lv_label_set_text(moduleGPSLabel, "GPS: Not detected");
-            lv_obj_set_style_text_color(moduleGPSLabel, Theme::red(), 0);
+            // Has fix - show satellite count
+            out.format("GPS: %lu sats (%s)", (unsigned long)info.satellites, info.quality);
+            out.setTone(Theme::Tone::Good);
         }
-    }
+    });
 
-    // Update Magnetometer status (not yet implemented)
-    if (moduleMagnetometerLabel)
-    {
-        // TODO: Update when magnetometer sensor is added
-        lv_label_set_text(moduleMagnetometerLabel, "Magnetometer: N/A");
-        lv_obj_set_style_text_color(moduleMagnetometerLabel, Theme::grey(), 0);
-    }
+    batteryVoltageText.bind(batteryVoltageLabel, [](const BatteryReading &battery, LabelText &out) {
+        if (battery.millivolts == 0)
+        {
+            out.set("Voltage: No Battery");
+        }
+        else if (battery.usbConnected)
+        {
+            out.format("Voltage: %.2fV (Charging)", battery.millivolts / 1000.0f);
+        }
+        else
+        {
+            out.format("Voltage: %.2fV", battery.millivolts / 1000.0f);
+        }
+    });
 
-    // Update IMU status (not yet implemented)
-    if (moduleIMULabel)
-    {
-        // TODO: Update when IMU sensor is added
-        lv_label_set_text(moduleIMULabel, "IMU: N/A");
-        lv_obj_set_style_text_color(moduleIMULabel, Theme::grey(), 0);
-    }
+    batteryStatusText.bind(batteryStatusLabel, [](const BatteryReading &battery, LabelText &out) {
+        if (battery.millivolts == 0)
+        {
+            out.set("Status: No Battery");
+            out.setTone(Theme::Tone::Bad);
+        }
+        else if (battery.usbConnected)
+        {
+            out.set("Status: Charging");
+            out.setTone(Theme::Tone::Good);
+        }
+        else
+        {
+            out.set("Status: Discharging");
+            out.setTone(Theme::Tone::Fair);
+        }
+    });
 
-    // Update battery status
-    LilyGo_AMOLED &amoled = display.getAmoled();
+    // Battery percentage estimate (rough Li-ion estimation)
+    batteryPercentText.bind(batteryPercentLabel, [](const BatteryReading &battery, LabelText &out) {
+        if (battery.millivolts == 0)
+        {
+            out.set("Charge: --");
+            out.setTone(Theme::Tone::Secondary);
+            return;
+        }
 
-    // Battery voltage
-    if (batteryVoltageLabel)
-    {
-        uint16_t voltage = amoled.getBattVoltage();
-        bool usbConnected = amoled.isVbusIn();
+        if (battery.usbConnected)
+        {
+            // During charging, voltage reading is not accurate for battery level
+            out.set("Charge: Charging...");
+            out.setTone(Theme::Tone::Good);
+            return;
+        }
 
-        if (voltage > 0)
+        // Simple Li-ion percentage estimation (3.0V = 0%, 4.2V = 100%)
+        float voltage = battery.millivolts / 1000.0f;
+        int percentage = 0;
+        if (voltage >= 4.2f)
         {
-            if (usbConnected)
-            {
-                lv_label_set_text_fmt(batteryVoltageLabel, "Voltage: %.2fV (Charging)", voltage / 1000.0f);
-            }
-            else
-            {
-                lv_label_set_text_fmt(batteryVoltageLabel, "Voltage: %.2fV", voltage / 1000.0f);
-            }
+            percentage = 100;
         }
-        else
+        else if (voltage >= 3.0f)
         {
-            lv_label_set_text(batteryVoltageLabel, "Voltage: No Battery");
+            percentage = (int)((voltage - 3.0f) / 1.2f * 100.0f);
         }
-    }
 
-    // Charging status
-    if (batteryStatusLabel)
-    {
-        uint16_t battVoltage = amoled.getBattVoltage();
-        bool usbConnected = amoled.isVbusIn();
+        out.format("Charge: %d%%", percentage);
 
-        if (battVoltage == 0)
+        // Color code based on percentage
+        if (percentage > 50)
         {
-            lv_label_set_text(batteryStatusLabel, "Status: No Battery");
-            lv_obj_set_style_text_color(batteryStatusLabel, Theme::red(), 0);
+            out.setTone(Theme::Tone::Good);
         }
-        else if (usbConnected)
+        else if (percentage > 20)
         {
-            lv_label_set_text(batteryStatusLabel, "Status: Charging");
-            lv_obj_set_style_text_color(batteryStatusLabel, Theme::green(), 0);
+            out.setTone(Theme::Tone::Fair);
         }
         else
         {
-            lv_label_set_text(batteryStatusLabel, "Status: Discharging");
-            lv_obj_set_style_text_color(batteryStatusLabel, Theme::yellow(), 0);
+            out.setTone(Theme::Tone::Bad);
         }
-    }
-
-    // Battery percentage estimate (rough Li-ion estimation)
-    if (batteryPercentLabel)
-    {
-        uint16_t voltage = amoled.getBattVoltage();
-        bool usbConnected = amoled.isVbusIn();
+    });
 
-        if (voltage > 0)
+    // Charging current in mA, -1 when USB is not connected
+    chargeCurrentText.bind(batteryCurrentLabel, [](const int32_t &current, LabelText &out) {
+        if (current < 0)
         {
-            if (usbConnected)
-            {
-                // During charging, voltage reading is not accurate for battery level
-                lv_label_set_text(batteryPercentLabel, "Charge: Charging...");
-                lv_obj_set_style_text_color(batteryPercentLabel, Theme::green(), 0);
-            }
-            else
-            {
-                // Only calculate percentage when not charging
-                float voltageFloat = voltage / 1000.0f;
-
-                // Simple Li-ion percentage estimation (3.0V = 0%, 4.2V = 100%)
-                int percentage = 0;
-                if (voltageFloat >= 4.2f)
-                {
-                    percentage = 100;
-                }
-                else if (voltageFloat >= 3.0f)
-                {
-                    percentage = (int)((voltageFloat - 3.0f) / 1.2f * 100.0f);
-                }
-
-                lv_label_set_text_fmt(batteryPercentLabel, "Charge: %d%%", percentage);
-
-                // Color code based on percentage
-                if (percentage > 50)
-                {
-                    lv_obj_set_style_text_color(batteryPercentLabel, Theme::green(), 0);
-                }
-                else if (percentage > 20)
-                {
-                    lv_obj_set_style_text_color(batteryPercentLabel, Theme::yellow(), 0);
-                }
-                else
-                {
-                    lv_obj_set_style_text_color(batteryPercentLabel, Theme::red(), 0);
-                }
-            }
+            out.set("Current: Not Charging");
+            out.setTone(Theme::Tone::Secondary);
+        }
+        else if (current > 0)
+        {
+            out.format("Current: %ld mA", (long)current);
+            out.setTone(Theme::Tone::Good);
         }
         else
         {
-            lv_label_set_text(batteryPercentLabel, "Charge: --");
-            lv_obj_set_style_text_color(batteryPercentLabel, Theme::grey(), 0);
+            out.set("Current: 0 mA (Full)");
+            out.setTone(Theme::Tone::Fair);
         }
-    }
+    });
 
-    // Update charging current (when available)
-    if (batteryCurrentLabel)
-    {
-        bool usbConnected = amoled.isVbusIn();
-
-        if (usbConnected)
+    panelPowerText.bind(panelPowerLabel, [](const PanelPowerReading &power, LabelText &out) {
+        if (power.milliwatts == 0)
         {
-            // Try to get charging current from available PMU chips
-            uint16_t chargingCurrent = 0;
-
-            // Check both chips but validate the readings
-            uint16_t syCurrentraw = amoled.SY.getChargeCurrent();
-            uint16_t bqCurrent = amoled.BQ.getChargeCurrent();
-
-            // BQ25896 appears to be the active charging chip on this board
-            // SY6970 returns invalid high values, so prefer BQ25896
-            if (bqCurrent > 0 && bqCurrent <= 1000)
-            {
-                chargingCurrent = bqCurrent;
-            }
-            else if (syCurrentraw > 0 && syCurrentraw <= 1000)
-            {
-                chargingCurrent = syCurrentraw;
-            }
-            else
-            {
-                chargingCurrent = 0; // Both invalid or zero
-            }
-
-            if (chargingCurrent > 0)
-            {
-                lv_label_set_text_fmt(batteryCurrentLabel, "Current: %d mA", chargingCurrent);
-                lv_obj_set_style_text_color(batteryCurrentLabel, Theme::green(), 0);
-            }
-            else
-            {
-                lv_label_set_text(batteryCurrentLabel, "Current: 0 mA (Full)");
-                lv_obj_set_style_text_color(batteryCurrentLabel, Theme::yellow(), 0);
-            }
+            out.set("Panel: --- mW");
+            out.setTone(Theme::Tone::Secondary);
+        }
+        else if (power.budget == 0)
+        {
+            out.format("Panel: ~%u mW", power.milliwatts);
+            out.setTone(Theme::Tone::Primary);
         }
         else
         {
-            lv_label_set_text(batteryCurrentLabel, "Current: Not Charging");
-            lv_obj_set_style_text_color(batteryCurrentLabel, Theme::grey(), 0);
+            // Fair while the budget is dimming the panel
+            out.format("Panel: ~%u mW (budget %u)", power.milliwatts, power.budget);
+            out.setTone(power.limiting ? Theme::Tone::Fair : Theme::Tone::Primary);
         }
+    });
+
+    uptimeText.bind(debugUptime, [](const uint32_t &uptime, LabelText &out) {
+        uint32_t hours = uptime / 3600;
+        uint32_t minutes = (uptime % 3600) / 60;
+        uint32_t seconds = uptime % 60;
+        out.format("Uptime: %02lu:%02lu:%02lu", (unsigned long)hours, (unsigned long)minutes, (unsigned long)seconds);
+    });
+
+    // Profiler figures change every frame - limit how often they are redrawn
+    frameCountText.attach(debugFrameCounter, DEBUG_REFRESH_MS);
+    fpsText.attach(debugFPS, DEBUG_REFRESH_MS);
+    stagesText.attach(debugStages, DEBUG_REFRESH_MS);
+}
+
+void InfoPage::onRelease()
+{
+    gpsModuleText.unbind();
+    batteryVoltageText.unbind();
+    batteryStatusText.unbind();
+    batteryPercentText.unbind();
+    chargeCurrentText.unbind();
+    panelPowerText.unbind();
+    uptimeText.unbind();
+    frameCountText.detach();
+    fpsText.detach();
+    stagesText.detach();
+}
+
+// ============================================================================
+// BATTERY POLLING
+// Each PMU read is an I2C transaction, so sample once per BATTERY_POLL_MS
+// ============================================================================
+void InfoPage::pollBattery(uint32_t now)
+{
+    if (lastBatteryPoll != 0 && now - lastBatteryPoll < BATTERY_POLL_MS)
+    {
+        return;
+    }
+    lastBatteryPoll = now;
+
+    battery.millivolts = Power::getBattVoltage();
+    battery.usbConnected = Power::isVbusIn();
+    chargeCurrent = battery.usbConnected ? Power::getChargeCurrent() : -1;
+}
+
+void InfoPage::update()
+{
+    uint32_t now = millis();
+
+    // Update GPS module status
+    GPSModuleInfo gpsInfo;
+    gpsInfo.connected = gps.isConnected();
+    gpsInfo.status = gps.getStatus();
+    gpsInfo.satellites = gps.getSatelliteCount();
+    gpsInfo.quality = gps.getStatusString();
+    gpsModuleText.set(gpsInfo);
+
+    // Update battery status from the last PMU sample
+    pollBattery(now);
+    batteryVoltageText.set(battery);
+    batteryStatusText.set(battery);
+    batteryPercentText.set(battery);
+    chargeCurrentText.set(chargeCurrent);
+
+    // Panel power estimate, kept by the flush
+    const PowerEstimator &estimator = PowerEstimator::getInstance();
+    PanelPowerReading power;
+    if (estimator.isRunning())
+    {
+        power.milliwatts = (uint16_t)(estimator.estimateMw() + 0.5f);
+        power.budget = estimator.getBudget();
+        power.limiting = estimator.isLimiting();
     }
+    panelPowerText.set(power);
+
+#if FRAME_PROFILER
+    // Rendered frames, not update() calls - counted by the frame profiler
+    const FrameProfiler &profiler = FrameProfiler::getInstance();
 
     // Update frame counter display
-    if (debugFrameCounter)
+    if (frameCountText.due())
     {
-        lv_label_set_text_fmt(debugFrameCounter, "Frames: %lu", frameCount);
+        frameCountText.format("Frames: %lu", (unsigned long)profiler.getFrameCount());
     }
 
-    // Update FPS display
-    if (debugFPS)
+    // Update FPS display with the slowest frame seen
+    if (fpsText.due())
     {
-        lv_label_set_text_fmt(debugFPS, "FPS: %.1f", currentFPS);
+        fpsText.format("FPS: %.1f  Worst: %.1f ms", profiler.getFPS(), profiler.getWorstFrameUs() / 1000.0f);
     }
 
-    // Update uptime display
-    if (debugUptime)
+    // Update per-stage p95 display (update / layout / draw / flush)
+    if (stagesText.due())
     {
-        uint32_t uptime = now / 1000;
-        uint32_t hours = uptime / 3600;
-        uint32_t minutes = (uptime % 3600) / 60;
-        uint32_t seconds = uptime % 60;
-        lv_label_set_text_fmt(debugUptime, "Uptime: %02lu:%02lu:%02lu", hours, minutes, seconds);
+        stagesText.format("p95 U/L/D/F: %.1f/%.1f/%.1f/%.1f ms",
+                          profiler.getHistogram(Stage::Update).percentile(95) / 1000.0f,
+                          profiler.getHistogram(Stage::Layout).percentile(95) / 1000.0f,
+                          profiler.getHistogram(Stage::Draw).percentile(95) / 1000.0f,
+                          profiler.getHistogram(Stage::Flush).percentile(95) / 1000.0f);
     }
+#endif
+
+    // Update uptime display
+    uptimeText.set(now / 1000);
 }
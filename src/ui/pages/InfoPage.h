@@ -1,12 +1,58 @@
 #pragma once
 #include "../Page.h"
 #include "../Theme.h"
+#include "../Binding.h"
 #include "../../sensors/GPS.h"
-#include "../../display.h"
+#include "../../sensors/Power.h"
 
 // External sensor instances from main.cpp
 extern GPS gps;
-extern Display display;
+
+/**
+ * GPS module summary shown on the info page.
+ */
+struct GPSModuleInfo
+{
+    bool connected = false;
+    GPSStatus status = GPSStatus::NotConnected;
+    uint32_t satellites = 0;
+    const char *quality = ""; // Points at a GPS::getStatusString() literal
+
+    bool operator==(const GPSModuleInfo &other) const
+    {
+        return connected == other.connected && status == other.status &&
+               satellites == other.satellites && quality == other.quality;
+    }
+};
+
+/**
+ * One sample of the battery state from the PMU.
+ */
+struct BatteryReading
+{
+    uint16_t millivolts = 0; // 0 = no battery
+    bool usbConnected = false;
+
+    bool operator==(const BatteryReading &other) const
+    {
+        return millivolts == other.millivolts && usbConnected == other.usbConnected;
+    }
+};
+
+/**
+ * Panel power estimate as shown, whole milliwatts.
+ */
+struct PanelPowerReading
+{
+    uint16_t milliwatts = 0; // 0 = no estimate
+    uint16_t budget = 0;     // 0 = no budget
+    bool limiting = false;   // Budget holding brightness or the secondary tone down
+
+    bool operator==(const PanelPowerReading &other) const
+    {
+        return milliwatts == other.milliwatts && budget == other.budget && limiting == other.limiting;
+    }
+};
 
 /**
  * Info page showing system status.
@@ -28,21 +74,42 @@ private:
     lv_obj_t *batteryStatusLabel = nullptr;
     lv_obj_t *batteryPercentLabel = nullptr;
     lv_obj_t *batteryCurrentLabel = nullptr;
+    lv_obj_t *panelPowerLabel = nullptr;
 
     // Debug UI Elements
     lv_obj_t *debugFrameCounter = nullptr;
     lv_obj_t *debugFPS = nullptr;
+    lv_obj_t *debugStages = nullptr;
     lv_obj_t *debugUptime = nullptr;
 
-    // Debug tracking variables
-    uint32_t frameCount = 0;
-    uint32_t lastFPSUpdate = 0;
-    uint32_t framesThisSecond = 0;
-    float currentFPS = 0.0f;
+    // Label bindings - only call into LVGL when the shown text changes
+    BoundLabel<GPSModuleInfo> gpsModuleText;
+    BoundLabel<BatteryReading> batteryVoltageText;
+    BoundLabel<BatteryReading> batteryStatusText;
+    BoundLabel<BatteryReading> batteryPercentText;
+    BoundLabel<int32_t> chargeCurrentText; // mA, -1 = not charging
+    BoundLabel<PanelPowerReading> panelPowerText;
+    BoundLabel<uint32_t> uptimeText;       // Seconds
+    LabelBinding frameCountText;
+    LabelBinding fpsText;
+    LabelBinding stagesText;
+
+    // Battery state is read over I2C, so it is sampled at a fixed rate
+    static constexpr uint32_t BATTERY_POLL_MS = 1000;
+    uint32_t lastBatteryPoll = 0;
+    BatteryReading battery;
+    int32_t chargeCurrent = -1;
+
+    // Profiler figures change every frame - redraw them at most this often
+    static constexpr uint32_t DEBUG_REFRESH_MS = 500;
+
+    void bindLabels();
+    void pollBattery(uint32_t now);
 
 public:
     InfoPage() : Page("Info") {}
 
     void create() override;
+    void onRelease() override;
     void update() override;
 };
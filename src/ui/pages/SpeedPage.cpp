@@ -1,76 +1,81 @@
 #include "SpeedPage.h"
+#include "../FrameScheduler.h"
+#include "../RenderGovernor.h"
 
 void SpeedPage::create()
 {
     // Satellites label - top left
     satsLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(satsLabel, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(satsLabel, Theme::white(), 0);
+    Theme::apply(satsLabel, Theme::Text::Caption, Theme::Tone::Primary);
     lv_obj_align(satsLabel, LV_ALIGN_TOP_LEFT, 5, 5);
     lv_label_set_text(satsLabel, "Sats. -");
 
     // GPS quality indicator
     gpsQualityLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(gpsQualityLabel, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(gpsQualityLabel, Theme::grey(), 0);
+    Theme::apply(gpsQualityLabel, Theme::Text::Caption, Theme::Tone::Secondary);
     lv_obj_align(gpsQualityLabel, LV_ALIGN_TOP_LEFT, 105, 5);
     lv_label_set_text(gpsQualityLabel, "(No Fix)");
 
     // Recent max label
     recentMaxLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(recentMaxLabel, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(recentMaxLabel, Theme::white(), 0);
+    Theme::apply(recentMaxLabel, Theme::Text::Caption, Theme::Tone::Primary);
     lv_obj_align(recentMaxLabel, LV_ALIGN_TOP_LEFT, 5, 125);
     lv_label_set_text(recentMaxLabel, "Recent Max.");
+    markStatic(recentMaxLabel);
 
     // Recent max units
     recentMaxUnits = lv_label_create(tile);
-    lv_obj_set_style_text_font(recentMaxUnits, &lv_font_montserrat_34, 0);
-    lv_obj_set_style_text_color(recentMaxUnits, Theme::white(), 0);
+    Theme::apply(recentMaxUnits, Theme::Text::Title, Theme::Tone::Primary);
     lv_obj_align(recentMaxUnits, LV_ALIGN_TOP_LEFT, 168, 185);
     lv_label_set_text(recentMaxUnits, "mph");
+    markStatic(recentMaxUnits);
 
     // Main speed units
     mainSpeedUnits = lv_label_create(tile);
-    lv_obj_set_style_text_font(mainSpeedUnits, &lv_font_montserrat_48, 0);
-    lv_obj_set_style_text_color(mainSpeedUnits, Theme::grey(), 0);
+    Theme::apply(mainSpeedUnits, Theme::Text::Units, Theme::Tone::Secondary);
     lv_obj_align(mainSpeedUnits, LV_ALIGN_BOTTOM_RIGHT, 0, -10);
     lv_label_set_text(mainSpeedUnits, "mph");
+    markStatic(mainSpeedUnits);
 
     // Main speed display (large number)
     mainSpeed = lv_label_create(tile);
-    lv_obj_set_style_text_font(mainSpeed, &RobotoBlack_200, 0);
-    lv_obj_set_style_text_color(mainSpeed, Theme::white(), 0);
+    Theme::apply(mainSpeed, Theme::Text::ValueLarge, Theme::Tone::Primary);
     lv_obj_align(mainSpeed, LV_ALIGN_BOTTOM_RIGHT, 0, -25);
     lv_label_set_text(mainSpeed, "--");
 
     // Clock display
     clockDisplay = lv_label_create(tile);
-    lv_obj_set_style_text_font(clockDisplay, &RobotoBlack_60, 0);
-    lv_obj_set_style_text_color(clockDisplay, Theme::white(), 0);
+    Theme::apply(clockDisplay, Theme::Text::ValueMedium, Theme::Tone::Primary);
     lv_obj_align(clockDisplay, LV_ALIGN_BOTTOM_RIGHT, -350, -130);
     lv_label_set_text(clockDisplay, "--:--");
 
     // Recent max speed value
     recentMaxValue = lv_label_create(tile);
-    lv_obj_set_style_text_font(recentMaxValue, &RobotoBlack_60, 0);
-    lv_obj_set_style_text_color(recentMaxValue, Theme::white(), 0);
+    Theme::apply(recentMaxValue, Theme::Text::ValueMedium, Theme::Tone::Primary);
     lv_obj_align(recentMaxValue, LV_ALIGN_BOTTOM_RIGHT, -370, -10);
     lv_label_set_text(recentMaxValue, "0.0");
+
+    bindLabels();
 }
 
-void SpeedPage::update()
+void SpeedPage::onRelease()
 {
-    // Track recent max speed in the background (always runs)
-    trackRecentMaxSpeed();
+    satsText.unbind();
+    qualityText.unbind();
+    clockText.unbind();
+    speedText.unbind();
+    recentMaxText.unbind();
+}
 
+void SpeedPage::update()
+{
     // Only update display when page is active for efficiency
     if (!isPageActive)
     {
         return;
     }
 
-    // Update GPS displays using change detection for efficiency
+    // Push current values - the bindings only touch LVGL when the text changes
     updateSatelliteDisplay();
     updateGPSStatusDisplay();
     updateClockDisplay();
@@ -79,87 +84,99 @@ void SpeedPage::update()
 }
 
 // ============================================================================
-// SATELLITE COUNT DISPLAY
-// Only updates the label if the value has changed
+// LABEL BINDINGS
+// Formatters turn values into label text; they run only when a value changes
 // ============================================================================
-void SpeedPage::updateSatelliteDisplay()
+void SpeedPage::bindLabels()
 {
-    int32_t currentSats = gps.getSatelliteCount();
+    // "Sats. X" or "Sats. -" if no data (-1)
+    satsText.bind(satsLabel, [](const int32_t &sats, LabelText &out) {
+        if (sats < 0)
+        {
+            out.set("Sats. -");
+        }
+        else
+        {
+            out.format("Sats. %ld", (long)sats);
+        }
+    });
 
-    // Skip update if value hasn't changed (efficiency)
-    if (currentSats == cachedSatelliteCount)
-    {
-        return;
-    }
+    // Color coding: Red (error), Orange (poor), Yellow (fair), Green (good/excellent)
+    qualityText.bind(gpsQualityLabel, [](const GPSStatus &status, LabelText &out) {
+        out.set(getStatusText(status));
+        out.setTone(getStatusTone(status));
+    });
 
-    // Update cache and display
-    cachedSatelliteCount = currentSats;
+    // HH:MM (24-hour) from minutes since midnight, "--:--" when no GPS time (-1)
+    clockText.bind(clockDisplay, [](const int32_t &minutes, LabelText &out) {
+        if (minutes < 0)
+        {
+            out.set("--:--");
+        }
+        else
+        {
+            out.format("%02ld:%02ld", (long)(minutes / 60), (long)(minutes % 60));
+        }
+    });
 
-    // Format: "Sats. X" or "Sats. -" if no data
-    char buffer[16];
-    if (gps.isConnected())
-    {
-        snprintf(buffer, sizeof(buffer), "Sats. %ld", currentSats);
-    }
-    else
-    {
-        snprintf(buffer, sizeof(buffer), "Sats. -");
-    }
+    // Whole mph, "--" when there is no fix (-1)
+    speedText.bind(mainSpeed, [](const int32_t &speed, LabelText &out) {
+        if (speed < 0)
+        {
+            out.set("--");
+        }
+        else
+        {
+            out.format("%ld", (long)speed);
+        }
+    });
+
+    // Tenths of mph
+    recentMaxText.bind(recentMaxValue, [](const int32_t &tenths, LabelText &out) {
+        out.format("%.1f", tenths / 10.0f);
+    });
+}
 
-    lv_label_set_text(satsLabel, buffer);
+// ============================================================================
+// SATELLITE COUNT DISPLAY
+// ============================================================================
+void SpeedPage::updateSatelliteDisplay()
+{
+    satsText.set(gps.isConnected() ? (int32_t)gps.getSatelliteCount() : -1);
 }
 
 // ============================================================================
 // GPS STATUS DISPLAY
-// Updates status text and color only when status changes
-// Color coding: Red (error), Orange (poor), Yellow (fair), Green (good/excellent)
 // ============================================================================
 void SpeedPage::updateGPSStatusDisplay()
 {
-    GPSStatus currentStatus = gps.getStatus();
-
-    // Skip update if status hasn't changed (efficiency)
-    // But always update on first run to sync display with actual state
-    if (currentStatus == cachedGPSStatus && !firstUpdate)
-    {
-        return;
-    }
-
-    // Update cache and clear first update flag
-    cachedGPSStatus = currentStatus;
-    firstUpdate = false;
-
-    // Update text
-    lv_label_set_text(gpsQualityLabel, getStatusText(currentStatus));
-
-    // Update color based on status
-    lv_obj_set_style_text_color(gpsQualityLabel, getStatusColor(currentStatus), 0);
+    qualityText.set(gps.getStatus());
 }
 
 // ============================================================================
-// STATUS COLOR MAPPING
-// Returns appropriate color for each GPS status level
+// STATUS TONE MAPPING
+// Returns the theme tone for each GPS status level
 // ============================================================================
-lv_color_t SpeedPage::getStatusColor(GPSStatus status)
+Theme::Tone SpeedPage::getStatusTone(GPSStatus status)
 {
     switch (status)
     {
     case GPSStatus::NotConnected:
     case GPSStatus::NoFix:
-        return lv_color_hex(0xFF0000); // Red - Error/No signal
+        return Theme::Tone::Bad; // Error/No signal
 
     case GPSStatus::Poor:
-        return lv_color_hex(0xFF8000); // Orange - Poor accuracy
+        return Theme::Tone::Poor; // Poor accuracy
 
     case GPSStatus::Fair:
-        return lv_color_hex(0xFFFF00); // Yellow - Fair accuracy
+        return Theme::Tone::Fair; // Fair accuracy
 
     case GPSStatus::Good:
     case GPSStatus::Excellent:
-        return lv_color_hex(0x00FF00); // Green - Good/Excellent accuracy
+        return Theme::Tone::Good; // Good/Excellent accuracy
 
     default:
-        return Theme::grey(); // Fallback
+        return Theme::Tone::Secondary; // Fallback
     }
 }
 
@@ -197,48 +214,33 @@ const char *SpeedPage::getStatusText(GPSStatus status)
 // ============================================================================
 // CLOCK DISPLAY UPDATE
 // Shows GPS time when available, "--:--" when no GPS time
-// Only updates when time changes for efficiency
 // ============================================================================
 void SpeedPage::updateClockDisplay()
 {
     GPSTime currentTime = gps.getTime();
     bool timeIsValid = currentTime.valid && gps.isConnected();
 
-    // Check if we need to update
-    bool timeChanged = (currentTime.hour != cachedHour || currentTime.minute != cachedMinute);
-    bool timeValidityChanged = (timeIsValid != cachedTimeWasValid);
-
-    if (!timeChanged && !timeValidityChanged && !firstUpdate)
-    {
-        return; // No change, skip update for efficiency
-    }
-
-    // Update cache
-    cachedHour = currentTime.hour;
-    cachedMinute = currentTime.minute;
-    cachedTimeWasValid = timeIsValid;
+    clockText.set(timeIsValid ? currentTime.hour * 60 + currentTime.minute : -1);
+}
 
-    // Format and display time
-    char timeBuffer[8];
-    if (timeIsValid)
-    {
-        // Format as HH:MM (24-hour format)
-        snprintf(timeBuffer, sizeof(timeBuffer), "%02d:%02d", currentTime.hour, currentTime.minute);
-    }
-    else
+// The clock strip is what stays on while parked in partial mode
+bool SpeedPage::getParkedArea(lv_area_t &area) const
+{
+    if (!created || clockDisplay == nullptr)
     {
-        // No valid GPS time
-        snprintf(timeBuffer, sizeof(timeBuffer), "--:--");
+        return false;
     }
-
-    lv_label_set_text(clockDisplay, timeBuffer);
+    lv_obj_get_coords(clockDisplay, &area);
+    area.x1 -= PARKED_MARGIN;
+    area.x2 += PARKED_MARGIN;
+    return true;
 }
 
 // ============================================================================
 // SPEED DISPLAY UPDATE
 // Shows GPS speed when available, "--" when no GPS fix
 // Rounds to nearest whole number, clamps values under 0.8 to zero
-// Only updates when speed changes for efficiency
+// Animates one mph at a time towards the target
 // ============================================================================
 void SpeedPage::updateSpeedDisplay()
 {
@@ -265,22 +267,15 @@ void SpeedPage::updateSpeedDisplay()
     {
         targetSpeed = newTargetSpeed;
 
-        // If no GPS data, update display immediately
-        if (targetSpeed == -1)
-        {
-            displayedSpeed = -1;
-            lv_label_set_text(mainSpeed, "--");
-            return;
-        }
-
-        // If first update or large jump (more than 10 mph), set immediately
-        if (firstUpdate || abs(targetSpeed - displayedSpeed) > 10)
+        // No GPS data, or first update, or large jump (more than 10 mph), or the
+        // governor has animations off - set immediately
+        if (targetSpeed == -1 || firstUpdate || abs(targetSpeed - displayedSpeed) > 10 ||
+            RenderGovernor::getInstance().atLeast(Quality::NoAnimations))
         {
             displayedSpeed = targetSpeed;
-            lv_label_set_text_fmt(mainSpeed, "%ld", displayedSpeed);
-            return;
         }
     }
+    firstUpdate = false;
 
     // Smooth animation: increment displayed speed towards target
     uint32_t now = millis();
@@ -294,11 +289,16 @@ void SpeedPage::updateSpeedDisplay()
         {
             displayedSpeed--;
         }
-
-        // Update display
-        lv_label_set_text_fmt(mainSpeed, "%ld", displayedSpeed);
         lastSpeedUpdate = now;
     }
+
+    speedText.set(displayedSpeed);
+
+    // Keep the display task awake until the roll-up/down reaches the target
+    if (displayedSpeed != targetSpeed)
+    {
+        FrameScheduler::getInstance().requestUpdate(SPEED_INCREMENT_INTERVAL_MS - (now - lastSpeedUpdate));
+    }
 }
 
 // ============================================================================
@@ -352,23 +352,10 @@ void SpeedPage::trackRecentMaxSpeed()
 
 // ============================================================================
 // RECENT MAX DISPLAY UPDATE
-// Only updates display label when value has changed (efficiency)
 // Rounds to nearest 0.1 mph
 // ============================================================================
 void SpeedPage::updateRecentMaxDisplay()
 {
     // Round to nearest 0.1 mph for display
-    float roundedMax = roundf(displayedRecentMax * 10.0f) / 10.0f;
-
-    // Skip update if value hasn't changed (efficiency)
-    if (fabs(roundedMax - cachedRecentMaxDisplay) < 0.01f)
-    {
-        return;
-    }
-
-    // Update cache
-    cachedRecentMaxDisplay = roundedMax;
-
-    // Update display
-    lv_label_set_text_fmt(recentMaxValue, "%.1f", roundedMax);
+    recentMaxText.set((int32_t)roundf(displayedRecentMax * 10.0f));
 }
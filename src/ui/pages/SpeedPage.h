@@ -1,12 +1,9 @@
 #pragma once
 #include "../Page.h"
 #include "../Theme.h"
+#include "../Binding.h"
 #include "../../sensors/GPS.h"
 
-// External font declarations
-LV_FONT_DECLARE(RobotoBlack_60);
-LV_FONT_DECLARE(RobotoBlack_200);
-
 // Forward declaration - GPS instance is defined in main.cpp
 extern GPS gps;
 
@@ -27,15 +24,14 @@ private:
     lv_obj_t *clockDisplay = nullptr;
     lv_obj_t *recentMaxValue = nullptr;
 
-    // Cached state for change detection (only update display when values change)
-    int32_t cachedSatelliteCount = -1;
-    GPSStatus cachedGPSStatus = GPSStatus::NotConnected;
-    uint8_t cachedHour = 255;        // Invalid initial value to force first update
-    uint8_t cachedMinute = 255;      // Invalid initial value to force first update
-    bool cachedTimeWasValid = false; // Track when GPS time becomes valid
-    int32_t cachedSpeed = -1;        // Cached speed for change detection
-    bool firstUpdate = true;         // Force update on first run to sync display with actual state
-    bool isPageActive = false;       // Track if this page is currently visible
+    // Label bindings - only call into LVGL when the shown text changes
+    BoundLabel<int32_t> satsText;      // Satellite count, -1 = no GPS
+    BoundLabel<GPSStatus> qualityText; // GPS quality text and color
+    BoundLabel<int32_t> clockText;     // Minutes since midnight, -1 = no GPS time
+    BoundLabel<int32_t> speedText;     // Displayed speed, -1 = no fix
+    BoundLabel<int32_t> recentMaxText; // Recent max in tenths of mph
+    bool firstUpdate = true;           // Show the first speed immediately instead of animating
+    bool isPageActive = false;         // Track if this page is currently visible
 
     // Speed animation state
     int32_t targetSpeed = 0;                                     // Target speed we're animating towards
@@ -46,26 +42,33 @@ private:
     // Recent max speed tracking (works in background)
     float currentSessionMax = 0.0f;                         // Max speed in current session (reset when speed < 5 mph)
     float displayedRecentMax = 0.0f;                        // Value currently shown on display
-    float cachedRecentMaxDisplay = -1.0f;                   // For change detection on display updates
     bool isRecordingMax = false;                            // True when speed >= 10 mph (recording active)
     static constexpr float MAX_RECORDING_THRESHOLD = 10.0f; // Start recording above this speed (mph)
     static constexpr float MAX_RESET_THRESHOLD = 5.0f;      // Reset session when below this speed (mph)
 
     // Helper methods for clean, readable code
+    void bindLabels();
     void updateSatelliteDisplay();
     void updateGPSStatusDisplay();
     void updateClockDisplay();
+
+    // The clock's width changes with its text; keep this much either side lit
+    static constexpr lv_coord_t PARKED_MARGIN = 32;
     void updateSpeedDisplay();
-    void trackRecentMaxSpeed();    // Runs in background (always)
+    void trackRecentMaxSpeed();    // Runs in background (always, even when released)
     void updateRecentMaxDisplay(); // Only updates display when visible
-    lv_color_t getStatusColor(GPSStatus status);
-    const char *getStatusText(GPSStatus status);
+    static Theme::Tone getStatusTone(GPSStatus status);
+    static const char *getStatusText(GPSStatus status);
 
 public:
     SpeedPage() : Page("Speed") {}
 
     void create() override;
+    void onRelease() override;
     void update() override;
+    void backgroundUpdate() override { trackRecentMaxSpeed(); }
     void onEnter() override { isPageActive = true; }
     void onExit() override { isPageActive = false; }
+    bool isCritical() const override { return true; }
+    bool getParkedArea(lv_area_t &area) const override;
 };
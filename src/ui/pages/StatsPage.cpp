@@ -4,22 +4,19 @@ void StatsPage::create()
 {
     // Sat status in top-left
     satsLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(satsLabel, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(satsLabel, Theme::white(), 0);
+    Theme::apply(satsLabel, Theme::Text::Caption, Theme::Tone::Primary);
     lv_obj_align(satsLabel, LV_ALIGN_TOP_LEFT, 5, 5);
     lv_label_set_text(satsLabel, "Sats. 0");
 
     // Speed display at top center
     speedLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(speedLabel, &RobotoBlack_60, 0);
-    lv_obj_set_style_text_color(speedLabel, Theme::white(), 0);
+    Theme::apply(speedLabel, Theme::Text::ValueMedium, Theme::Tone::Primary);
     lv_obj_align(speedLabel, LV_ALIGN_TOP_LEFT, 200, 5);
     lv_label_set_text(speedLabel, "0.0");
 
     // mph units label
     speedUnits = lv_label_create(tile);
-    lv_obj_set_style_text_font(speedUnits, &lv_font_montserrat_34, 0);
-    lv_obj_set_style_text_color(speedUnits, Theme::grey(), 0);
+    Theme::apply(speedUnits, Theme::Text::Title, Theme::Tone::Secondary);
     lv_obj_align(speedUnits, LV_ALIGN_TOP_LEFT, 300, 15);
     lv_label_set_text(speedUnits, "mph");
 
@@ -27,31 +24,40 @@ void StatsPage::create()
     lv_obj_t *headerLine = lv_line_create(tile);
     static lv_point_t headerLinePoints[] = {{0, 0}, {480, 0}};
     lv_line_set_points(headerLine, headerLinePoints, 2);
-    lv_obj_set_style_line_color(headerLine, Theme::grey(), 0);
+    Theme::apply(headerLine, Theme::Tone::Secondary);
     lv_obj_set_style_line_width(headerLine, 4, 0);
     lv_obj_align(headerLine, LV_ALIGN_TOP_MID, 0, 70);
+    markStatic(headerLine);
 
     // Vertical divider line splitting page in half
     lv_obj_t *dividerLine = lv_line_create(tile);
     static lv_point_t dividerLinePoints[] = {{0, 0}, {0, 120}};
     lv_line_set_points(dividerLine, dividerLinePoints, 2);
-    lv_obj_set_style_line_color(dividerLine, Theme::grey(), 0);
+    Theme::apply(dividerLine, Theme::Tone::Secondary);
     lv_obj_set_style_line_width(dividerLine, 2, 0);
     lv_obj_align(dividerLine, LV_ALIGN_TOP_MID, 0, 100);
+    markStatic(dividerLine);
 
     // 0-60 time display (left side below divider)
     zeroToSixtyLabel = lv_label_create(tile);
-    lv_obj_set_style_text_font(zeroToSixtyLabel, &RobotoBlack_60, 0);
-    lv_obj_set_style_text_color(zeroToSixtyLabel, Theme::white(), 0);
+    Theme::apply(zeroToSixtyLabel, Theme::Text::ValueMedium, Theme::Tone::Primary);
     lv_obj_align(zeroToSixtyLabel, LV_ALIGN_TOP_LEFT, 20, 87);
     lv_label_set_text(zeroToSixtyLabel, "0.00");
 
     // 0-60 units label
     zeroToSixtyUnits = lv_label_create(tile);
-    lv_obj_set_style_text_font(zeroToSixtyUnits, &lv_font_montserrat_28, 0);
-    lv_obj_set_style_text_color(zeroToSixtyUnits, Theme::grey(), 0);
+    Theme::apply(zeroToSixtyUnits, Theme::Text::Caption, Theme::Tone::Secondary);
     lv_obj_align(zeroToSixtyUnits, LV_ALIGN_TOP_LEFT, 150, 110);
     lv_label_set_text(zeroToSixtyUnits, "s (0-60)");
+    markStatic(zeroToSixtyUnits);
+
+    bindLabels();
+}
+
+void StatsPage::onRelease()
+{
+    speedText.unbind();
+    satsText.unbind();
 }
 
 void StatsPage::update()
@@ -66,33 +72,49 @@ void StatsPage::update()
     updateSatelliteDisplay();
 }
 
+// ============================================================================
+// LABEL BINDINGS
+// ============================================================================
+void StatsPage::bindLabels()
+{
+    // Tenths of mph, "--.-" without a fix (-1)
+    speedText.bind(speedLabel, [](const int32_t &tenths, LabelText &out) {
+        if (tenths < 0)
+        {
+            out.set("--.-");
+        }
+        else
+        {
+            out.format("%.1f", tenths / 10.0f);
+        }
+    });
+
+    // "Sats. X" or "Sats. -" if no data (-1)
+    satsText.bind(satsLabel, [](const int32_t &sats, LabelText &out) {
+        if (sats < 0)
+        {
+            out.set("Sats. -");
+        }
+        else
+        {
+            out.format("Sats. %ld", (long)sats);
+        }
+    });
+}
+
 // ============================================================================
 // SPEED DISPLAY UPDATE (to 0.1 mph precision)
 // ============================================================================
 void StatsPage::updateSpeedDisplay()
 {
-    float currentSpeed = gps.getSpeedMph();
-
-    // Round to nearest 0.1 mph
-    float roundedSpeed = roundf(currentSpeed * 10.0f) / 10.0f;
-
-    // Skip update if speed hasn't changed (efficiency)
-    if (fabs(roundedSpeed - cachedSpeed) < 0.01f)
-    {
-        return;
-    }
-
-    // Update cache
-    cachedSpeed = roundedSpeed;
-
-    // Update display
     if (gps.hasFix() && gps.isConnected())
     {
-        lv_label_set_text_fmt(speedLabel, "%.1f", roundedSpeed);
+        // Round to nearest 0.1 mph
+        speedText.set((int32_t)roundf(gps.getSpeedMph() * 10.0f));
     }
     else
     {
-        lv_label_set_text(speedLabel, "--.-");
+        speedText.set(-1);
     }
 }
 
@@ -101,24 +123,5 @@ void StatsPage::updateSpeedDisplay()
 // ============================================================================
 void StatsPage::updateSatelliteDisplay()
 {
-    int32_t currentSats = gps.getSatelliteCount();
-
-    // Skip update if value hasn't changed
-    if (currentSats == cachedSatellites)
-    {
-        return;
-    }
-
-    // Update cache
-    cachedSatellites = currentSats;
-
-    // Update display
-    if (gps.isConnected())
-    {
-        lv_label_set_text_fmt(satsLabel, "Sats. %ld", currentSats);
-    }
-    else
-    {
-        lv_label_set_text(satsLabel, "Sats. -");
-    }
+    satsText.set(gps.isConnected() ? (int32_t)gps.getSatelliteCount() : -1);
 }
@@ -1,11 +1,9 @@
 #pragma once
 #include "../Page.h"
 #include "../Theme.h"
+#include "../Binding.h"
 #include "../../sensors/GPS.h"
 
-// External font declarations
-LV_FONT_DECLARE(RobotoBlack_60);
-
 // External GPS instance from main.cpp
 extern GPS gps;
 
@@ -23,12 +21,15 @@ private:
     lv_obj_t *zeroToSixtyLabel = nullptr;
     lv_obj_t *zeroToSixtyUnits = nullptr;
 
-    // Page state and caching
+    // Label bindings - only call into LVGL when the shown text changes
+    BoundLabel<int32_t> speedText; // Speed in tenths of mph, -1 = no fix
+    BoundLabel<int32_t> satsText;  // Satellite count, -1 = no GPS
+
+    // Page state
     bool isPageActive = false;
-    float cachedSpeed = -1.0f;     // Cached speed for change detection
-    int32_t cachedSatellites = -1; // Cached satellite count
 
     // Helper methods
+    void bindLabels();
     void updateSpeedDisplay();
     void updateSatelliteDisplay();
 
@@ -36,6 +37,7 @@ public:
     StatsPage() : Page("Stats") {}
 
     void create() override;
+    void onRelease() override;
     void update() override;
     void onEnter() override { isPageActive = true; }
     void onExit() override { isPageActive = false; }
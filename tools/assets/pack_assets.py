@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+Pack the page fonts into the blob flashed to the "assets" partition.
+
+The fonts are the same subsets subset_fonts.py would compile into the app
+(same glyphs, same RLE compression), laid out for src/ui/Assets.h so the
+firmware can use them in place from the memory-mapped partition:
+
+  Header      magic "HUDA", version, entry count, blob size, CRC-32 of the rest
+  Entry[]     name, type, offset, size
+  records     one per asset, 4-byte aligned
+
+A font record is a FontRecord followed by its glyph descriptors (in
+lv_font_fmt_txt_glyph_dsc_t layout), CmapRecords, unicode lists, kerning
+classes and glyph bitmaps. All offsets in a record count from its start.
+
+Usage:
+    python tools/assets/pack_assets.py [--out FILE]
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "fonts"))
+import lvfont  # noqa: E402
+import subset_fonts  # noqa: E402
+
+# Must match src/ui/Assets.h
+MAGIC = b"HUDA"
+VERSION = 1
+TYPE_FONT = 1
+
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<20sIII")
+FONT_RECORD = struct.Struct("<HhbBBBHHHBBIIII")
+CMAP_RECORD = struct.Struct("<IHHHBxII")
+GLYPH_DSC = struct.Struct("<IBBbb")
+
+CMAP_FORMAT0_TINY = 2
+CMAP_SPARSE_TINY = 3
+
+
+def _pad(data: bytearray):
+    data.extend(b"\0" * (-len(data) % 4))
+
+
+def font_record(font: lvfont.Font, compress: bool) -> bytes:
+    """Serialize one font, laid out exactly as lvfont.emit_c() would compile it."""
+    lay = lvfont.layout(font, compress)
+    glyphs = [font.glyphs[i] for i in lay.order]
+    glyph_count = len(glyphs) + 1
+
+    # Character maps: the dense runs, then one sparse map for the rest
+    cmaps = []
+    next_gid = 1
+    for start, length, _ in lay.dense:
+        cmaps.append((start, length, next_gid, 0, CMAP_FORMAT0_TINY, None))
+        next_gid += length
+    if lay.sparse_ids:
+        cps = [font.glyphs[i].codepoint for i in lay.sparse_ids]
+        cmaps.append((cps[0], cps[-1] - cps[0] + 1, next_gid, len(cps), CMAP_SPARSE_TINY,
+                      [cp - cps[0] for cp in cps]))
+
+    body = bytearray(b"\0" * FONT_RECORD.size)
+
+    glyph_dsc = len(body)
+    body += GLYPH_DSC.pack(0, 0, 0, 0, 0)
+    for idx, g in zip(lay.order, glyphs):
+        if lay.offsets[idx] >= 1 << 20 or g.adv_w >= 1 << 12:
+            raise ValueError("%s: glyph U+%04X does not fit the packed descriptor" % (font.name, g.codepoint))
+        body += GLYPH_DSC.pack(lay.offsets[idx] | g.adv_w << 20, g.box_w, g.box_h, g.ofs_x, g.ofs_y)
+
+    cmap_table = len(body)
+    body += b"\0" * (CMAP_RECORD.size * len(cmaps))
+    for i, (start, length, gid, list_length, kind, unicode_list) in enumerate(cmaps):
+        list_ofs = 0
+        if unicode_list:
+            _pad(body)
+            list_ofs = len(body)
+            body += struct.pack("<%dH" % len(unicode_list), *unicode_list)
+        CMAP_RECORD.pack_into(body, cmap_table + i * CMAP_RECORD.size,
+                              start, length, gid, list_length, kind, list_ofs, 0)
+
+    kern = 0
+    if font.kern_left_cnt and font.kern_right_cnt:
+        _pad(body)
+        kern = len(body)
+        body += bytes([0] + [g.left_class for g in glyphs])
+        body += bytes([0] + [g.right_class for g in glyphs])
+        body += struct.pack("<%db" % len(font.kern_values), *font.kern_values)
+
+    _pad(body)
+    bitmap = len(body)
+    body += lay.bitmap
+
+    FONT_RECORD.pack_into(body, 0, font.line_height, font.base_line, font.underline_position,
+                          font.underline_thickness, font.bpp, 1 if compress else 0, font.kern_scale,
+                          len(cmaps), glyph_count, font.kern_left_cnt if kern else 0,
+                          font.kern_right_cnt if kern else 0, glyph_dsc, cmap_table, kern, bitmap)
+    return bytes(body)
+
+
+def pack(src_dir=None):
+    """Return (blob, rows) for every font the UI uses, one row per record."""
+    jobs, _ = subset_fonts.plan(src_dir)
+    records = []
+    for name, job in sorted(jobs.items()):
+        if len(name) >= 20:
+            raise ValueError("%s: asset names are at most 19 characters" % name)
+        full = lvfont.parse_font(job["path"])
+        if job["chars"] is None:
+            font, compress = full, False
+        else:
+            font = lvfont.subset(full, [ord(c) for c in job["chars"]])
+            compress = job["compress"] and full.bpp in (1, 2, 4)
+        records.append((name, font_record(font, compress), len(font.glyphs), compress))
+
+    data = bytearray(b"\0" * (HEADER.size + ENTRY.size * len(records)))
+    rows = []
+    for i, (name, record, glyphs, compress) in enumerate(records):
+        _pad(data)
+        ENTRY.pack_into(data, HEADER.size + i * ENTRY.size, name.encode(), TYPE_FONT, len(data), len(record))
+        rows.append({"name": name, "offset": len(data), "size": len(record), "glyphs": glyphs,
+                     "compressed": compress})
+        data += record
+    _pad(data)
+
+    HEADER.pack_into(data, 0, MAGIC, VERSION, len(records), len(data),
+                     zlib.crc32(bytes(data[HEADER.size:])) & 0xFFFFFFFF)
+    return bytes(data), rows
+
+
+def print_report(blob, rows):
+    for r in rows:
+        print("assets: %-18s %5d glyphs %8d bytes at +0x%05x%s" % (
+            r["name"], r["glyphs"], r["size"], r["offset"], ", RLE" if r["compressed"] else ""))
+    print("assets: blob v%d, %d entries, %d bytes" % (VERSION, len(rows), len(blob)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--src", default=os.path.join(subset_fonts.ROOT, "src"), help="source tree to scan")
+    ap.add_argument("--out", default=os.path.join(subset_fonts.ROOT, ".pio", "assets.bin"), help="output file")
+    args = ap.parse_args()
+
+    blob, rows = pack(args.src)
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    with open(args.out, "wb") as f:
+        f.write(blob)
+    print_report(blob, rows)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,76 @@
+"""
+PlatformIO hook for the asset partition and the app image report.
+
+With `custom_font_assets = yes` the page fonts are packed by pack_assets.py
+into $BUILD_DIR/assets.bin instead of being compiled in (pio_fonts.py drops
+them), and an `uploadassets` target flashes the blob into the "assets"
+partition of the environment's partition table:
+
+    pio run -e T-Display-AMOLED-assets -t uploadassets
+
+Every ESP32 build also reports the app image size and how long it takes to
+send over OTA at `custom_ota_rate` KB/s (default 60, espota over WiFi), so
+environments with and without the asset partition can be compared.
+"""
+
+import csv
+import os
+import sys
+
+Import("env")  # noqa: F821
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools", "assets"))  # noqa: F821
+import pack_assets  # noqa: E402
+
+PARTITION = "assets"
+
+
+def partition_offset(env):
+    """Offset of the asset partition in the environment's partition table, or None."""
+    table = env.GetProjectOption("board_build.partitions", "")
+    path = os.path.join(env.subst("$PROJECT_DIR"), table) if table else ""
+    if not os.path.isfile(path):
+        return None
+    with open(path, encoding="utf-8") as f:
+        for row in csv.reader(line for line in f if not line.lstrip().startswith("#")):
+            if row and row[0].strip() == PARTITION:
+                return row[3].strip()
+    return None
+
+
+def report_image(target, source, env):
+    rate = float(env.GetProjectOption("custom_ota_rate", "60")) * 1024
+    image = os.path.getsize(target[0].get_abspath())
+    print("Image: app %d bytes, OTA ~%.1f s at %d KB/s" % (image, image / rate, rate / 1024))
+    if blob is not None:
+        print("Image: fonts in the asset partition, %d bytes flashed once over serial" % len(blob))
+
+
+enabled = env.GetProjectOption("custom_font_assets", "no").lower() in ("1", "yes", "true", "on")  # noqa: F821
+blob = None
+
+if enabled:
+    blob, rows = pack_assets.pack(env.subst("$PROJECT_SRC_DIR"))  # noqa: F821
+    blob_path = os.path.join(env.subst("$BUILD_DIR"), "assets.bin")  # noqa: F821
+    os.makedirs(os.path.dirname(blob_path), exist_ok=True)
+    with open(blob_path, "wb") as f:
+        f.write(blob)
+    pack_assets.print_report(blob, rows)
+
+    offset = partition_offset(env)  # noqa: F821
+    if offset is None:
+        print("assets: no '%s' partition in board_build.partitions, uploadassets disabled" % PARTITION)
+    else:
+        env.AddCustomTarget(  # noqa: F821
+            name="uploadassets",
+            dependencies=None,
+            actions=[
+                env.VerboseAction(env.AutodetectUploadPort, "Looking for upload port..."),  # noqa: F821
+                '"$PYTHONEXE" "$UPLOADER" --chip $BOARD_MCU --port "$UPLOAD_PORT" --baud $UPLOAD_SPEED '
+                'write_flash %s "%s"' % (offset, blob_path),
+            ],
+            title="Upload assets",
+            description="Flash the font/asset blob into the assets partition")
+
+if env.get("PIOPLATFORM") == "espressif32":  # noqa: F821
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.bin", report_image)  # noqa: F821
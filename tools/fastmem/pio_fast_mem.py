@@ -0,0 +1,101 @@
+"""
+PlatformIO pre-build hook that moves hot code and tables into internal RAM.
+
+LV_ATTRIBUTE_FAST_MEM (IRAM_ATTR when HUD_FAST_MEM is defined, see
+lv_conf.h) covers the blend, mask and letter loops LVGL marks itself. This
+hook adds the rest of the per-glyph path the renderer's profile shows for
+speed page updates - glyph lookup, style lookups, UTF-8 decoding - plus the
+panel flush, and moves their lookup tables out of flash:
+
+  .text.<fn>     -> .iram1.<fn>           (IRAM)
+  .literal.<fn>  -> .iram1.literal.<fn>
+  .rodata.<sym>  -> .dram1.<sym>          (internal DRAM)
+
+The sections are renamed in each compiled object with objcopy, so neither
+LVGL nor the vendor driver is edited. It relies on -ffunction-sections and
+-fdata-sections, which the ESP32 builds use. Enable it with
+`custom_fast_mem = yes` in an environment.
+"""
+
+import fnmatch
+import re
+import subprocess
+
+Import("env")  # noqa: F821
+
+# Source file -> symbols to move (fnmatch patterns, C++ names mangled)
+HOT_SYMBOLS = {
+    # Glyph rendering and its opacity tables
+    "lv_draw_sw_letter.c": ["lv_draw_sw_letter", "_lv_bpp*_opa_table"],
+    "lv_draw_label.c": ["lv_draw_letter"],
+    "lv_font.c": ["lv_font_get_glyph_bitmap", "lv_font_get_glyph_dsc", "lv_font_get_glyph_width"],
+    "lv_font_fmt_txt.c": ["lv_font_get_bitmap_fmt_txt", "lv_font_get_glyph_dsc_fmt_txt",
+                          "get_glyph_dsc_id", "get_kern_value", "unicode_list_compare",
+                          "kern_pair_*_compare"],
+    "lv_txt.c": ["lv_txt_utf8_next", "lv_txt_utf8_size"],
+    # Style lookups done for every object drawn
+    "lv_obj_style.c": ["lv_obj_get_style_prop", "get_prop_core"],
+    "lv_style.c": ["lv_style_get_prop", "_lv_style_get_prop_group", "lv_style_prop_get_default",
+                   "_lv_style_prop_lookup_flags", "_lv_style_builtin_prop_flag_lookup_table"],
+    "lv_obj_tree.c": ["lv_obj_get_parent"],
+    "lv_area.c": ["_lv_area_intersect"],
+    # Panel flush
+    "LilyGo_AMOLED.cpp": ["*LilyGo_AMOLED*pushColors*", "*LilyGo_AMOLED*setAddrWindow*",
+                          "*LilyGo_AMOLED*writeCommand*", "*expandIndexed*"],
+}
+
+# Glyph tables of the fonts the speed page draws with (bitmaps stay in flash)
+FONT_TABLES = ["glyph_dsc", "cmaps", "unicode_list_*", "kern_*", "font_dsc"]
+for font in ("RobotoBlack_60.c", "RobotoBlack_200.c", "lv_font_montserrat_28.c",
+             "lv_font_montserrat_34.c", "lv_font_montserrat_48.c"):
+    HOT_SYMBOLS[font] = FONT_TABLES
+
+# Section prefix -> where it goes
+MOVES = [
+    (".text.", ".iram1."),
+    (".literal.", ".iram1.literal."),
+    (".rodata.", ".dram1."),
+]
+
+SECTION_LINE = re.compile(r"^\s*\d+\s+(\S+)\s")
+
+
+def rename_args(sections, patterns):
+    args = []
+    for section in sections:
+        for prefix, target in MOVES:
+            if not section.startswith(prefix):
+                continue
+            symbol = section[len(prefix):]
+            if any(fnmatch.fnmatchcase(symbol, p) for p in patterns):
+                args += ["--rename-section", section + "=" + target + symbol]
+    return args
+
+
+def make_mover(patterns):
+    def move_sections(target, source, env):
+        objcopy = env.subst("$OBJCOPY")
+        objdump = objcopy[: -len("objcopy")] + "objdump"
+        for node in target:
+            path = node.get_abspath()
+            listing = subprocess.run([objdump, "-h", path], capture_output=True, text=True, check=True)
+            sections = [m.group(1) for m in map(SECTION_LINE.match, listing.stdout.splitlines()) if m]
+            args = rename_args(sections, patterns)
+            if args:
+                subprocess.run([objcopy] + args + [path], check=True)
+                print("Fast mem: %d sections of %s moved to internal RAM" % (len(args) // 2, node.name))
+
+    def middleware(env, node):
+        # Fonts may already be objects built from the subset copies
+        objects = env.Object(node) if str(node).endswith((".c", ".cpp")) else node
+        env.AddPostAction(objects, move_sections)
+        return objects
+
+    return middleware
+
+
+enabled = env.GetProjectOption("custom_fast_mem", "no").lower() in ("1", "yes", "true", "on")  # noqa: F821
+
+if enabled:
+    for name, patterns in HOT_SYMBOLS.items():
+        env.AddBuildMiddleware(make_mover(patterns), "*/" + name)  # noqa: F821
@@ -0,0 +1,558 @@
+"""
+Reader/writer for LVGL 8 "fmt_txt" bitmap fonts as emitted by lv_font_conv.
+
+The .c files in src/fonts are the master copies of every font. This module
+parses them back into glyph records so the build can emit reduced copies
+(subset, optionally RLE-compressed) without needing the original TTF or
+lv_font_conv installed.
+
+Only the subset of the format that lv_font_conv produces is supported:
+plain bitmaps packed without row padding, FORMAT0/SPARSE cmaps and
+class-based kerning.
+"""
+
+import re
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional
+
+
+@dataclass
+class Glyph:
+    codepoint: int
+    adv_w: int
+    box_w: int
+    box_h: int
+    ofs_x: int
+    ofs_y: int
+    bitmap: bytes  # plain, packed at `bpp` bits per pixel
+    left_class: int = 0
+    right_class: int = 0
+
+
+@dataclass
+class Font:
+    name: str
+    size_px: int
+    bpp: int
+    line_height: int
+    base_line: int
+    underline_position: int
+    underline_thickness: int
+    kern_scale: int
+    glyphs: List[Glyph] = field(default_factory=list)
+    # Class-based kerning: values[(left - 1) * right_cnt + (right - 1)]
+    kern_left_cnt: int = 0
+    kern_right_cnt: int = 0
+    kern_values: List[int] = field(default_factory=list)
+
+    def glyph(self, codepoint: int) -> Optional[Glyph]:
+        for g in self.glyphs:
+            if g.codepoint == codepoint:
+                return g
+        return None
+
+    def bitmap_bytes(self) -> int:
+        return sum(len(g.bitmap) for g in self.glyphs)
+
+
+# ============================================================================
+# PARSING
+# ============================================================================
+
+_NUM = re.compile(r"-?0x[0-9a-fA-F]+|-?\d+")
+
+
+def _strip_comments(text: str) -> str:
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def _array_body(src: str, name: str) -> Optional[str]:
+    m = re.search(r"\b" + re.escape(name) + r"\s*\[\]\s*=\s*\{(.*?)\};", src, re.S)
+    return m.group(1) if m else None
+
+
+def _int_array(src: str, name: str) -> List[int]:
+    body = _array_body(src, name)
+    if body is None:
+        return []
+    return [int(v, 0) for v in _NUM.findall(_strip_comments(body))]
+
+
+def _field(src: str, name: str, default: Optional[int] = None) -> int:
+    m = re.search(r"\." + re.escape(name) + r"\s*=\s*(-?\d+)", src)
+    if m:
+        return int(m.group(1))
+    if default is None:
+        raise ValueError("font field .%s not found" % name)
+    return default
+
+
+def parse_font(path: str) -> Font:
+    with open(path, encoding="utf-8") as f:
+        src = f.read()
+
+    m = re.search(r"^(?:const\s+)?lv_font_t\s+(\w+)\s*=", src, re.M)
+    if not m:
+        raise ValueError("%s: no public lv_font_t found" % path)
+    name = m.group(1)
+
+    size_m = re.search(r"Size:\s*(\d+)\s*px", src)
+    dsc_m = re.search(r"lv_font_fmt_txt_dsc_t\s+font_dsc\s*=\s*\{(.*?)\};", src, re.S)
+    if not dsc_m:
+        raise ValueError("%s: font_dsc not found" % path)
+    dsc = dsc_m.group(1)
+    if _field(dsc, "bitmap_format", 0) != 0:
+        raise ValueError("%s: only plain (uncompressed) masters are supported" % path)
+
+    font = Font(
+        name=name,
+        size_px=int(size_m.group(1)) if size_m else 0,
+        bpp=_field(dsc, "bpp"),
+        line_height=_field(src, "line_height"),
+        base_line=_field(src, "base_line"),
+        underline_position=_field(src, "underline_position", 0),
+        underline_thickness=_field(src, "underline_thickness", 0),
+        kern_scale=_field(dsc, "kern_scale", 16),
+    )
+
+    bitmap = bytes(v & 0xFF for v in _int_array(src, "glyph_bitmap"))
+
+    # lv_font_conv annotates every glyph's bitmap with its code point, in
+    # glyph id order. Some masters have had their sparse unicode lists
+    # emptied, so these comments are the reliable source of the mapping.
+    codepoints = [int(c, 16) for c in re.findall(r"^\s*/\* U\+([0-9A-Fa-f]+)", src, re.M)]
+
+    dsc_re = re.compile(
+        r"\{\.bitmap_index\s*=\s*(\d+),\s*\.adv_w\s*=\s*(\d+),\s*\.box_w\s*=\s*(\d+),"
+        r"\s*\.box_h\s*=\s*(\d+),\s*\.ofs_x\s*=\s*(-?\d+),\s*\.ofs_y\s*=\s*(-?\d+)\}")
+    dsc_body = _array_body(src, "glyph_dsc")
+    records = [tuple(int(v) for v in r) for r in dsc_re.findall(dsc_body or "")]
+    if len(records) != len(codepoints) + 1:
+        raise ValueError("%s: %d glyph descriptors but %d code points"
+                         % (path, len(records) - 1, len(codepoints)))
+
+    left_map = _int_array(src, "kern_left_class_mapping")
+    right_map = _int_array(src, "kern_right_class_mapping")
+    font.kern_values = _int_array(src, "kern_class_values")
+    font.kern_left_cnt = _field(src, "left_class_cnt", 0)
+    font.kern_right_cnt = _field(src, "right_class_cnt", 0)
+
+    for gid, cp in enumerate(codepoints, start=1):
+        index, adv_w, box_w, box_h, ofs_x, ofs_y = records[gid]
+        size = (box_w * box_h * font.bpp + 7) // 8
+        font.glyphs.append(Glyph(
+            codepoint=cp, adv_w=adv_w, box_w=box_w, box_h=box_h, ofs_x=ofs_x, ofs_y=ofs_y,
+            bitmap=bitmap[index:index + size],
+            left_class=left_map[gid] if gid < len(left_map) else 0,
+            right_class=right_map[gid] if gid < len(right_map) else 0,
+        ))
+    return font
+
+
+# ============================================================================
+# SUBSETTING
+# ============================================================================
+
+def subset(font: Font, codepoints) -> Font:
+    """Return a copy of `font` holding only the requested code points."""
+    wanted = set(codepoints)
+    glyphs = [g for g in font.glyphs if g.codepoint in wanted]
+    glyphs.sort(key=lambda g: g.codepoint)
+
+    # Renumber the kerning classes still in use so the class table shrinks too
+    left_used = sorted({g.left_class for g in glyphs if g.left_class})
+    right_used = sorted({g.right_class for g in glyphs if g.right_class})
+    left_new = {c: i + 1 for i, c in enumerate(left_used)}
+    right_new = {c: i + 1 for i, c in enumerate(right_used)}
+
+    values = []
+    for lc in left_used:
+        for rc in right_used:
+            values.append(font.kern_values[(lc - 1) * font.kern_right_cnt + (rc - 1)])
+
+    out = Font(**{k: getattr(font, k) for k in (
+        "name", "size_px", "bpp", "line_height", "base_line",
+        "underline_position", "underline_thickness", "kern_scale")})
+    out.glyphs = [Glyph(**{**g.__dict__,
+                           "left_class": left_new.get(g.left_class, 0),
+                           "right_class": right_new.get(g.right_class, 0)}) for g in glyphs]
+    if any(values):
+        out.kern_left_cnt = len(left_used)
+        out.kern_right_cnt = len(right_used)
+        out.kern_values = values
+    else:
+        for g in out.glyphs:
+            g.left_class = g.right_class = 0
+    return out
+
+
+# ============================================================================
+# RLE COMPRESSION (LV_FONT_FMT_TXT_COMPRESSED)
+# ============================================================================
+
+class _BitWriter:
+    def __init__(self):
+        self.data = bytearray()
+        self.bits = 0
+
+    def write(self, value: int, length: int):
+        for i in range(length - 1, -1, -1):
+            if self.bits % 8 == 0:
+                self.data.append(0)
+            if (value >> i) & 1:
+                self.data[-1] |= 0x80 >> (self.bits % 8)
+            self.bits += 1
+
+
+def _unpack(bitmap: bytes, count: int, bpp: int) -> List[int]:
+    mask = (1 << bpp) - 1
+    return [(bitmap[(i * bpp) >> 3] >> (8 - bpp - ((i * bpp) & 7))) & mask for i in range(count)]
+
+
+def compress_glyph(g: Glyph, bpp: int) -> bytes:
+    """
+    Encode one glyph the way lv_font_fmt_txt.c's decompress() reads it:
+    rows XOR-prefiltered against the previous row, then the LVGL RLE scheme
+    (raw value, a run of 1-bits after a repeat, and a 6-bit counter after
+    the 11th repeat bit).
+    """
+    w, h = g.box_w, g.box_h
+    if w == 0 or h == 0:
+        return b""
+    px = _unpack(g.bitmap, w * h, bpp)
+    for y in range(h - 1, 0, -1):
+        for x in range(w):
+            px[y * w + x] ^= px[(y - 1) * w + x]
+
+    out = _BitWriter()
+    n = len(px)
+    i = 0
+    prev = None
+    repeating = False
+    cnt = 0
+    while i < n:
+        if not repeating:
+            out.write(px[i], bpp)
+            repeating = prev is not None and px[i] == prev
+            cnt = 0
+            prev = px[i]
+            i += 1
+        elif px[i] == prev:
+            out.write(1, 1)
+            cnt += 1
+            i += 1
+            if cnt == 11:
+                run = 0
+                while i + run < n and px[i + run] == prev:
+                    run += 1
+                c = min(run + 1, 63)
+                out.write(c, 6)
+                # Counter mode replays `prev` c - 1 times, then reads a raw value
+                i += c - 1
+                if i < n:
+                    out.write(px[i], bpp)
+                    prev = px[i]
+                    i += 1
+                repeating = False
+        else:
+            out.write(0, 1)
+            out.write(px[i], bpp)
+            prev = px[i]
+            i += 1
+            repeating = False
+    return bytes(out.data)
+
+
+def decompress_glyph(data: bytes, w: int, h: int, bpp: int) -> bytes:
+    """Reference decoder mirroring LVGL, used to self-check the encoder."""
+    pos = 0
+
+    def bits(length):
+        nonlocal pos
+        v = 0
+        for _ in range(length):
+            byte = data[pos >> 3] if (pos >> 3) < len(data) else 0
+            v = (v << 1) | ((byte >> (7 - (pos & 7))) & 1)
+            pos += 1
+        return v
+
+    state, prev, cnt = 0, 0, 0
+    px = []
+    for _ in range(w * h):
+        if state == 0:
+            ret = bits(bpp)
+            if pos != bpp and prev == ret:
+                cnt, state = 0, 1
+            prev = ret
+        elif state == 1:
+            cnt += 1
+            if bits(1):
+                ret = prev
+                if cnt == 11:
+                    cnt = bits(6)
+                    if cnt:
+                        state = 2
+                    else:
+                        ret = prev = bits(bpp)
+                        state = 0
+            else:
+                ret = prev = bits(bpp)
+                state = 0
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = prev = bits(bpp)
+                state = 0
+        px.append(ret)
+
+    for y in range(1, h):
+        for x in range(w):
+            px[y * w + x] ^= px[(y - 1) * w + x]
+    out = _BitWriter()
+    for v in px:
+        out.write(v, bpp)
+    return bytes(out.data)
+
+
+# ============================================================================
+# EMITTING
+# ============================================================================
+
+def _hex_rows(data: bytes, indent: str = "    ") -> str:
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append(indent + ", ".join("0x%x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def _int_rows(values: List[int], per_row: int = 8) -> str:
+    rows = []
+    for i in range(0, len(values), per_row):
+        rows.append("    " + ", ".join(str(v) for v in values[i:i + per_row]))
+    return ",\n".join(rows)
+
+
+def _cmaps(glyphs: List[Glyph]):
+    """Group sorted code points into FORMAT0 runs, with stragglers in one sparse map."""
+    runs = []
+    for gid, g in enumerate(glyphs, start=1):
+        if runs and g.codepoint == runs[-1][0] + runs[-1][1]:
+            runs[-1][1] += 1
+        else:
+            runs.append([g.codepoint, 1, gid])
+    dense = [r for r in runs if r[1] >= 3]
+    singles = [r for r in runs if r[1] < 3]
+    return dense, singles
+
+
+@dataclass
+class Layout:
+    """Where each glyph of a font goes in its emitted tables."""
+    order: List[int]           # glyph indexes in glyph id order (id = position + 1)
+    blobs: List[bytes]         # bitmap data per glyph index, compressed if asked
+    offsets: Dict[int, int]    # glyph index -> bitmap_index
+    dense: list                # FORMAT0 runs: [start, length, first glyph index + 1]
+    sparse_ids: List[int]      # glyph indexes in the sparse map
+    bitmap: bytes              # all glyph data back to back, padded for the RLE reader
+
+
+def layout(font: Font, compress: bool) -> Layout:
+    glyphs = font.glyphs
+    blobs = [compress_glyph(g, font.bpp) if compress else g.bitmap for g in glyphs]
+
+    # Lay the glyphs out in cmap order: dense runs first, then the sparse list
+    dense, singles = _cmaps(glyphs)
+    order = []
+    for start, length, gid in dense:
+        order.extend(range(gid - 1, gid - 1 + length))
+    sparse_ids = []
+    for start, length, gid in singles:
+        sparse_ids.extend(range(gid - 1, gid - 1 + length))
+    order.extend(sparse_ids)
+
+    offsets = {}
+    bitmap = bytearray()
+    for idx in order:
+        offsets[idx] = len(bitmap)
+        bitmap += blobs[idx] or b"\x00"
+    # The RLE reader may look one byte past the final glyph
+    bitmap.append(0)
+    return Layout(order, blobs, offsets, dense, sparse_ids, bytes(bitmap))
+
+
+def emit_c(font: Font, compress: bool, note: str) -> str:
+    glyphs = font.glyphs
+    lay = layout(font, compress)
+    blobs, order, offsets = lay.blobs, lay.order, lay.offsets
+    dense, sparse_ids = lay.dense, lay.sparse_ids
+
+    guard = font.name.upper()
+    lines = []
+    lines.append("/*******************************************************************************")
+    lines.append(" * Size: %d px" % font.size_px)
+    lines.append(" * Bpp: %d" % font.bpp)
+    lines.append(" * Opts: %s" % note)
+    lines.append(" * Generated by tools/fonts/subset_fonts.py - do not edit")
+    lines.append(" ******************************************************************************/")
+    lines.append("")
+    lines.append("#include <lvgl/lvgl.h>")
+    lines.append("")
+    lines.append("#ifndef %s" % guard)
+    lines.append("#define %s 1" % guard)
+    lines.append("#endif")
+    lines.append("")
+    lines.append("#if %s" % guard)
+    lines.append("")
+    lines.append("/*-----------------")
+    lines.append(" *    BITMAPS")
+    lines.append(" *----------------*/")
+    lines.append("")
+    lines.append("/*Store the image of the glyphs*/")
+    lines.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {")
+    for idx in order:
+        g = glyphs[idx]
+        ch = chr(g.codepoint) if 32 < g.codepoint < 127 else " "
+        lines.append("    /* U+%04X \"%s\" */" % (g.codepoint, ch if ch not in "\\\"" else " "))
+        lines.append(_hex_rows(blobs[idx] or b"\x00"))
+        lines.append("")
+    # The RLE reader may look one byte past the final glyph
+    lines.append("    0x0")
+    lines.append("};")
+    lines.append("")
+    lines.append("")
+    lines.append("/*---------------------")
+    lines.append(" *  GLYPH DESCRIPTION")
+    lines.append(" *--------------------*/")
+    lines.append("")
+    lines.append("static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {")
+    dsc_rows = ["    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */"]
+    for idx in order:
+        g = glyphs[idx]
+        dsc_rows.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}"
+                        % (offsets[idx], g.adv_w, g.box_w, g.box_h, g.ofs_x, g.ofs_y))
+    lines.append(",\n".join(dsc_rows))
+    lines.append("};")
+    lines.append("")
+    lines.append("/*---------------------")
+    lines.append(" *  CHARACTER MAPPING")
+    lines.append(" *--------------------*/")
+    lines.append("")
+
+    cmaps = []
+    next_gid = 1
+    for start, length, _ in dense:
+        cmaps.append("    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+                     "        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, "
+                     ".type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY\n    }" % (start, length, next_gid))
+        next_gid += length
+    if sparse_ids:
+        cps = [glyphs[i].codepoint for i in sparse_ids]
+        lines.append("static const uint16_t unicode_list_sparse[] = {")
+        lines.append(_int_rows(["0x%x" % (cp - cps[0]) for cp in cps]))
+        lines.append("};")
+        lines.append("")
+        cmaps.append("    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+                     "        .unicode_list = unicode_list_sparse, .glyph_id_ofs_list = NULL, .list_length = %d, "
+                     ".type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY\n    }"
+                     % (cps[0], cps[-1] - cps[0] + 1, next_gid, len(cps)))
+
+    lines.append("/*Collect the unicode lists and glyph_id offsets*/")
+    lines.append("static const lv_font_fmt_txt_cmap_t cmaps[] =")
+    lines.append("{")
+    lines.append(",\n".join(cmaps))
+    lines.append("};")
+    lines.append("")
+
+    has_kern = font.kern_left_cnt > 0 and font.kern_right_cnt > 0
+    if has_kern:
+        ordered = [glyphs[i] for i in order]
+        lines.append("/*-----------------")
+        lines.append(" *    KERNING")
+        lines.append(" *----------------*/")
+        lines.append("")
+        lines.append("/*Map glyph_ids to kern left classes*/")
+        lines.append("static const uint8_t kern_left_class_mapping[] =")
+        lines.append("{")
+        lines.append(_int_rows([0] + [g.left_class for g in ordered]))
+        lines.append("};")
+        lines.append("")
+        lines.append("/*Map glyph_ids to kern right classes*/")
+        lines.append("static const uint8_t kern_right_class_mapping[] =")
+        lines.append("{")
+        lines.append(_int_rows([0] + [g.right_class for g in ordered]))
+        lines.append("};")
+        lines.append("")
+        lines.append("/*Kern values between classes*/")
+        lines.append("static const int8_t kern_class_values[] =")
+        lines.append("{")
+        lines.append(_int_rows(font.kern_values))
+        lines.append("};")
+        lines.append("")
+        lines.append("/*Collect the kern class' data in one place*/")
+        lines.append("static const lv_font_fmt_txt_kern_classes_t kern_classes =")
+        lines.append("{")
+        lines.append("    .class_pair_values   = kern_class_values,")
+        lines.append("    .left_class_mapping  = kern_left_class_mapping,")
+        lines.append("    .right_class_mapping = kern_right_class_mapping,")
+        lines.append("    .left_class_cnt      = %d," % font.kern_left_cnt)
+        lines.append("    .right_class_cnt     = %d," % font.kern_right_cnt)
+        lines.append("};")
+        lines.append("")
+
+    lines.append("/*--------------------")
+    lines.append(" *  ALL CUSTOM DATA")
+    lines.append(" *--------------------*/")
+    lines.append("")
+    lines.append("#if LVGL_VERSION_MAJOR == 8")
+    lines.append("/*Store all the custom data of the font*/")
+    lines.append("static  lv_font_fmt_txt_glyph_cache_t cache;")
+    lines.append("#endif")
+    lines.append("")
+    lines.append("static const lv_font_fmt_txt_dsc_t font_dsc = {")
+    lines.append("    .glyph_bitmap = glyph_bitmap,")
+    lines.append("    .glyph_dsc = glyph_dsc,")
+    lines.append("    .cmaps = cmaps,")
+    lines.append("    .kern_dsc = %s," % ("&kern_classes" if has_kern else "NULL"))
+    lines.append("    .kern_scale = %d," % font.kern_scale)
+    lines.append("    .cmap_num = %d," % len(cmaps))
+    lines.append("    .bpp = %d," % font.bpp)
+    lines.append("    .kern_classes = %d," % (1 if has_kern else 0))
+    lines.append("    .bitmap_format = %d," % (1 if compress else 0))
+    lines.append("#if LVGL_VERSION_MAJOR == 8")
+    lines.append("    .cache = &cache")
+    lines.append("#endif")
+    lines.append("};")
+    lines.append("")
+    lines.append("/*-----------------")
+    lines.append(" *  PUBLIC FONT")
+    lines.append(" *----------------*/")
+    lines.append("")
+    lines.append("/*Initialize a public general font descriptor*/")
+    lines.append("const lv_font_t %s = {" % font.name)
+    lines.append("    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/")
+    lines.append("    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/")
+    lines.append("    .line_height = %d,          /*The maximum line height required by the font*/" % font.line_height)
+    lines.append("    .base_line = %d,             /*Baseline measured from the bottom of the line*/" % font.base_line)
+    lines.append("    .subpx = LV_FONT_SUBPX_NONE,")
+    lines.append("    .underline_position = %d," % font.underline_position)
+    lines.append("    .underline_thickness = %d," % font.underline_thickness)
+    lines.append("    .dsc = &font_dsc,          /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */")
+    lines.append("#if LV_VERSION_CHECK(8, 2, 0) || LVGL_VERSION_MAJOR >= 9")
+    lines.append("    .fallback = NULL,")
+    lines.append("#endif")
+    lines.append("    .user_data = NULL,")
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif /*#if %s*/" % guard)
+    lines.append("")
+    return "\n".join(lines)
+
+
+def footprint(font: Font, compress: bool) -> Dict[str, int]:
+    """Approximate flash bytes taken by the font's tables."""
+    bitmap = sum(len(compress_glyph(g, font.bpp)) if compress else len(g.bitmap) for g in font.glyphs)
+    dsc = 8 * (len(font.glyphs) + 1)
+    kern = 2 * (len(font.glyphs) + 1) + len(font.kern_values)
+    return {"bitmap": bitmap, "tables": dsc + kern, "total": bitmap + dsc + kern}
@@ -0,0 +1,61 @@
+"""
+PlatformIO pre-build hook that swaps the master fonts for generated subsets.
+
+Every src/fonts/*.c the UI references is replaced by the reduced copy that
+subset_fonts.py writes into $BUILD_DIR/fonts; fonts nobody references are
+dropped from the build. Set `custom_font_subset = no` in an environment to
+compile the masters unchanged. With `custom_font_assets = yes` the fonts go
+into the asset partition blob instead and none are compiled in. With
+`custom_sdf_numerals = yes` the numeral fonts are replaced by the distance
+field atlas sdf_atlas.py generates into $BUILD_DIR/sdf.
+"""
+
+import os
+import sys
+
+Import("env")  # noqa: F821
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools", "fonts"))  # noqa: F821
+import sdf_atlas  # noqa: E402
+import subset_fonts  # noqa: E402
+
+enabled = env.GetProjectOption("custom_font_subset", "yes").lower() not in ("0", "no", "false", "off")  # noqa: F821
+# Fonts packed into the asset partition (tools/assets) are not compiled in
+in_assets = env.GetProjectOption("custom_font_assets", "no").lower() in ("1", "yes", "true", "on")  # noqa: F821
+# Numeral fonts drawn from the SDF atlas (src/ui/SdfFont.h) are not compiled in
+sdf = env.GetProjectOption("custom_sdf_numerals", "no").lower() in ("1", "yes", "true", "on")  # noqa: F821
+replaced = sdf_atlas.REPLACES if sdf else ()
+
+if sdf:
+    if in_assets:
+        sys.stderr.write("fonts: custom_sdf_numerals and custom_font_assets both replace the numeral fonts\n")
+        env.Exit(1)  # noqa: F821
+    sdf_dir = os.path.join(env.subst("$BUILD_DIR"), "sdf")  # noqa: F821
+    sdf_atlas.print_report(sdf_atlas.generate(env.subst("$PROJECT_SRC_DIR"), os.path.join(sdf_dir, "SdfNumerals.c")))  # noqa: F821
+    env.BuildSources(os.path.join("$BUILD_DIR", "sdf_obj"), sdf_dir)  # noqa: F821
+
+if in_assets:
+    # The fonts the UI uses are all in the blob, the rest are unused
+    env.AddBuildMiddleware(lambda env, node: None, "*/fonts/*.c")  # noqa: F821
+elif enabled:
+    src_dir = env.subst("$PROJECT_SRC_DIR")  # noqa: F821
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "fonts")  # noqa: F821
+    jobs, unused = subset_fonts.plan(src_dir)
+    rows = subset_fonts.build(out_dir, jobs)
+    subset_fonts.print_report(rows, unused, os.path.join(src_dir, "fonts"))
+
+    def use_subset(env, node):
+        name = os.path.splitext(os.path.basename(node.get_path()))[0]
+        if name in unused or name in replaced:
+            return None
+        if name not in jobs:
+            return node
+        return env.Object(
+            os.path.join("$BUILD_DIR", "fonts", name + ".o"),
+            os.path.join(out_dir, name + ".c"))
+
+    env.AddBuildMiddleware(use_subset, "*/fonts/*.c")  # noqa: F821
+elif sdf:
+    env.AddBuildMiddleware(  # noqa: F821
+        lambda env, node: None if os.path.splitext(os.path.basename(node.get_path()))[0] in replaced else node,
+        "*/fonts/*.c")
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+Build the signed-distance-field atlas for the numeral fonts.
+
+One atlas replaces the RobotoBlack_200 and RobotoBlack_60 bitmap fonts: it
+holds the characters the pages draw with either of them (the union of
+their subset_fonts.py plans) as distance fields, and src/ui/SdfFont.cpp
+renders them at any pixel size.
+
+The fields come from the 200 px master: each glyph is thresholded at half
+coverage, its exact Euclidean distance transform is taken at full
+resolution, and the signed distance is averaged down by DOWNSCALE. Values
+are stored as 128 + distance * 127 / SPREAD, with distance in atlas pixels
+(positive inside), and every glyph cell has SPREAD pixels of margin.
+
+Usage:
+    python tools/fonts/sdf_atlas.py [--out FILE]
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import lvfont  # noqa: E402
+import subset_fonts  # noqa: E402
+
+SOURCE = "RobotoBlack_200"
+REPLACES = ("RobotoBlack_200", "RobotoBlack_60")
+DOWNSCALE = 4   # Master pixels per atlas pixel
+SPREAD = 4      # Distance range either side of the edge, atlas pixels
+ATLAS_WIDTH = 256
+INF = 1e20
+
+
+def _edt_1d(f):
+    """Squared distance transform of one row (Felzenszwalb & Huttenlocher)."""
+    n = len(f)
+    d = [0.0] * n
+    v = [0] * n
+    z = [0.0] * (n + 1)
+    k = 0
+    z[0], z[1] = -INF, INF
+    for q in range(1, n):
+        while True:
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k])
+            if s <= z[k]:
+                k -= 1
+            else:
+                break
+        k += 1
+        v[k] = q
+        z[k] = s
+        z[k + 1] = INF
+    k = 0
+    for q in range(n):
+        while z[k + 1] < q:
+            k += 1
+        d[q] = (q - v[k]) ** 2 + f[v[k]]
+    return d
+
+
+def _edt(mask, w, h):
+    """Distance from each pixel to the nearest pixel where mask is set."""
+    grid = [0.0 if m else INF for m in mask]
+    for x in range(w):
+        col = _edt_1d(grid[x::w])
+        for y in range(h):
+            grid[y * w + x] = col[y]
+    for y in range(h):
+        grid[y * w:(y + 1) * w] = _edt_1d(grid[y * w:(y + 1) * w])
+    return [g ** 0.5 for g in grid]
+
+
+def glyph_field(g, bpp):
+    """Atlas-resolution field of one glyph: (width, height, bytes)."""
+    margin = SPREAD * DOWNSCALE
+    # Round the padded box up to whole atlas pixels
+    w = -(-(g.box_w + 2 * margin) // DOWNSCALE) * DOWNSCALE
+    h = -(-(g.box_h + 2 * margin) // DOWNSCALE) * DOWNSCALE
+    half = 1 << (bpp - 1)
+    coverage = lvfont._unpack(g.bitmap, g.box_w * g.box_h, bpp)
+    inside = [False] * (w * h)
+    for y in range(g.box_h):
+        for x in range(g.box_w):
+            inside[(y + margin) * w + x + margin] = coverage[y * g.box_w + x] >= half
+
+    to_inside = _edt(inside, w, h)
+    to_outside = _edt([not i for i in inside], w, h)
+    signed = [(o - 0.5) if i else (0.5 - n) for i, o, n in zip(inside, to_outside, to_inside)]
+
+    aw, ah = w // DOWNSCALE, h // DOWNSCALE
+    out = bytearray(aw * ah)
+    area = DOWNSCALE * DOWNSCALE
+    for ay in range(ah):
+        for ax in range(aw):
+            total = 0.0
+            for dy in range(DOWNSCALE):
+                row = (ay * DOWNSCALE + dy) * w + ax * DOWNSCALE
+                total += sum(signed[row:row + DOWNSCALE])
+            d = total / area / DOWNSCALE
+            out[ay * aw + ax] = max(0, min(255, int(round(128 + d * 127 / SPREAD))))
+    return aw, ah, bytes(out)
+
+
+def build(font, chars):
+    """Pack the fields of `chars` into one atlas: (width, height, bitmap, records)."""
+    records = []
+    shelves = []  # [y, height, next x]
+    fields = []
+    for cp in sorted(set(ord(c) for c in chars)):
+        g = font.glyph(cp)
+        if g is None:
+            raise ValueError("%s has no U+%04X" % (font.name, cp))
+        if g.box_w == 0 or g.box_h == 0:
+            records.append((g, 0, 0, 0, 0))
+            continue
+        aw, ah, data = glyph_field(g, font.bpp)
+        fields.append((g, aw, ah, data))
+
+    # Tallest first onto shelves
+    height = 0
+    placed = []
+    for g, aw, ah, data in sorted(fields, key=lambda f: -f[2]):
+        shelf = next((s for s in shelves if s[2] + aw <= ATLAS_WIDTH and ah <= s[1]), None)
+        if shelf is None:
+            shelf = [height, ah, 0]
+            shelves.append(shelf)
+            height += ah
+        placed.append((g, shelf[2], shelf[0], aw, ah, data))
+        shelf[2] += aw
+
+    bitmap = bytearray(ATLAS_WIDTH * height)
+    for g, x, y, aw, ah, data in placed:
+        for row in range(ah):
+            bitmap[(y + row) * ATLAS_WIDTH + x:(y + row) * ATLAS_WIDTH + x + aw] = data[row * aw:(row + 1) * aw]
+        records.append((g, x, y, aw, ah))
+    records.sort(key=lambda r: r[0].codepoint)
+    return ATLAS_WIDTH, height, bytes(bitmap), records
+
+
+def emit_c(font, width, height, bitmap, records, note):
+    lines = [
+        "/*******************************************************************************",
+        " * SDF numerals atlas, generated by tools/fonts/sdf_atlas.py - do not edit",
+        " * Source: %s (%d px), %s" % (font.name, font.size_px, note),
+        " * %d x %d atlas, 1/%d scale, spread %d px" % (width, height, DOWNSCALE, SPREAD),
+        " ******************************************************************************/",
+        "",
+        '#include "ui/SdfAtlas.h"',
+        "",
+        "static const uint8_t atlas_bitmap[] = {",
+    ]
+    for i in range(0, len(bitmap), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in bitmap[i:i + 16]) + ",")
+    lines += ["};", "", "static const sdf_glyph_t atlas_glyphs[] = {"]
+    for g, x, y, aw, ah in records:
+        lines.append("    {0x%04x, %d, %d, %d, %d, %d, %d, %d, %d, %d}, /* '%s' */" % (
+            g.codepoint, g.adv_w, g.box_w, g.box_h, g.ofs_x, g.ofs_y, x, y, aw, ah, chr(g.codepoint)))
+    lines += [
+        "};",
+        "",
+        "const sdf_atlas_t sdf_numerals = {",
+        "    .source_px = %d," % font.size_px,
+        "    .line_height = %d," % font.line_height,
+        "    .base_line = %d," % font.base_line,
+        "    .downscale = %d," % DOWNSCALE,
+        "    .spread = %d," % SPREAD,
+        "    .width = %d," % width,
+        "    .height = %d," % height,
+        "    .glyph_count = %d," % len(records),
+        "    .glyphs = atlas_glyphs,",
+        "    .bitmap = atlas_bitmap,",
+        "};",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate(src_dir, out_path):
+    """Write the atlas C file (skipped when it is newer than its inputs) and return report rows."""
+    jobs, _ = subset_fonts.plan(src_dir)
+    chars = set(" ")
+    for name in REPLACES:
+        if name in jobs:
+            chars |= set(jobs[name]["chars"] or "".join(chr(c) for c in range(0x20, 0x7f)))
+    source = os.path.join(src_dir, "fonts", SOURCE + ".c")
+
+    font = lvfont.parse_font(source)
+    rows = []
+    for name in REPLACES:
+        if name in jobs:
+            job = jobs[name]
+            full = lvfont.parse_font(job["path"])
+            reduced = lvfont.subset(full, [ord(c) for c in job["chars"]]) if job["chars"] else full
+            compress = job["compress"] and job["chars"] is not None and full.bpp in (1, 2, 4)
+            rows.append((name, len(reduced.glyphs), lvfont.footprint(reduced, compress)["total"]))
+
+    inputs = [source, os.path.abspath(__file__), subset_fonts.CONFIG]
+    stamp = "chars " + "".join(sorted(chars))
+    fresh = (os.path.isfile(out_path) and os.path.getmtime(out_path) >= max(os.path.getmtime(p) for p in inputs)
+             and stamp in open(out_path, encoding="utf-8").read())
+    if not fresh:
+        width, height, bitmap, records = build(font, "".join(chars))
+        os.makedirs(os.path.dirname(os.path.abspath(out_path)), exist_ok=True)
+        with open(out_path, "w", encoding="utf-8") as f:
+            f.write(emit_c(font, width, height, bitmap, records, stamp))
+
+    with open(out_path, encoding="utf-8") as f:
+        text = f.read()
+    atlas_bytes = text.count("0x") - text.count("{0x")
+    glyph_count = text.count("{0x")
+    rows.append(("sdf_numerals", glyph_count, atlas_bytes + glyph_count * 20))
+    return rows
+
+
+def print_report(rows):
+    bitmap = sum(size for name, _, size in rows if name != "sdf_numerals")
+    for name, glyphs, size in rows:
+        print("sdf: %-16s %3d glyphs %8d bytes" % (name, glyphs, size))
+    sdf = rows[-1][2]
+    print("sdf: atlas %d bytes replaces %d bytes of bitmap fonts (%.1f%%)" % (
+        sdf, bitmap, 100.0 * sdf / bitmap if bitmap else 0))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--src", default=os.path.join(subset_fonts.ROOT, "src"), help="source tree to scan")
+    ap.add_argument("--out", default=os.path.join(subset_fonts.ROOT, ".pio", "sdf", "SdfNumerals.c"),
+                    help="output file")
+    args = ap.parse_args()
+
+    print_report(generate(args.src, args.out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
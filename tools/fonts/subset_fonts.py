@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+Generate per-use glyph subsets of the fonts in src/fonts.
+
+The master fonts carry the full ASCII range plus punctuation, but the pages
+only ever draw a handful of characters with each of them (the 200 px speed
+font shows digits and '-'). This tool scans the UI sources for the labels
+each font is attached to, works out the characters those labels can show
+from their literal texts and printf formats, and writes a reduced copy of
+each referenced font. Fonts no page references are reported as unused so
+the build can leave them out entirely.
+
+Usage:
+    python tools/fonts/subset_fonts.py [--out DIR] [--list]
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import lvfont  # noqa: E402
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+CONFIG = os.path.join(os.path.dirname(os.path.abspath(__file__)), "subsets.json")
+
+# Characters a printf conversion can produce, by conversion letter
+_FMT_CHARS = {
+    "d": "-0123456789", "i": "-0123456789", "u": "0123456789",
+    "f": "-.0123456789", "x": "0123456789abcdef", "X": "0123456789ABCDEF",
+}
+_FMT_RE = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?([diufxXsc%])")
+_STR = r'"((?:[^"\\]|\\.)*)"'
+
+
+def format_chars(fmt):
+    """Every character a printf-style format string can render."""
+    chars = set(_FMT_RE.sub("", fmt))
+    for conv in _FMT_RE.findall(fmt):
+        if conv == "%":
+            chars.add("%")
+        chars.update(_FMT_CHARS.get(conv, ""))
+    return chars
+
+
+def _balanced(text, start):
+    """Text from start up to the parenthesis closing the one just before it."""
+    depth = 1
+    i = start
+    while i < len(text) and depth:
+        if text[i] == '"':
+            # Skip string literals so parentheses inside them don't count
+            i += 1
+            while i < len(text) and text[i] != '"':
+                i += 2 if text[i] == "\\" else 1
+        elif text[i] == "(":
+            depth += 1
+        elif text[i] == ")":
+            depth -= 1
+        i += 1
+    return text[start:i]
+
+
+def master_fonts(font_dir):
+    return {os.path.splitext(f)[0]: os.path.join(font_dir, f)
+            for f in sorted(os.listdir(font_dir)) if f.endswith(".c")}
+
+
+def theme_fonts(src_dir):
+    """
+    {role: font} for the shared text styles: the Theme::Text enum in
+    Theme.h zipped with the TEXT_FONTS table in Theme.cpp.
+    """
+    try:
+        with open(os.path.join(src_dir, "ui", "Theme.h"), encoding="utf-8") as f:
+            header = f.read()
+        with open(os.path.join(src_dir, "ui", "Theme.cpp"), encoding="utf-8") as f:
+            body = f.read()
+    except OSError:
+        return {}
+    enum = re.search(r"enum class Text\b[^{]*\{(.*?)\}", header, re.S)
+    table = re.search(r"TEXT_FONTS\[[^\]]*\]\s*=\s*\{(.*?)\};", body, re.S)
+    if not enum or not table:
+        return {}
+    roles = [r for r in re.findall(r"^\s*(\w+)\s*,", enum.group(1), re.M) if r != "Count"]
+    return dict(zip(roles, re.findall(r"&\s*(\w+)", table.group(1))))
+
+
+def scan_sources(src_dir, fonts):
+    """
+    Return ({font: set(chars)}, {font: [files]}) for every font the UI
+    references. A font with an empty char set is referenced but none of its
+    labels could be resolved.
+    """
+    chars = {name: set() for name in fonts}
+    users = {name: [] for name in fonts}
+    theme = theme_fonts(src_dir)
+
+    for dirpath, _, files in os.walk(src_dir):
+        if os.path.abspath(dirpath).startswith(os.path.abspath(os.path.join(src_dir, "fonts"))):
+            continue
+        for fname in files:
+            if not fname.endswith((".cpp", ".h")):
+                continue
+            path = os.path.join(dirpath, fname)
+            with open(path, encoding="utf-8", errors="replace") as f:
+                text = f.read()
+
+            for name in fonts:
+                if re.search(r"&\s*" + name + r"\b", text):
+                    users[name].append(os.path.relpath(path, ROOT))
+
+            bindings = re.findall(r"lv_obj_set_style_text_font\(\s*(\w+)\s*,\s*&\s*(\w+)", text)
+            # Shared theme styles: Theme::apply(label, Theme::Text::Role, ...)
+            for var, role in re.findall(r"Theme::apply\(\s*(\w+)\s*,\s*Theme::Text::(\w+)", text):
+                font = theme.get(role)
+                if font in users:
+                    bindings.append((var, font))
+                    if os.path.relpath(path, ROOT) not in users[font]:
+                        users[font].append(os.path.relpath(path, ROOT))
+            for var, font in bindings:
+                if font not in fonts:
+                    continue
+                v = re.escape(var)
+                for lit in re.findall(r"lv_label_set_text(?:_fmt|_static)?\(\s*" + v + r"\s*,\s*" + _STR, text):
+                    chars[font] |= format_chars(lit)
+                # Text formatted into a buffer first, then handed to the label
+                for buf in re.findall(r"lv_label_set_text\(\s*" + v + r"\s*,\s*(\w+)\s*\)", text):
+                    for lit in re.findall(r"snprintf\(\s*" + re.escape(buf) + r"\s*,[^,]+,\s*" + _STR, text):
+                        chars[font] |= format_chars(lit)
+                # BoundLabel: formatter lambda passed to bind(label, ...)
+                for m in re.finditer(r"\w+\.bind\(\s*" + v + r"\s*,", text):
+                    body = _balanced(text, m.end())
+                    for lit in re.findall(r"\.(?:set|format)\(\s*" + _STR, body):
+                        chars[font] |= format_chars(lit)
+                # LabelBinding: attach(label, ...) then setText()/format() on the binding
+                for binding in re.findall(r"(\w+)\.attach\(\s*" + v + r"\s*[,)]", text):
+                    b = re.escape(binding)
+                    for lit in re.findall(b + r"\.(?:setText|format)\(\s*" + _STR, text):
+                        chars[font] |= format_chars(lit)
+
+    referenced = {name: users[name] for name in fonts if users[name]}
+    return chars, referenced
+
+
+def load_config():
+    with open(CONFIG, encoding="utf-8") as f:
+        return json.load(f)
+
+
+def plan(src_dir=None, font_dir=None):
+    """Work out what to build: {font: {"chars", "compress", "path"}} plus the unused list."""
+    src_dir = src_dir or os.path.join(ROOT, "src")
+    font_dir = font_dir or os.path.join(src_dir, "fonts")
+    config = load_config()
+    fonts = master_fonts(font_dir)
+    scanned, referenced = scan_sources(src_dir, fonts)
+
+    jobs = {}
+    for name, path in fonts.items():
+        if name not in referenced and name not in config.get("keep", []):
+            continue
+        opts = config.get("fonts", {}).get(name, {})
+        found = scanned[name]
+        if not found and not opts.get("chars"):
+            # Referenced but no label could be traced back; keep the whole font
+            jobs[name] = {"path": path, "chars": None, "compress": False, "users": referenced.get(name, [])}
+            continue
+        wanted = found | set(opts.get("chars", "")) | set(config.get("always", ""))
+        jobs[name] = {
+            "path": path,
+            "chars": "".join(sorted(wanted)),
+            "compress": opts.get("compress", config.get("compress", False)),
+            "users": referenced.get(name, []),
+        }
+    unused = sorted(set(fonts) - set(jobs))
+    return jobs, unused
+
+
+def build(out_dir, jobs, verify=True):
+    """Write the subset fonts and return one report row per font."""
+    os.makedirs(out_dir, exist_ok=True)
+    rows = []
+    for name, job in sorted(jobs.items()):
+        t0 = time.time()
+        full = lvfont.parse_font(job["path"])
+        before = lvfont.footprint(full, False)
+
+        if job["chars"] is None:
+            reduced, compress = full, False
+            note = "full master (no label texts found for this font)"
+        else:
+            reduced = lvfont.subset(full, [ord(c) for c in job["chars"]])
+            missing = set(job["chars"]) - {chr(g.codepoint) for g in reduced.glyphs}
+            if missing:
+                print("fonts: %s lacks %r, LVGL will draw placeholders" % (name, "".join(sorted(missing))))
+            compress = job["compress"] and full.bpp in (1, 2, 4)
+            note = "subset of %s.c, chars %s%s" % (
+                name, json.dumps(job["chars"]), ", RLE compressed" if compress else "")
+
+        if verify and compress:
+            for g in reduced.glyphs:
+                packed = lvfont.compress_glyph(g, reduced.bpp)
+                back = lvfont.decompress_glyph(packed, g.box_w, g.box_h, reduced.bpp)
+                n = g.box_w * g.box_h
+                if lvfont._unpack(back, n, reduced.bpp) != lvfont._unpack(g.bitmap, n, reduced.bpp):
+                    raise RuntimeError("%s: RLE round trip failed for U+%04X" % (name, g.codepoint))
+
+        text = lvfont.emit_c(reduced, compress, note)
+        target = os.path.join(out_dir, name + ".c")
+        # Leave unchanged outputs alone so the compiler can skip them
+        if not os.path.exists(target) or open(target, encoding="utf-8").read() != text:
+            with open(target, "w", encoding="utf-8") as f:
+                f.write(text)
+
+        after = lvfont.footprint(reduced, compress)
+        rows.append({
+            "font": name, "glyphs_before": len(full.glyphs), "glyphs_after": len(reduced.glyphs),
+            "flash_before": before["total"], "flash_after": after["total"],
+            "src_before": os.path.getsize(job["path"]), "src_after": len(text),
+            "compressed": compress, "seconds": time.time() - t0,
+        })
+    return rows
+
+
+def print_report(rows, unused, fonts_dir):
+    print("%-18s %13s %21s %21s %s" % ("font", "glyphs", "flash bytes", "source bytes", "rle"))
+    tb = ta = 0
+    for r in rows:
+        print("%-18s %5d -> %-5d %9d -> %-9d %9d -> %-9d %s" % (
+            r["font"], r["glyphs_before"], r["glyphs_after"], r["flash_before"], r["flash_after"],
+            r["src_before"], r["src_after"], "yes" if r["compressed"] else "no"))
+        tb += r["flash_before"]
+        ta += r["flash_after"]
+    for name in unused:
+        size = lvfont.footprint(lvfont.parse_font(os.path.join(fonts_dir, name + ".c")), False)["total"]
+        print("%-18s %13s %9d -> %-9d %21s" % (name, "unused", size, 0, "dropped"))
+        tb += size
+    print("total flash: %d -> %d bytes (%.1f%%), generated in %.2fs" % (
+        tb, ta, 100.0 * ta / tb if tb else 0, sum(r["seconds"] for r in rows)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--src", default=os.path.join(ROOT, "src"), help="source tree to scan")
+    ap.add_argument("--out", default=os.path.join(ROOT, ".pio", "fonts"), help="output directory")
+    ap.add_argument("--list", action="store_true", help="only print the glyph plan")
+    args = ap.parse_args()
+
+    jobs, unused = plan(args.src)
+    if args.list:
+        for name, job in sorted(jobs.items()):
+            print("%s: %s (%s)" % (name, json.dumps(job["chars"]) if job["chars"] else "<all>",
+                                    ", ".join(job["users"]) or "kept"))
+        for name in unused:
+            print("%s: unused" % name)
+        return 0
+
+    rows = build(args.out, jobs)
+    print_report(rows, unused, os.path.join(args.src, "fonts"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+Compare the PNGs of two headless renderer runs (native/main.cpp --out DIR).
+
+Meant for builds that change how pixels are produced rather than what is
+drawn, e.g. the RGB565 renderer against the RGB332 one:
+
+    pio run -e native && .pio/build/native/program --out .pio/render565
+    pio run -e native-rgb332 && .pio/build/native-rgb332/program --out .pio/render332
+    python tools/render/compare_images.py .pio/render565 .pio/render332
+
+For every image present in both directories it prints the share of pixels
+that differ, the mean and largest per-channel difference and the PSNR. Only
+reads the 8-bit RGB, unfiltered PNGs native/PngWriter.cpp writes.
+
+Usage:
+    python tools/render/compare_images.py BASELINE CURRENT [--min-psnr DB]
+"""
+
+import argparse
+import math
+import os
+import struct
+import sys
+import zlib
+
+
+def read_png(path):
+    """Return (width, height, rgb bytes) of a PngWriter image."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+
+    pos, idat, width, height = 8, b"", 0, 0
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b"IHDR":
+            width, height, depth, color = struct.unpack(">IIBB", body[:10])
+            if depth != 8 or color != 2:
+                raise ValueError("%s: only 8-bit RGB is supported" % path)
+        elif kind == b"IDAT":
+            idat += body
+        pos += 12 + length
+
+    raw = zlib.decompress(idat)
+    stride = width * 3
+    rows = []
+    for y in range(height):
+        start = y * (stride + 1)
+        if raw[start] != 0:
+            raise ValueError("%s: filtered scanlines are not supported" % path)
+        rows.append(raw[start + 1:start + 1 + stride])
+    return width, height, b"".join(rows)
+
+
+def compare(a, b):
+    """Return (differing pixels, total pixels, mean abs diff, max diff, psnr) for two RGB buffers."""
+    pixels = len(a) // 3
+    differing = 0
+    total = 0
+    squared = 0
+    largest = 0
+    for i in range(0, len(a), 3):
+        if a[i:i + 3] == b[i:i + 3]:
+            continue
+        differing += 1
+        for c in range(3):
+            d = abs(a[i + c] - b[i + c])
+            total += d
+            squared += d * d
+            largest = max(largest, d)
+    mse = squared / (pixels * 3)
+    psnr = float("inf") if mse == 0 else 10 * math.log10(255 * 255 / mse)
+    return differing, pixels, total / (pixels * 3), largest, psnr
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--min-psnr", type=float, default=None, help="fail if any image falls below this PSNR (dB)")
+    args = ap.parse_args()
+
+    names = sorted(n for n in os.listdir(args.baseline) if n.endswith(".png"))
+    print("%-34s %9s %9s %5s %8s" % ("image", "differ", "mean", "max", "PSNR dB"))
+    failures = 0
+    compared = 0
+    for name in names:
+        other = os.path.join(args.current, name)
+        if not os.path.isfile(other):
+            print("%-34s missing from %s" % (name, args.current))
+            continue
+        wa, ha, a = read_png(os.path.join(args.baseline, name))
+        wb, hb, b = read_png(other)
+        if (wa, ha) != (wb, hb):
+            print("%-34s size %dx%d vs %dx%d" % (name, wa, ha, wb, hb))
+            failures += 1
+            continue
+
+        differing, pixels, mean, largest, psnr = compare(a, b)
+        compared += 1
+        flag = ""
+        if args.min_psnr is not None and psnr < args.min_psnr:
+            flag = "  BELOW"
+            failures += 1
+        print("%-34s %8.2f%% %9.3f %5d %8.1f%s" % (name, 100.0 * differing / pixels, mean, largest, psnr, flag))
+
+    print("%d image(s) compared, %d failure(s)" % (compared, failures))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Compare two headless renderer reports (native/main.cpp, report.json).
+
+Pixel, area and object counts come from the simulated clock and are
+identical run to run, so any growth past the tolerance is a real change in
+how much the UI redraws. Render times depend on the workstation and are
+only checked when --time-tolerance is given.
+
+--pixels also requires every frame to flush exactly the same pixels, as
+a run with the draw unit (--draw-unit) must against one without.
+
+Usage:
+    python tools/render/compare_reports.py BASELINE CURRENT [--tolerance PCT] [--time-tolerance PCT] [--pixels]
+
+Exits 1 if any scenario got more expensive than allowed, or with --pixels
+if any frame differs.
+"""
+
+import argparse
+import json
+import sys
+
+# Summary fields that must not grow, and the ones that are timings
+COUNTS = ("frames", "px_total", "areas_total", "objects_total", "draws_total")
+TIMES = ("render_us_avg", "render_us_p95")
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        return {s["name"]: s["summary"] for s in json.load(f)["scenarios"]}
+
+
+def load_frames(path):
+    with open(path, encoding="utf-8") as f:
+        return {s["name"]: s["frames"] for s in json.load(f)["scenarios"]}
+
+
+def compare_pixels(baseline, current):
+    mismatches = []
+    for name in sorted(set(baseline) & set(current)):
+        before, after = baseline[name], current[name]
+        for i, (a, b) in enumerate(zip(before, after)):
+            if a["t"] != b["t"] or a["checksum"] != b["checksum"]:
+                print("%-12s frame %d (t=%d ms, %s) flushed different pixels" % (name, i, b["t"], b["step"]))
+                mismatches.append(name)
+                break
+        else:
+            if len(before) != len(after):
+                print("%-12s %d frames against %d" % (name, len(after), len(before)))
+                mismatches.append(name)
+    return mismatches
+
+
+def growth(before, after):
+    if before == 0:
+        return 0.0 if after == 0 else float("inf")
+    return 100.0 * (after - before) / before
+
+
+def compare(baseline, current, tolerance, time_tolerance):
+    regressions = []
+    print("%-12s %-14s %12s %12s %8s" % ("scenario", "field", "baseline", "current", "change"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print("%-12s missing from the current report" % name)
+            continue
+        if name not in baseline:
+            print("%-12s new, no baseline" % name)
+            continue
+
+        fields = [(f, tolerance) for f in COUNTS]
+        if time_tolerance is not None:
+            fields += [(f, time_tolerance) for f in TIMES]
+        for field, limit in fields:
+            before, after = baseline[name][field], current[name][field]
+            change = growth(before, after)
+            flag = ""
+            if change > limit:
+                flag = "  REGRESSION"
+                regressions.append((name, field))
+            if before != after or flag:
+                print("%-12s %-14s %12d %12d %+7.1f%%%s" % (name, field, before, after, change, flag))
+    return regressions
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--tolerance", type=float, default=10.0, help="allowed growth of redraw counts, percent")
+    ap.add_argument("--time-tolerance", type=float, default=None, help="also check render times, percent")
+    ap.add_argument("--pixels", action="store_true", help="also require every frame to flush the same pixels")
+    args = ap.parse_args()
+
+    regressions = compare(load(args.baseline), load(args.current), args.tolerance, args.time_tolerance)
+    mismatches = compare_pixels(load_frames(args.baseline), load_frames(args.current)) if args.pixels else []
+    if regressions:
+        print("%d regression(s)" % len(regressions))
+    if mismatches:
+        print("%d scenario(s) with different pixels" % len(mismatches))
+    if regressions or mismatches:
+        return 1
+    print("no regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())